@@ -24,6 +24,8 @@
 
 #include "AppDelegate.h"
 #include "scenes/GameScene.h"
+#include "scenes/StressBenchScene.h"
+#include "utils/TraceProfiler.h"
 
 // #define USE_AUDIO_ENGINE 1
 // #define USE_SIMPLE_AUDIO_ENGINE 1
@@ -119,8 +121,28 @@ bool AppDelegate::applicationDidFinishLaunching() {
 
     register_all_packages();
 
+#if PLAYINGCARDS_ENABLE_TRACE
+    // 记录每帧的逻辑更新和整帧（更新+绘制）耗时，切后台时写出trace文件
+    TraceProfiler::start();
+    auto frameBegin = std::make_shared<int64_t>(0);
+    auto dispatcher = director->getEventDispatcher();
+    dispatcher->addCustomEventListener(Director::EVENT_BEFORE_UPDATE, [frameBegin](EventCustom*) {
+        *frameBegin = TraceProfiler::nowNanos();
+    });
+    dispatcher->addCustomEventListener(Director::EVENT_AFTER_UPDATE, [frameBegin](EventCustom*) {
+        TraceProfiler::recordComplete("Update", "loop", *frameBegin, TraceProfiler::nowNanos());
+    });
+    dispatcher->addCustomEventListener(Director::EVENT_AFTER_DRAW, [frameBegin](EventCustom*) {
+        TraceProfiler::recordComplete("Frame", "loop", *frameBegin, TraceProfiler::nowNanos());
+    });
+#endif
+
     // create a scene. it's an autorelease object
-    auto scene = GameScene::createScene();
+#if PLAYINGCARDS_STRESS_BENCH
+    auto scene = StressBenchScene::createScene();
+#else
+    auto scene = GameScene::createScene(&_levelCache, &_levelArenaPool);
+#endif
 
     // run
     director->runWithScene(scene);
@@ -132,6 +154,17 @@ bool AppDelegate::applicationDidFinishLaunching() {
 void AppDelegate::applicationDidEnterBackground() {
     Director::getInstance()->stopAnimation();
 
+    // 切后台时保存对局快照（二进制格式，在系统挂起窗口内完成）
+    auto gameScene = dynamic_cast<GameScene*>(Director::getInstance()->getRunningScene());
+    if (gameScene)
+    {
+        gameScene->saveGameSnapshot();
+    }
+
+#if PLAYINGCARDS_ENABLE_TRACE
+    TraceProfiler::saveToFile(FileUtils::getInstance()->getWritablePath() + "trace.json");
+#endif
+
 #if USE_AUDIO_ENGINE
     AudioEngine::pauseAll();
 #elif USE_SIMPLE_AUDIO_ENGINE
@@ -26,6 +26,8 @@
 #define  _APP_DELEGATE_H_
 
 #include "cocos2d.h"
+#include "managers/LevelConfigCache.h"
+#include "utils/LevelArena.h"
 
 /**
 @brief    The cocos2d Application.
@@ -58,6 +60,10 @@ public:
     @param  the pointer of the application
     */
     virtual void applicationWillEnterForeground();
+
+private:
+    LevelConfigCache _levelCache;   // 关卡缓存，所有场景共享
+    LevelArenaPool _levelArenaPool; // 关卡内存池，所有场景共享
 };
 
 #endif // _APP_DELEGATE_H_
@@ -62,6 +62,19 @@ enum class CardOperationType
     RESERVE_TO_STACK        ///< 从备用牌堆移动到手牌区（翻牌）
 };
 
+/**
+ * @brief 玩家操作类型枚举
+ * 
+ * 用于录像回放等需要记录玩家输入的场景
+ */
+enum class GameActionType
+{
+    NONE = 0,               ///< 无操作
+    PLAYFIELD_TO_STACK,     ///< 点击主牌区卡牌（匹配消除）
+    RESERVE_TO_STACK,       ///< 点击备用牌堆（翻牌）
+    UNDO                    ///< 回退
+};
+
 /**
  * @brief 卡牌区域类型枚举
  */
@@ -94,6 +107,11 @@ namespace GameConstants
     
     // 动画时长
     constexpr float kCardMoveTime = 0.3f;
+    constexpr float kWinCelebrationTime = 1.5f;     // 胜利展示时长，下一关的场景在此期间分帧构建
+    constexpr float kLevelTransitionTime = 0.4f;    // 切换到下一关的淡入淡出时长
+    
+    // 分帧构建视图时每帧最多占用的时间（秒），60帧下约为帧时长的四分之一
+    constexpr float kViewBuildFrameBudget = 0.004f;
     
     // 资源路径前缀
     const std::string kResPath = "res/res/";
@@ -4,9 +4,12 @@
  */
 
 #include "configs/LevelConfig.h"
+#include "utils/BinaryStream.h"
+#include <algorithm>
 
 LevelConfig::LevelConfig()
     : _levelId(0)
+    , _dealSeed(0)
 {
 }
 
@@ -14,8 +17,15 @@ LevelConfig::~LevelConfig()
 {
 }
 
+void LevelConfig::setCompiledPlayfield(std::shared_ptr<const CompiledPlayfield> compiledPlayfield)
+{
+    _compiledPlayfield = std::move(compiledPlayfield);
+}
+
 void LevelConfig::addPlayfieldCard(const CardConfigData& cardConfig)
 {
+    // 预编译数据与主牌区一一对应，布局变化后失效
+    _compiledPlayfield.reset();
     _playfieldCards.push_back(cardConfig);
 }
 
@@ -27,8 +37,10 @@ void LevelConfig::addStackCard(const CardConfigData& cardConfig)
 void LevelConfig::clear()
 {
     _levelId = 0;
+    _dealSeed = 0;
     _playfieldCards.clear();
     _stackCards.clear();
+    _compiledPlayfield.reset();
 }
 
 bool LevelConfig::isValid() const
@@ -61,5 +73,81 @@ bool LevelConfig::isValid() const
         }
     }
     
+    if (_compiledPlayfield && !isCompiledPlayfieldValid())
+    {
+        return false;
+    }
+    
     return true;
 }
+
+bool LevelConfig::isCompiledPlayfieldValid() const
+{
+    const CompiledPlayfield& compiled = *_compiledPlayfield;
+    int cardCount = static_cast<int>(_playfieldCards.size());
+    if (static_cast<int>(compiled.size()) != cardCount)
+    {
+        return false;
+    }
+    
+    auto contains = [](const std::vector<int>& indices, int value) {
+        return std::find(indices.begin(), indices.end(), value) != indices.end();
+    };
+    
+    for (int i = 0; i < cardCount; i++)
+    {
+        const CompiledCardData& card = compiled[i];
+        if (card.isClickable != card.blockers.empty())
+        {
+            return false;
+        }
+        
+        // 遮挡关系必须双向记录，运行时依赖covers做增量更新
+        for (int blocker : card.blockers)
+        {
+            if (blocker < 0 || blocker >= cardCount || blocker == i || !contains(compiled[blocker].covers, i))
+            {
+                return false;
+            }
+        }
+        for (int covered : card.covers)
+        {
+            if (covered < 0 || covered >= cardCount || covered == i || !contains(compiled[covered].blockers, i))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+uint32_t LevelConfig::computeContentHash() const
+{
+    // 按固定布局写出每张卡牌后整体计算哈希，保证与平台字节序无关
+    std::vector<uint8_t> buffer;
+    BinaryWriter writer(buffer);
+    
+    writer.writeU32(static_cast<uint32_t>(_playfieldCards.size()));
+    writer.writeU32(static_cast<uint32_t>(_stackCards.size()));
+    for (const auto& card : _playfieldCards)
+    {
+        writer.writeI32(static_cast<int32_t>(card.face));
+        writer.writeI32(static_cast<int32_t>(card.suit));
+        writer.writeF32(card.position.x);
+        writer.writeF32(card.position.y);
+    }
+    for (const auto& card : _stackCards)
+    {
+        writer.writeI32(static_cast<int32_t>(card.face));
+        writer.writeI32(static_cast<int32_t>(card.suit));
+    }
+    
+    // 按配置顺序发牌的关卡不写入，保持已有录像的哈希不变
+    if (_dealSeed != 0)
+    {
+        writer.writeU32(_dealSeed);
+        writer.writeI32(static_cast<int32_t>(_levelId));
+    }
+    
+    return BinaryUtils::fnv1a(buffer.data(), buffer.size());
+}
@@ -10,6 +10,8 @@
 #define __LEVEL_CONFIG_H__
 
 #include <vector>
+#include <memory>
+#include <cstdint>
 #include "configs/CardTypes.h"
 #include "cocos2d.h"
 
@@ -39,12 +41,36 @@ struct CardConfigData
     }
 };
 
+/**
+ * @brief 主牌区单张卡牌的预编译数据
+ * 
+ * 由关卡编译器根据卡牌位置离线算出，运行时直接使用，不再做几何计算。
+ * 下标均指主牌区配置列表中的下标。
+ */
+struct CompiledCardData
+{
+    int zOrder;                 ///< 绘制顺序，越大越靠上
+    bool isClickable;           ///< 初始是否可点击（即blockers为空）
+    std::vector<int> blockers;  ///< 遮挡本牌的卡牌下标
+    std::vector<int> covers;    ///< 被本牌遮挡的卡牌下标
+    
+    CompiledCardData()
+        : zOrder(0)
+        , isClickable(false)
+    {
+    }
+};
+
+/// 整个主牌区的预编译数据，与主牌区配置一一对应
+typedef std::vector<CompiledCardData> CompiledPlayfield;
+
 /**
  * @brief 关卡配置类
  * 
  * 存储一个关卡的完整配置数据，包括：
  * - 主牌区（Playfield）的卡牌配置
  * - 备用牌堆（Stack）的卡牌配置
+ * - 发牌种子（可选，非0时开局按种子洗乱备用牌堆）
  */
 class LevelConfig
 {
@@ -91,16 +117,53 @@ public:
      */
     size_t getStackCardCount() const { return _stackCards.size(); }
     
+    /**
+     * @brief 获取发牌种子
+     * @return 种子，0表示按配置顺序发牌
+     */
+    uint32_t getDealSeed() const { return _dealSeed; }
+    
+    /**
+     * @brief 是否带有预编译数据
+     * @return 已编译返回true
+     */
+    bool isCompiled() const { return _compiledPlayfield != nullptr; }
+    
+    /**
+     * @brief 获取主牌区预编译数据
+     * @return 预编译数据，未编译时为空指针
+     * 
+     * 以共享指针返回，生成的GameModel直接共享同一份数据
+     */
+    const std::shared_ptr<const CompiledPlayfield>& getCompiledPlayfield() const { return _compiledPlayfield; }
+    
     // ========== Setter方法 ==========
     
     /**
      * @brief 设置关卡ID
      * @param levelId 关卡唯一标识
+     * 
+     * 关卡文件写有LevelId时由加载器设置，调用方只在其为0时补填。
      */
     void setLevelId(int levelId) { _levelId = levelId; }
     
     /**
-     * @brief 添加主牌区卡牌配置
+     * @brief 设置发牌种子
+     * @param dealSeed 种子，0表示按配置顺序发牌
+     * 
+     * 发牌顺序由种子和关卡ID共同决定，在任何平台和线程中都相同。
+     * 带种子的关卡文件须同时写有LevelId，加载得到的ID即发牌所用的ID。
+     */
+    void setDealSeed(uint32_t dealSeed) { _dealSeed = dealSeed; }
+    
+    /**
+     * @brief 设置主牌区预编译数据
+     * @param compiledPlayfield 预编译数据，传空指针表示清除
+     */
+    void setCompiledPlayfield(std::shared_ptr<const CompiledPlayfield> compiledPlayfield);
+    
+    /**
+     * @brief 添加主牌区卡牌配置（会清除已有的预编译数据）
      * @param cardConfig 卡牌配置数据
      */
     void addPlayfieldCard(const CardConfigData& cardConfig);
@@ -121,13 +184,33 @@ public:
     /**
      * @brief 验证配置是否有效
      * @return 配置有效返回true
+     * 
+     * 带预编译数据时同时检查其数量、下标范围和遮挡关系的对称性
      */
     bool isValid() const;
+    
+    /**
+     * @brief 计算关卡内容哈希
+     * @return 32位FNV-1a哈希值
+     * 
+     * 覆盖所有卡牌的点数、花色和位置，不含预编译数据。
+     * 有发牌种子时还覆盖种子和关卡ID（二者决定发牌顺序），否则不含关卡ID。
+     * 用于录像回放时确认使用的是同一份关卡数据。
+     */
+    uint32_t computeContentHash() const;
+
+private:
+    /**
+     * @brief 检查预编译数据与主牌区是否一致
+     */
+    bool isCompiledPlayfieldValid() const;
 
 private:
     int _levelId;                               ///< 关卡ID
     std::vector<CardConfigData> _playfieldCards; ///< 主牌区卡牌配置
     std::vector<CardConfigData> _stackCards;     ///< 备用牌堆卡牌配置
+    uint32_t _dealSeed;                         ///< 发牌种子，0表示按配置顺序
+    std::shared_ptr<const CompiledPlayfield> _compiledPlayfield; ///< 主牌区预编译数据
 };
 
 #endif // __LEVEL_CONFIG_H__
@@ -4,13 +4,64 @@
  */
 
 #include "configs/LevelConfigLoader.h"
+#include "utils/TraceProfiler.h"
 #include "cocos2d.h"
 #include "json/document.h"
+#include "json/stringbuffer.h"
+#include "json/prettywriter.h"
+#include <cmath>
 
 USING_NS_CC;
 
+namespace
+{
+    bool parseIndexArray(const rapidjson::Value& json, const char* name, std::vector<int>& outIndices)
+    {
+        if (!json.HasMember(name) || !json[name].IsArray())
+        {
+            return false;
+        }
+        const auto& indexArray = json[name];
+        outIndices.reserve(indexArray.Size());
+        for (rapidjson::SizeType i = 0; i < indexArray.Size(); i++)
+        {
+            if (!indexArray[i].IsInt())
+            {
+                return false;
+            }
+            outIndices.push_back(indexArray[i].GetInt());
+        }
+        return true;
+    }
+    
+    /**
+     * @brief 解析关卡编译器写出的Compiled段
+     */
+    bool parseCompiledPlayfield(const rapidjson::Value& compiledArray, CompiledPlayfield& outCompiled)
+    {
+        outCompiled.resize(compiledArray.Size());
+        for (rapidjson::SizeType i = 0; i < compiledArray.Size(); i++)
+        {
+            const auto& cardObj = compiledArray[i];
+            CompiledCardData& card = outCompiled[i];
+            if (!cardObj.IsObject() ||
+                !cardObj.HasMember("Z") || !cardObj["Z"].IsInt() ||
+                !cardObj.HasMember("Clickable") || !cardObj["Clickable"].IsBool() ||
+                !parseIndexArray(cardObj, "Blockers", card.blockers) ||
+                !parseIndexArray(cardObj, "Covers", card.covers))
+            {
+                return false;
+            }
+            card.zOrder = cardObj["Z"].GetInt();
+            card.isClickable = cardObj["Clickable"].GetBool();
+        }
+        return true;
+    }
+}
+
 bool LevelConfigLoader::loadFromFile(const std::string& filePath, LevelConfig& outConfig)
 {
+    TRACE_SCOPE("config", "LevelConfigLoader::loadFromFile");
     // 读取文件内容
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(filePath);
     if (fullPath.empty())
@@ -31,6 +82,7 @@ bool LevelConfigLoader::loadFromFile(const std::string& filePath, LevelConfig& o
 
 bool LevelConfigLoader::loadFromString(const std::string& jsonString, LevelConfig& outConfig)
 {
+    TRACE_SCOPE("config", "LevelConfigLoader::loadFromString");
     rapidjson::Document doc;
     doc.Parse(jsonString.c_str());
     
@@ -115,6 +167,46 @@ bool LevelConfigLoader::loadFromString(const std::string& jsonString, LevelConfi
         }
     }
     
+    // 解析发牌种子 (DealSeed，可选，缺省按Stack的顺序发牌)
+    if (doc.HasMember("DealSeed"))
+    {
+        if (!doc["DealSeed"].IsUint())
+        {
+            CCLOG("LevelConfigLoader: Malformed deal seed");
+            return false;
+        }
+        outConfig.setDealSeed(doc["DealSeed"].GetUint());
+    }
+    
+    // 解析关卡ID (LevelId)：发牌顺序由种子和关卡ID共同决定，带发牌种子的关卡必须在文件中写明，
+    // 不依赖调用方按文件名或缓存键补填
+    if (doc.HasMember("LevelId"))
+    {
+        if (!doc["LevelId"].IsInt() || doc["LevelId"].GetInt() < 0)
+        {
+            CCLOG("LevelConfigLoader: Malformed level id");
+            return false;
+        }
+        outConfig.setLevelId(doc["LevelId"].GetInt());
+    }
+    else if (outConfig.getDealSeed() != 0)
+    {
+        CCLOG("LevelConfigLoader: Deal seed without level id");
+        return false;
+    }
+    
+    // 解析预编译数据 (Compiled，可选，由关卡编译器生成)
+    if (doc.HasMember("Compiled") && doc["Compiled"].IsArray())
+    {
+        auto compiled = std::make_shared<CompiledPlayfield>();
+        if (!parseCompiledPlayfield(doc["Compiled"], *compiled))
+        {
+            CCLOG("LevelConfigLoader: Malformed compiled data");
+            return false;
+        }
+        outConfig.setCompiledPlayfield(compiled);
+    }
+    
     // 验证配置
     if (!outConfig.isValid())
     {
@@ -128,6 +220,131 @@ bool LevelConfigLoader::loadFromString(const std::string& jsonString, LevelConfi
     return true;
 }
 
+namespace
+{
+    /**
+     * @brief 坐标为整数时按整数写出，与手工编辑的关卡文件保持一致
+     */
+    rapidjson::Value makeCoordinate(float value)
+    {
+        float rounded = std::round(value);
+        if (rounded == value)
+        {
+            return rapidjson::Value(static_cast<int>(rounded));
+        }
+        return rapidjson::Value(static_cast<double>(value));
+    }
+    
+    rapidjson::Value serializeCard(const CardConfigData& cardConfig, bool withPosition,
+                                   rapidjson::Document::AllocatorType& allocator)
+    {
+        rapidjson::Value cardObj(rapidjson::kObjectType);
+        cardObj.AddMember("CardFace", static_cast<int>(cardConfig.face), allocator);
+        cardObj.AddMember("CardSuit", static_cast<int>(cardConfig.suit), allocator);
+        if (withPosition)
+        {
+            rapidjson::Value posObj(rapidjson::kObjectType);
+            posObj.AddMember("x", makeCoordinate(cardConfig.position.x), allocator);
+            posObj.AddMember("y", makeCoordinate(cardConfig.position.y), allocator);
+            cardObj.AddMember("Position", posObj, allocator);
+        }
+        return cardObj;
+    }
+    
+    rapidjson::Value serializeIndexArray(const std::vector<int>& indices,
+                                         rapidjson::Document::AllocatorType& allocator)
+    {
+        rapidjson::Value indexArray(rapidjson::kArrayType);
+        for (int index : indices)
+        {
+            indexArray.PushBack(index, allocator);
+        }
+        return indexArray;
+    }
+    
+    rapidjson::Value serializeCompiledCard(const CompiledCardData& card,
+                                           rapidjson::Document::AllocatorType& allocator)
+    {
+        rapidjson::Value cardObj(rapidjson::kObjectType);
+        cardObj.AddMember("Z", card.zOrder, allocator);
+        cardObj.AddMember("Clickable", card.isClickable, allocator);
+        cardObj.AddMember("Blockers", serializeIndexArray(card.blockers, allocator), allocator);
+        cardObj.AddMember("Covers", serializeIndexArray(card.covers, allocator), allocator);
+        return cardObj;
+    }
+}
+
+bool LevelConfigLoader::saveToString(const LevelConfig& config, std::string& outJsonString)
+{
+    if (!config.isValid())
+    {
+        CCLOG("LevelConfigLoader: Refusing to save invalid level config");
+        return false;
+    }
+    
+    rapidjson::Document doc;
+    doc.SetObject();
+    auto& allocator = doc.GetAllocator();
+    
+    rapidjson::Value playfieldArray(rapidjson::kArrayType);
+    for (const auto& cardConfig : config.getPlayfieldCards())
+    {
+        playfieldArray.PushBack(serializeCard(cardConfig, true, allocator), allocator);
+    }
+    doc.AddMember("Playfield", playfieldArray, allocator);
+    
+    rapidjson::Value stackArray(rapidjson::kArrayType);
+    for (const auto& cardConfig : config.getStackCards())
+    {
+        stackArray.PushBack(serializeCard(cardConfig, false, allocator), allocator);
+    }
+    doc.AddMember("Stack", stackArray, allocator);
+    
+    if (config.getDealSeed() != 0)
+    {
+        doc.AddMember("DealSeed", config.getDealSeed(), allocator);
+    }
+    
+    // 带发牌种子时ID为0也写出，加载时以此为准
+    if (config.getDealSeed() != 0 || config.getLevelId() > 0)
+    {
+        doc.AddMember("LevelId", config.getLevelId(), allocator);
+    }
+    
+    if (config.isCompiled())
+    {
+        rapidjson::Value compiledArray(rapidjson::kArrayType);
+        for (const auto& card : *config.getCompiledPlayfield())
+        {
+            compiledArray.PushBack(serializeCompiledCard(card, allocator), allocator);
+        }
+        doc.AddMember("Compiled", compiledArray, allocator);
+    }
+    
+    rapidjson::StringBuffer buffer;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+    writer.SetIndent(' ', 4);
+    doc.Accept(writer);
+    outJsonString.assign(buffer.GetString(), buffer.GetSize());
+    return true;
+}
+
+bool LevelConfigLoader::saveToFile(const std::string& filePath, const LevelConfig& config)
+{
+    std::string jsonString;
+    if (!saveToString(config, jsonString))
+    {
+        return false;
+    }
+    
+    if (!FileUtils::getInstance()->writeStringToFile(jsonString, filePath))
+    {
+        CCLOG("LevelConfigLoader: Failed to write %s", filePath.c_str());
+        return false;
+    }
+    return true;
+}
+
 std::string LevelConfigLoader::getLevelConfigPath(int levelId)
 {
     char path[256];
@@ -2,7 +2,7 @@
  * @file LevelConfigLoader.h
  * @brief 关卡配置加载器
  * 
- * 负责从JSON文件加载关卡配置数据。
+ * 负责从JSON文件加载关卡配置数据，以及将关卡配置写回相同格式的JSON。
  * 提供静态方法，不持有状态。
  */
 
@@ -38,6 +38,22 @@ public:
      */
     static bool loadFromString(const std::string& jsonString, LevelConfig& outConfig);
     
+    /**
+     * @brief 将关卡配置写为JSON字符串（与关卡文件格式相同）
+     * @param config 关卡配置
+     * @param outJsonString 输出的JSON字符串
+     * @return 配置有效并写出返回true
+     */
+    static bool saveToString(const LevelConfig& config, std::string& outJsonString);
+    
+    /**
+     * @brief 将关卡配置保存为JSON文件
+     * @param filePath 文件完整路径
+     * @param config 关卡配置
+     * @return 保存成功返回true
+     */
+    static bool saveToFile(const std::string& filePath, const LevelConfig& config);
+    
     /**
      * @brief 获取关卡配置文件的默认路径
      * @param levelId 关卡ID
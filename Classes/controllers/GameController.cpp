@@ -5,22 +5,33 @@
 
 #include "controllers/GameController.h"
 #include "services/GameModelGenerator.h"
+#include "services/GameSnapshotService.h"
+#include "services/GameRules.h"
+#include "services/ReplayService.h"
 #include "configs/CardTypes.h"
+#include "utils/TraceProfiler.h"
+#include "utils/AllocationCounter.h"
+#include "utils/FixedBlockPool.h"
 #include "cocos2d.h"
 
 USING_NS_CC;
 
 GameController::GameController()
-    : _gameView(nullptr)
+    : _levelArenaPool(nullptr)
+    , _levelArena(nullptr)
+    , _hasInitialModel(false)
+    , _gameView(nullptr)
     , _isAnimating(false)
 {
 }
 
 GameController::~GameController()
 {
+    // 视图由场景持有，比控制器活得久，先让它释放内存池中的索引，再归还内存池
+    releaseLevelArena();
 }
 
-bool GameController::init(GameView* gameView)
+bool GameController::init(GameView* gameView, LevelArenaPool* levelArenaPool)
 {
     if (!gameView)
     {
@@ -29,6 +40,7 @@ bool GameController::init(GameView* gameView)
     }
     
     _gameView = gameView;
+    _levelArenaPool = levelArenaPool;
     
     // 初始化撤销管理器
     _undoManager.init(&_gameModel);
@@ -36,6 +48,9 @@ bool GameController::init(GameView* gameView)
         this->onUndoExecuted(undoModel);
     });
     
+    // 提示在后台线程读取发布的局面
+    _hintManager.init(&_statePublisher);
+    
     // 设置视图回调
     setupViewCallbacks();
     
@@ -72,10 +87,26 @@ void GameController::setupViewCallbacks()
     _gameView->setUndoClickCallback([this]() {
         this->handleUndoClick();
     });
+    
+    // 提示按钮回调
+    _gameView->setHintClickCallback([this]() {
+        this->handleHintClick();
+    });
+    
+    // 重玩按钮回调
+    _gameView->setRestartClickCallback([this]() {
+        this->handleRestartClick();
+    });
 }
 
 bool GameController::startGame()
 {
+    TRACE_SCOPE("controller", "GameController::startGame");
+    cancelHint();
+    
+    // 测试数据没有关卡配置，无法预估容量，使用全局堆
+    releaseLevelArena();
+    
     // 使用测试数据生成游戏模型
     if (!GameModelGenerator::generateTestModel(_gameModel))
     {
@@ -91,7 +122,15 @@ bool GameController::startGame()
     
     // 清空撤销栈
     _undoManager.clearUndoStack();
+    captureInitialModel();
     updateUndoButtonState();
+    updateGameStatus();
+    
+    // 测试数据没有关卡配置，录像仅用于记录，无法回放校验
+    _replayRecorder.beginTestLevel();
+    _replayRecorder.updateResult(_gameModel);
+    reserveHistoryCapacity();
+    resetPublishedState();
     
     CCLOG("GameController: Game started");
     return true;
@@ -99,6 +138,12 @@ bool GameController::startGame()
 
 bool GameController::startGame(const LevelConfig& levelConfig)
 {
+    TRACE_SCOPE("controller", "GameController::startGame(LevelConfig)");
+    cancelHint();
+    
+    // 上一局的容器整体回收，本局按关卡的牌数一次预留
+    resetLevelArena(levelConfig.getPlayfieldCards().size(), levelConfig.getStackCards().size());
+    
     // 从配置生成游戏模型
     if (!GameModelGenerator::generate(levelConfig, _gameModel))
     {
@@ -109,45 +154,122 @@ bool GameController::startGame(const LevelConfig& levelConfig)
     // 初始化视图
     if (_gameView)
     {
-        _gameView->initGame(&_gameModel);
+        _gameView->initGame(&_gameModel, _levelArena);
     }
     
     // 清空撤销栈
     _undoManager.clearUndoStack();
+    captureInitialModel();
     updateUndoButtonState();
+    updateGameStatus();
+    
+    // 开始录制
+    _replayRecorder.begin(levelConfig);
+    _replayRecorder.updateResult(_gameModel);
+    reserveHistoryCapacity();
+    resetPublishedState();
     
-    CCLOG("GameController: Game started from config");
+    // 各固定块池的使用情况（卡牌视图、精灵、移动动作），峰值稳定说明换关时块都被复用
+    CCLOG("GameController: Game started from config\n%s", FixedBlockPool::getReport().c_str());
     return true;
 }
 
-bool GameController::handlePlayfieldCardClick(int cardId)
+bool GameController::saveSnapshot(const std::string& filePath) const
 {
-    if (_isAnimating)
+    // 动画中途保存也安全：模型在播放动画前已更新，恢复时会重新计算可点击状态
+    const ReplayModel& replay = _replayRecorder.getReplay();
+    return GameSnapshotService::saveToFile(filePath, _gameModel, _undoManager,
+                                           SnapshotLevel(replay.getLevelId(), replay.getLevelHash()));
+}
+
+bool GameController::restoreSnapshot(const std::string& filePath, LevelConfigCache* levelCache)
+{
+    TRACE_SCOPE("controller", "GameController::restoreSnapshot");
+    SnapshotLevel level;
+    if (!GameSnapshotService::loadFromFile(filePath, _gameModel, _undoManager, level))
     {
-        CCLOG("GameController: Animation in progress, ignoring click");
+        CCLOG("GameController: Failed to restore snapshot");
         return false;
     }
     
-    // 获取被点击的卡牌
-    CardModel* clickedCard = _gameModel.getPlayfieldCardById(cardId);
-    if (!clickedCard)
+    // 关卡取自快照，录像缺失时也能衔接下一关；之后restoreReplay成功则接着原录像录制
+    _replayRecorder.begin(level.levelId, level.levelHash);
+    cancelHint();
+    
+    // 读档后的模型未关联预编译数据，从缓存取得同一关卡后重新关联
+    std::shared_ptr<const CachedLevel> cachedLevel;
+    if (levelCache && level.levelHash != 0)
+    {
+        cachedLevel = level.levelId > 0 ? levelCache->getLevel(level.levelId) : levelCache->findByHash(level.levelHash);
+    }
+    if (!cachedLevel || cachedLevel->contentHash != level.levelHash
+        || !GameModelGenerator::attachCompiledLevel(*cachedLevel->config, _gameModel))
+    {
+        CCLOG("GameController: Snapshot level not found in cache, clickable state is recomputed per move");
+    }
+    GameModelGenerator::updatePlayfieldClickable(_gameModel);
+    captureInitialModel();
+    reserveHistoryCapacity();
+    resetPublishedState();
+    _isAnimating = false;
+    
+    if (_gameView)
     {
-        CCLOG("GameController: Card %d not found in playfield", cardId);
+        _gameView->initGame(&_gameModel);
+    }
+    updateUndoButtonState();
+    updateGameStatus();
+    
+    CCLOG("GameController: Game restored from snapshot");
+    return true;
+}
+
+bool GameController::saveReplay(const std::string& filePath) const
+{
+    return ReplayService::saveToFile(filePath, _replayRecorder.getReplay());
+}
+
+bool GameController::restoreReplay(const std::string& filePath)
+{
+    ReplayModel replay;
+    if (!ReplayService::loadFromFile(filePath, replay))
+    {
+        CCLOG("GameController: Failed to restore replay");
         return false;
     }
     
-    // 检查卡牌是否可点击（未被遮挡）
-    if (!clickedCard->isClickable())
+    // 录像须与快照属于同一关卡（版本1的快照没有关卡哈希，不检查）
+    uint32_t levelHash = _replayRecorder.getReplay().getLevelHash();
+    if (levelHash != 0 && replay.getLevelHash() != levelHash)
     {
-        CCLOG("GameController: Card %d is blocked by other cards", cardId);
+        CCLOG("GameController: Replay belongs to another level, ignored");
+        return false;
+    }
+    
+    _replayRecorder.resume(replay);
+    _replayRecorder.updateResult(_gameModel);
+    reserveHistoryCapacity();
+    
+    // 局面不变，只是关卡哈希换成录像中的
+    _statePublisher.publish(_currentState, _replayRecorder.getReplay().getLevelHash());
+    return true;
+}
+
+bool GameController::handlePlayfieldCardClick(int cardId)
+{
+    TRACE_SCOPE("controller", "GameController::handlePlayfieldCardClick");
+    ALLOC_SCOPE("GameController::handlePlayfieldCardClick");
+    if (_isAnimating)
+    {
+        CCLOG("GameController: Animation in progress, ignoring click");
         return false;
     }
     
-    // 检查是否可以与顶部牌匹配
-    const CardModel& topCard = _gameModel.getStackTopCard();
-    if (!clickedCard->canMatchWith(topCard))
+    // 检查卡牌是否存在、未被遮挡且能与顶部牌匹配
+    GameRuleResult result = GameRules::checkPlayfieldToStack(_gameModel, cardId);
+    if (result != GameRuleResult::OK)
     {
-        CCLOG("GameController: Card %d cannot match with top card", cardId);
+        CCLOG("GameController: Card %d rejected, %s", cardId, GameRules::getResultDescription(result));
         return false;
     }
     
@@ -159,18 +281,7 @@ bool GameController::handlePlayfieldCardClick(int cardId)
 void GameController::executePlayfieldToStack(int cardId)
 {
     _isAnimating = true; // 加锁，防止重复点击
-    
-    // 保存原始数据用于撤销
-    CardModel* clickedCard = _gameModel.getPlayfieldCardById(cardId);
-    if (!clickedCard)
-    {
-        _isAnimating = false;
-        return;
-    }
-    
-    CardModel movedCard = *clickedCard;
-    CardModel previousTopCard = _gameModel.getStackTopCard();
-    Vec2 originalPos = movedCard.getPosition();
+    cancelHint();
     
     // 获取目标位置
     Vec2 targetPos = Vec2::ZERO;
@@ -184,34 +295,42 @@ void GameController::executePlayfieldToStack(int cardId)
         }
     }
     
-    // 记录撤销操作
-    _undoManager.recordPlayfieldToStack(movedCard, previousTopCard, originalPos, targetPos);
-    
-    // 更新模型：从主牌区移除卡牌
-    _gameModel.removePlayfieldCard(cardId);
+    // 更新模型（含撤销记录和可点击状态）
+    if (GameRules::applyPlayfieldToStack(_gameModel, &_undoManager, cardId) != GameRuleResult::OK)
+    {
+        _isAnimating = false;
+        return;
+    }
+    _replayRecorder.recordPlayfieldToStack(cardId);
+    _replayRecorder.updateResult(_gameModel);
     
-    // 更新模型：设置新的顶部牌
-    movedCard.setArea(CardAreaType::STACK);
-    _gameModel.setStackTopCard(movedCard);
+    GameState nextState;
+    if (GameRules::applyPlayfieldToStack(_currentState, cardId, nextState) == GameRuleResult::OK)
+    {
+        commitPublishedState(nextState);
+    }
+    else
+    {
+        resetPublishedState();
+    }
     
-    // 播放视图动画
+    // 播放视图动画（回调只捕获this，可放进std::function的内部缓冲区，不分配内存）
     if (_gameView && _gameView->getPlayFieldView())
     {
-        _gameView->getPlayFieldView()->playMoveAnimation(cardId, targetPos, [this, movedCard]() {
-            // 动画完成后更新手牌区视图
+        _gameView->getPlayFieldView()->playMoveAnimation(cardId, targetPos, [this]() {
+            ALLOC_SCOPE("GameController::playfieldToStackFinished");
+            // 动画完成后更新手牌区视图，动画期间加锁，模型中的顶部牌就是刚移动的牌
             if (_gameView && _gameView->getStackView())
             {
-                _gameView->getStackView()->setTopCard(movedCard);
+                _gameView->getStackView()->setTopCard(_gameModel.getStackTopCard());
             }
             
-            // 更新主牌区卡牌的可点击状态
-            GameModelGenerator::updatePlayfieldClickable(_gameModel);
+            // 更新主牌区卡牌视图的可点击状态
             updatePlayfieldCardViews();
             
             _isAnimating = false;
             updateUndoButtonState();
-            
-            CCLOG("GameController: Card moved to stack");
+            updateGameStatus();
         });
     }
     else
@@ -223,6 +342,8 @@ void GameController::executePlayfieldToStack(int cardId)
 
 bool GameController::handleReserveClick()
 {
+    TRACE_SCOPE("controller", "GameController::handleReserveClick");
+    ALLOC_SCOPE("GameController::handleReserveClick");
     if (_isAnimating)
     {
         CCLOG("GameController: Animation in progress, ignoring click");
@@ -230,7 +351,7 @@ bool GameController::handleReserveClick()
     }
     
     // 检查备用牌堆是否有牌
-    if (_gameModel.isReserveEmpty())
+    if (GameRules::checkReserveToStack(_gameModel) != GameRuleResult::OK)
     {
         CCLOG("GameController: Reserve is empty");
         return false;
@@ -243,30 +364,32 @@ bool GameController::handleReserveClick()
 void GameController::executeReserveDraw()
 {
     _isAnimating = true;
+    cancelHint();
     
-    // 保存当前顶部牌用于撤销
-    CardModel previousTopCard = _gameModel.getStackTopCard();
-    
-    // 从备用牌堆抽取一张牌
-    CardModel drawnCard;
-    if (!_gameModel.drawReserveCard(drawnCard))
+    // 从备用牌堆抽取一张牌作为新的顶部牌（含撤销记录）
+    if (GameRules::applyReserveToStack(_gameModel, &_undoManager) != GameRuleResult::OK)
     {
         _isAnimating = false;
         return;
     }
+    _replayRecorder.recordReserveToStack();
+    _replayRecorder.updateResult(_gameModel);
     
-    // 记录撤销操作
-    _undoManager.recordReserveToStack(drawnCard, previousTopCard);
-    
-    // 更新模型：设置新的顶部牌
-    drawnCard.setArea(CardAreaType::STACK);
-    drawnCard.setFaceUp(true);
-    _gameModel.setStackTopCard(drawnCard);
+    GameState nextState;
+    if (GameRules::applyReserveToStack(_currentState, nextState) == GameRuleResult::OK)
+    {
+        commitPublishedState(nextState);
+    }
+    else
+    {
+        resetPublishedState();
+    }
     
     // 更新视图
     if (_gameView && _gameView->getStackView())
     {
-        _gameView->getStackView()->playDrawAnimation(drawnCard, [this]() {
+        _gameView->getStackView()->playDrawAnimation(_gameModel.getStackTopCard(), [this]() {
+            ALLOC_SCOPE("GameController::reserveDrawFinished");
             // 更新备用牌堆显示
             if (_gameView && _gameView->getStackView())
             {
@@ -275,8 +398,7 @@ void GameController::executeReserveDraw()
             
             _isAnimating = false;
             updateUndoButtonState();
-            
-            CCLOG("GameController: Drew card from reserve");
+            updateGameStatus();
         });
     }
     else
@@ -288,6 +410,8 @@ void GameController::executeReserveDraw()
 
 bool GameController::handleUndoClick()
 {
+    TRACE_SCOPE("controller", "GameController::handleUndoClick");
+    ALLOC_SCOPE("GameController::handleUndoClick");
     if (_isAnimating)
     {
         CCLOG("GameController: Animation in progress, ignoring undo");
@@ -301,11 +425,25 @@ bool GameController::handleUndoClick()
     }
     
     _isAnimating = true;
+    cancelHint();
     
     // 执行撤销
-    bool success = _undoManager.undo();
+    bool wasWin = GameRules::isWin(_gameModel);
+    bool success = GameRules::applyUndo(_gameModel, _undoManager) == GameRuleResult::OK;
     
-    if (!success)
+    if (success)
+    {
+        _replayRecorder.recordUndo();
+        _replayRecorder.updateResult(_gameModel);
+        revertPublishedState();
+        
+        // 胜利展示期间撤销最后一步同样离开胜利局面
+        if (wasWin && _levelReopenedCallback)
+        {
+            _levelReopenedCallback();
+        }
+    }
+    else
     {
         _isAnimating = false;
     }
@@ -313,15 +451,110 @@ bool GameController::handleUndoClick()
     return success;
 }
 
+bool GameController::handleHintClick()
+{
+    TRACE_SCOPE("controller", "GameController::handleHintClick");
+    ALLOC_SCOPE("GameController::handleHintClick");
+    if (_isAnimating)
+    {
+        CCLOG("GameController: Animation in progress, ignoring hint");
+        return false;
+    }
+    
+    // 清除上一次的提示，后台线程读取最新发布的局面进行搜索，主线程不复制模型
+    cancelHint();
+    _hintManager.requestHint([this](const HintResult& result) {
+        this->onHintReady(result);
+    });
+    return true;
+}
+
+void GameController::onHintReady(const HintResult& result)
+{
+    TRACE_SCOPE("controller", "GameController::onHintReady");
+    if (!_gameView || _isAnimating)
+    {
+        return;
+    }
+    
+    CCLOG("GameController: Hint %d card %d, clearable %d%s, %zu states",
+          static_cast<int>(result.action), result.cardId, result.clearableCards,
+          result.isComplete ? "" : " (partial)", result.visitedStates);
+    
+    if (result.action == GameActionType::PLAYFIELD_TO_STACK && _gameView->getPlayFieldView())
+    {
+        _gameView->getPlayFieldView()->showHint(result.cardId);
+    }
+    else if (result.action == GameActionType::RESERVE_TO_STACK && _gameView->getStackView())
+    {
+        _gameView->getStackView()->setReserveHighlighted(true);
+    }
+}
+
+void GameController::cancelHint()
+{
+    _hintManager.cancel();
+    
+    if (_gameView && _gameView->getPlayFieldView())
+    {
+        _gameView->getPlayFieldView()->clearHint();
+    }
+    if (_gameView && _gameView->getStackView())
+    {
+        _gameView->getStackView()->setReserveHighlighted(false);
+    }
+}
+
+bool GameController::handleRestartClick()
+{
+    TRACE_SCOPE("controller", "GameController::handleRestartClick");
+    if (!_hasInitialModel)
+    {
+        CCLOG("GameController: No level to restart");
+        return false;
+    }
+    
+    // 丢弃未返回的提示；进行中的动画由视图恢复时中止，其完成回调不再执行
+    cancelHint();
+    _isAnimating = false;
+    
+    // 按值复制回开局局面，各容器的容量在开局时已预留
+    _gameModel = _initialModel;
+    if (_gameView)
+    {
+        _gameView->resetGame(&_gameModel);
+    }
+    
+    _undoManager.clearUndoStack();
+    updateUndoButtonState();
+    updateGameStatus();
+    
+    // 同一关重新录制
+    _replayRecorder.restart();
+    _replayRecorder.updateResult(_gameModel);
+    reserveHistoryCapacity();
+    resetPublishedState();
+    
+    // 胜利展示期间重玩时，已开始准备的下一关须取消
+    if (_levelReopenedCallback)
+    {
+        _levelReopenedCallback();
+    }
+    
+    CCLOG("GameController: Level restarted");
+    return true;
+}
+
 void GameController::onUndoExecuted(const UndoModel& undoModel)
 {
+    TRACE_SCOPE("controller", "GameController::onUndoExecuted");
     // 根据操作类型更新视图
     switch (undoModel.getOperationType())
     {
         case CardOperationType::PLAYFIELD_TO_STACK:
         {
-            // 恢复卡牌到主牌区
-            const CardModel& movedCard = undoModel.getMovedCard();
+            // 恢复卡牌到主牌区（模型已恢复，动画完成后按ID从模型取牌）
+            int cardId = undoModel.getMovedCard().getCardId();
             const CardModel& previousTopCard = undoModel.getPreviousStackTopCard();
             Vec2 originalPos = undoModel.getOriginalPosition();
             
@@ -338,24 +571,23 @@ void GameController::onUndoExecuted(const UndoModel& undoModel)
                 _gameView->getStackView()->playUndoToPlayfieldAnimation(
                     targetWorldPos, 
                     previousTopCard,
-                    [this, movedCard, originalPos]() {
+                    [this, cardId]() {
+                        ALLOC_SCOPE("GameController::undoToPlayfieldFinished");
                         // 动画完成后，在主牌区添加卡牌视图
-                        if (_gameView && _gameView->getPlayFieldView())
+                        CardModel restoredCard;
+                        if (_gameModel.getPlayfieldCardById(cardId, restoredCard) &&
+                            _gameView && _gameView->getPlayFieldView())
                         {
-                            CardModel restoredCard = movedCard;
-                            restoredCard.setPosition(originalPos);
-                            restoredCard.setFaceUp(true);
-                            restoredCard.setClickable(true);
-                            _gameView->getPlayFieldView()->addCard(restoredCard);
+                            _gameView->getPlayFieldView()->addCard(
+                                restoredCard, _gameModel.getPlayfieldZOrder(cardId));
                         }
                         
-                        // 更新主牌区卡牌的可点击状态
-                        GameModelGenerator::updatePlayfieldClickable(_gameModel);
+                        // 更新主牌区卡牌视图的可点击状态
                         updatePlayfieldCardViews();
                         
                         _isAnimating = false;
                         updateUndoButtonState();
-                        CCLOG("GameController: Undo PLAYFIELD_TO_STACK completed");
+                        updateGameStatus();
                     });
             }
             else
@@ -376,6 +608,7 @@ void GameController::onUndoExecuted(const UndoModel& undoModel)
                 _gameView->getStackView()->playUndoToReserveAnimation(
                     previousTopCard,
                     [this]() {
+                        ALLOC_SCOPE("GameController::undoToReserveFinished");
                         // 动画完成后更新备用牌堆显示
                         if (_gameView && _gameView->getStackView())
                         {
@@ -385,7 +618,7 @@ void GameController::onUndoExecuted(const UndoModel& undoModel)
                         
                         _isAnimating = false;
                         updateUndoButtonState();
-                        CCLOG("GameController: Undo RESERVE_TO_STACK completed");
+                        updateGameStatus();
                     });
             }
             else
@@ -401,8 +634,104 @@ void GameController::onUndoExecuted(const UndoModel& undoModel)
             updateUndoButtonState();
             break;
     }
+}
+
+void GameController::reserveHistoryCapacity()
+{
+    // 撤销栈最深为已有记录加上仍可移动的牌数
+    size_t cardCount = _gameModel.getPlayfieldCards().size() + _gameModel.getReserveCardCount();
+    _undoManager.reserve(_undoManager.getUndoStackSize() + cardCount);
+    _replayRecorder.reserveFor(_gameModel);
+    _stateHistory.reserve(_stateHistory.size() + cardCount);
+}
+
+void GameController::resetLevelArena(size_t playfieldCount, size_t reserveCount)
+{
+    releaseLevelArena();
+    
+    // 没有内存池所有者时（如工具中单独使用控制器）仍使用全局堆
+    _levelArena = _levelArenaPool ? _levelArenaPool->acquire() : nullptr;
+    if (!_levelArena)
+    {
+        return;
+    }
     
-    CCLOG("GameController: Undo view animation started");
+    // 与reserveHistoryCapacity、GameModel::reserve、开局局面副本和视图索引预留的空间一致
+    size_t cardCount = playfieldCount + reserveCount;
+    _levelArena->reset(GameModel::getArenaBytes(playfieldCount, reserveCount) * 2
+                       + UndoManager::getArenaBytes(cardCount)
+                       + LevelArena::alignedSize(playfieldCount * sizeof(CardView*)));
+    _gameModel.setArena(_levelArena);
+    _initialModel.setArena(_levelArena);
+    _undoManager.setArena(_levelArena);
+}
+
+void GameController::releaseLevelArena()
+{
+    // 回收前所有指向内存池的容器都要先释放，否则会继续使用被下一局覆盖的内存
+    if (_gameView && _gameView->getPlayFieldView())
+    {
+        _gameView->getPlayFieldView()->clearAllCards();
+    }
+    _gameModel.setArena(nullptr);
+    _initialModel.setArena(nullptr);
+    _hasInitialModel = false;
+    _undoManager.setArena(nullptr);
+    
+    if (!_levelArena)
+    {
+        return;
+    }
+    
+    // reset按本局用量扩容，同一内存池下次被借出时不再溢出
+    if (_levelArena->getOverflowBlockCount() > 0)
+    {
+        CCLOG("GameController: Level arena overflowed (%zu of %zu bytes), it grows when reused",
+              _levelArena->getUsedBytes(), _levelArena->getCapacity());
+    }
+    _levelArenaPool->release(_levelArena);
+    _levelArena = nullptr;
+}
+
+void GameController::captureInitialModel()
+{
+    // 新开局时撤销栈为空，直接复制；读档时在副本上退回全部操作
+    _initialModel = _gameModel;
+    _undoManager.rewind(_initialModel);
+    GameModelGenerator::updatePlayfieldClickable(_initialModel);
+    _hasInitialModel = true;
+}
+
+void GameController::resetPublishedState()
+{
+    _stateHistory.clear();
+    if (!GameSnapshotService::captureState(_gameModel, _currentState))
+    {
+        // 无法创建局面时发布无效局面，后台读者据此跳过
+        _currentState = GameState();
+    }
+    _statePublisher.publish(_currentState, _replayRecorder.getReplay().getLevelHash());
+}
+
+void GameController::commitPublishedState(const GameState& state)
+{
+    // 局面是结构共享的，保存历史和发布都是O(1)的复制，容量已在开局时预留
+    _stateHistory.push_back(_currentState);
+    _currentState = state;
+    _statePublisher.publish(_currentState, _replayRecorder.getReplay().getLevelHash());
+}
+
+void GameController::revertPublishedState()
+{
+    // 读档恢复的撤销记录没有对应的局面历史，只能由撤销后的模型重新创建
+    if (_stateHistory.empty())
+    {
+        resetPublishedState();
+        return;
+    }
+    _currentState = _stateHistory.back();
+    _stateHistory.pop_back();
+    _statePublisher.publish(_currentState, _replayRecorder.getReplay().getLevelHash());
 }
 
 bool GameController::canUndo() const
@@ -418,8 +747,43 @@ void GameController::updateUndoButtonState()
     }
 }
 
+void GameController::updateGameStatus()
+{
+    TRACE_SCOPE("controller", "GameController::updateGameStatus");
+    if (!_gameView)
+    {
+        return;
+    }
+    
+    if (GameRules::isWin(_gameModel))
+    {
+        _gameView->showMessage("You Win!");
+        if (_levelClearedCallback)
+        {
+            _levelClearedCallback();
+        }
+        return;
+    }
+    
+    _gameView->hideMessage();
+    
+    // 主牌区无牌可走时提示翻牌，连备用牌堆也空了则提示无路可走
+    if (!GameRules::hasPlayfieldMove(_gameModel))
+    {
+        if (GameRules::isDeadEnd(_gameModel))
+        {
+            _gameView->showMessage("No moves left");
+        }
+        else if (_gameView->getStackView())
+        {
+            _gameView->getStackView()->setReserveHighlighted(true);
+        }
+    }
+}
+
 void GameController::updatePlayfieldCardViews()
 {
+    TRACE_SCOPE("controller", "GameController::updatePlayfieldCardViews");
     if (!_gameView || !_gameView->getPlayFieldView())
     {
         return;
@@ -431,6 +795,4 @@ void GameController::updatePlayfieldCardViews()
     {
         _gameView->getPlayFieldView()->updateCardView(card);
     }
-    
-    CCLOG("GameController: Updated %zu card views", cards.size());
 }
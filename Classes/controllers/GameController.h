@@ -7,6 +7,7 @@
  * - 处理主牌区卡牌点击（匹配逻辑）
  * - 处理备用牌堆点击（翻牌逻辑）
  * - 处理回退操作
+ * - 重玩本关（复制开局局面，原地恢复视图）
  * - 协调模型和视图的更新
  */
 
@@ -16,8 +17,17 @@
 #include "models/GameModel.h"
 #include "views/GameView.h"
 #include "managers/UndoManager.h"
+#include "managers/ReplayRecorder.h"
+#include "managers/HintManager.h"
+#include "managers/GameStatePublisher.h"
+#include "models/GameState.h"
 #include "configs/LevelConfig.h"
+#include "managers/LevelConfigCache.h"
+#include "utils/LevelArena.h"
+#include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 /**
  * @brief 游戏控制器类
@@ -28,6 +38,12 @@
 class GameController
 {
 public:
+    /// 过关回调类型（主牌区清空时调用，用于准备下一关）
+    using LevelClearedCallback = std::function<void()>;
+    
+    /// 过关后又离开胜利局面的回调类型（重玩或撤销时调用，用于取消下一关的准备）
+    using LevelReopenedCallback = std::function<void()>;
+    
     /**
      * @brief 构造函数
      */
@@ -43,9 +59,10 @@ public:
     /**
      * @brief 初始化控制器
      * @param gameView 游戏视图指针
+     * @param levelArenaPool 关卡内存池的所有者（生命周期须长于控制器），为nullptr时使用全局堆
      * @return 初始化成功返回true
      */
-    bool init(GameView* gameView);
+    bool init(GameView* gameView, LevelArenaPool* levelArenaPool = nullptr);
     
     /**
      * @brief 开始游戏（使用测试数据）
@@ -81,6 +98,21 @@ public:
      */
     bool handleUndoClick();
     
+    /**
+     * @brief 处理提示按钮点击（后台计算，结果返回后高亮）
+     * @return 已发起提示请求返回true
+     */
+    bool handleHintClick();
+    
+    /**
+     * @brief 处理重玩按钮点击：回到本关开局
+     * @return 重玩成功返回true
+     * 
+     * 不重新加载关卡配置、不生成模型、不重建视图：开局局面在开局时已保存，
+     * 模型按值复制回来（容量已预留，不分配内存），视图原地恢复，动画进行中也可以重玩。
+     */
+    bool handleRestartClick();
+    
     // ========== 状态查询方法 ==========
     
     /**
@@ -94,6 +126,61 @@ public:
      * @return 游戏模型的const指针
      */
     const GameModel* getGameModel() const { return &_gameModel; }
+    
+    // ========== 存档方法 ==========
+    
+    /**
+     * @brief 保存当前游戏状态（含撤销栈）为二进制快照
+     * @param filePath 快照文件完整路径
+     * @return 保存成功返回true
+     */
+    bool saveSnapshot(const std::string& filePath) const;
+    
+    /**
+     * @brief 从二进制快照恢复游戏状态并重建视图
+     * @param filePath 快照文件完整路径
+     * @param levelCache 关卡缓存，为nullptr时不关联预编译数据
+     * @return 恢复成功返回true
+     * 
+     * 录像从快照记录的关卡重新开始，随后可用restoreReplay接上原录像。
+     * 按快照记录的关卡ID取得已编译的关卡，哈希一致时重新关联其遮挡数据，
+     * 之后每步按遮挡关系增量更新；关卡不符（或版本1的快照）时才按坐标重新计算。
+     */
+    bool restoreSnapshot(const std::string& filePath, LevelConfigCache* levelCache = nullptr);
+    
+    /**
+     * @brief 保存本局录像
+     * @param filePath 录像文件完整路径
+     * @return 保存成功返回true
+     */
+    bool saveReplay(const std::string& filePath) const;
+    
+    /**
+     * @brief 加载录像并继续录制（配合restoreSnapshot恢复对局时使用）
+     * @param filePath 录像文件完整路径
+     * @return 加载成功且与快照属于同一关卡返回true
+     */
+    bool restoreReplay(const std::string& filePath);
+    
+    /**
+     * @brief 获取本局录像（只读）
+     * @return 录像模型的const引用
+     */
+    const ReplayModel& getReplay() const { return _replayRecorder.getReplay(); }
+    
+    // ========== 回调设置 ==========
+    
+    /**
+     * @brief 设置过关回调（每次检查到胜利局面时调用，调用者自行去重）
+     * @param callback 回调函数
+     */
+    void setLevelClearedCallback(const LevelClearedCallback& callback) { _levelClearedCallback = callback; }
+    
+    /**
+     * @brief 设置离开胜利局面的回调（重玩时总是调用，撤销时仅在撤销前已获胜时调用）
+     * @param callback 回调函数
+     */
+    void setLevelReopenedCallback(const LevelReopenedCallback& callback) { _levelReopenedCallback = callback; }
 
 private:
     /**
@@ -123,16 +210,83 @@ private:
      */
     void executeReserveDraw();
     
+    /**
+     * @brief 按剩余牌数预留撤销栈和录像容量，使对局中的操作不再分配内存
+     */
+    void reserveHistoryCapacity();
+    
+    /**
+     * @brief 释放上一局的容器后借出并回收关卡内存池，按本关牌数预留并让模型和撤销栈改用它
+     * @param playfieldCount 主牌区卡牌数
+     * @param reserveCount 手牌区与备用牌堆卡牌数
+     */
+    void resetLevelArena(size_t playfieldCount, size_t reserveCount);
+    
+    /**
+     * @brief 让模型、撤销栈和视图索引释放内存池中的空间并改用全局堆，再把内存池归还所有者
+     */
+    void releaseLevelArena();
+    
+    /**
+     * @brief 保存开局局面供重玩使用（当前模型退回撤销栈中的全部操作）
+     */
+    void captureInitialModel();
+    
+    // ========== 局面发布 ==========
+    
+    /**
+     * @brief 由当前模型重新创建局面，清空局面历史并发布（开局、读档等整体替换模型后调用）
+     */
+    void resetPublishedState();
+    
+    /**
+     * @brief 发布提交操作后的新局面，旧局面留作撤销时恢复
+     * @param state 新局面
+     */
+    void commitPublishedState(const GameState& state);
+    
+    /**
+     * @brief 撤销后退回上一个局面并发布
+     */
+    void revertPublishedState();
+    
     /**
      * @brief 更新主牌区卡牌视图的可点击状态
      */
     void updatePlayfieldCardViews();
+    
+    /**
+     * @brief 根据局面显示胜利、无路可走或翻牌提示
+     */
+    void updateGameStatus();
+    
+    /**
+     * @brief 取消未返回的提示并清除高亮（任何改变局面的操作前调用）
+     */
+    void cancelHint();
+    
+    /**
+     * @brief 显示提示结果
+     * @param result 提示结果
+     */
+    void onHintReady(const HintResult& result);
 
 private:
-    GameModel _gameModel;           ///< 游戏数据模型
-    GameView* _gameView;            ///< 游戏视图指针
-    UndoManager _undoManager;       ///< 撤销管理器
-    bool _isAnimating;              ///< 是否正在播放动画
+    LevelArenaPool* _levelArenaPool;      ///< 关卡内存池的所有者（不持有）
+    LevelArena* _levelArena;              ///< 本局借用的关卡内存池，未借用为nullptr
+    GameModel _gameModel;                 ///< 游戏数据模型
+    GameModel _initialModel;              ///< 开局局面（重玩时复制回_gameModel）
+    bool _hasInitialModel;                ///< 是否已保存开局局面
+    GameView* _gameView;                  ///< 游戏视图指针
+    UndoManager _undoManager;             ///< 撤销管理器
+    ReplayRecorder _replayRecorder;       ///< 对局录像管理器
+    GameStatePublisher _statePublisher;   ///< 局面发布器（须在读取它的后台管理器之前构造）
+    GameState _currentState;              ///< 最近发布的局面
+    std::vector<GameState> _stateHistory; ///< 之前的局面，撤销时依次恢复
+    HintManager _hintManager;             ///< 提示管理器
+    bool _isAnimating;                    ///< 是否正在播放动画
+    LevelClearedCallback _levelClearedCallback; ///< 过关回调
+    LevelReopenedCallback _levelReopenedCallback; ///< 离开胜利局面回调
 };
 
 #endif // __GAME_CONTROLLER_H__
@@ -0,0 +1,85 @@
+/**
+ * @file GameStatePublisher.cpp
+ * @brief 局面发布器实现
+ */
+
+#include "managers/GameStatePublisher.h"
+#include <thread>
+
+const int GameStatePublisher::kSlotCount;
+
+GameStatePublisher::GameStatePublisher()
+    : _latest(-1)
+    , _epoch(0)
+{
+    for (Slot& slot : _slots)
+    {
+        slot.readers.store(0);
+    }
+}
+
+uint64_t GameStatePublisher::publish(const GameState& state, uint32_t levelHash)
+{
+    Slot& slot = _slots[acquireWritableSlot()];
+    uint64_t epoch = _epoch.load(std::memory_order_relaxed) + 1;
+    slot.snapshot.epoch = epoch;
+    slot.snapshot.levelHash = levelHash;
+    slot.snapshot.state = state;
+    
+    // 先写完槽位再切换最新下标，读者确认下标后看到的一定是完整的局面
+    _latest.store(static_cast<int>(&slot - _slots));
+    _epoch.store(epoch, std::memory_order_release);
+    return epoch;
+}
+
+bool GameStatePublisher::readLatest(PublishedGameState& outSnapshot) const
+{
+    for (;;)
+    {
+        int index = _latest.load();
+        if (index < 0)
+        {
+            return false;
+        }
+        
+        // 加计数后槽位仍是最新的，写者就不会再修改它；否则写者可能正在改写，换最新槽位重试
+        const Slot& slot = _slots[index];
+        slot.readers.fetch_add(1);
+        bool isLatest = _latest.load() == index;
+        if (isLatest)
+        {
+            outSnapshot = slot.snapshot;
+        }
+        slot.readers.fetch_sub(1);
+        if (isLatest)
+        {
+            return true;
+        }
+    }
+}
+
+bool GameStatePublisher::readIfNewer(uint64_t knownEpoch, PublishedGameState& outSnapshot) const
+{
+    if (getEpoch() <= knownEpoch)
+    {
+        return false;
+    }
+    return readLatest(outSnapshot) && outSnapshot.epoch > knownEpoch;
+}
+
+int GameStatePublisher::acquireWritableSlot() const
+{
+    // 读者只在复制GameState的几十纳秒内占用槽位，找不到空闲槽位时让出时间片重试即可
+    for (;;)
+    {
+        int latest = _latest.load();
+        for (int index = 0; index < kSlotCount; index++)
+        {
+            if (index != latest && _slots[index].readers.load() == 0)
+            {
+                return index;
+            }
+        }
+        std::this_thread::yield();
+    }
+}
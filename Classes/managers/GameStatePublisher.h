@@ -0,0 +1,111 @@
+/**
+ * @file GameStatePublisher.h
+ * @brief 局面发布器
+ * 
+ * 主线程每提交一次操作（出牌、翻牌、撤销、开局、读档）就发布一个不可变局面，
+ * 并递增版本号（epoch）。提示、自动存档、统计、预加载等后台线程随时读取最新的局面，
+ * 读写双方都不加锁：
+ * - 局面放在固定数量的槽位中，最新槽位的下标是原子变量
+ * - 读者先给槽位加引用计数，再确认它仍是最新槽位，然后复制局面（GameState复制为O(1)）
+ * - 写者只写既不是最新、引用计数也为0的槽位，写完后再切换最新下标
+ * 因此后台线程拿到的总是某个完整提交后的局面，不会看到主线程修改到一半的GameModel。
+ * 
+ * 作为controller的成员变量使用，只能由一个线程（主线程）发布。
+ */
+
+#ifndef __GAME_STATE_PUBLISHER_H__
+#define __GAME_STATE_PUBLISHER_H__
+
+#include "models/GameState.h"
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief 已发布的局面
+ */
+struct PublishedGameState
+{
+    uint64_t epoch;         ///< 版本号，从1开始，每次发布递增
+    uint32_t levelHash;     ///< 关卡内容哈希（用于后台缓存按关卡区分）
+    GameState state;        ///< 不可变局面
+    
+    PublishedGameState()
+        : epoch(0)
+        , levelHash(0)
+    {
+    }
+};
+
+/**
+ * @brief 局面发布器类
+ * 
+ * 符合managers层的设计规范：
+ * - 作为controller的成员变量
+ * - 可持有model数据
+ * - 禁止单例模式
+ */
+class GameStatePublisher
+{
+public:
+    /// 槽位数量：一个最新槽位，其余供写者轮换（读者只在复制期间占用槽位）
+    static const int kSlotCount = 4;
+    
+    /**
+     * @brief 构造函数，初始时没有已发布的局面
+     */
+    GameStatePublisher();
+    
+    GameStatePublisher(const GameStatePublisher&) = delete;
+    GameStatePublisher& operator=(const GameStatePublisher&) = delete;
+    
+    /**
+     * @brief 发布新局面（只能在主线程调用）
+     * @param state 提交操作后的局面
+     * @param levelHash 关卡内容哈希
+     * @return 新局面的版本号
+     */
+    uint64_t publish(const GameState& state, uint32_t levelHash);
+    
+    /**
+     * @brief 获取最新已发布局面的版本号（任意线程，不复制局面）
+     * @return 版本号，尚未发布时为0
+     */
+    uint64_t getEpoch() const { return _epoch.load(std::memory_order_acquire); }
+    
+    /**
+     * @brief 读取最新已发布的局面（任意线程，无锁）
+     * @param outSnapshot 输出的局面
+     * @return 尚未发布时返回false
+     */
+    bool readLatest(PublishedGameState& outSnapshot) const;
+    
+    /**
+     * @brief 只在有比已知版本更新的局面时读取
+     * @param knownEpoch 调用者已处理的版本号
+     * @param outSnapshot 输出的局面
+     * @return 读到更新的局面返回true
+     */
+    bool readIfNewer(uint64_t knownEpoch, PublishedGameState& outSnapshot) const;
+
+private:
+    /**
+     * @brief 局面槽位
+     */
+    struct Slot
+    {
+        mutable std::atomic<int> readers;   ///< 正在复制该槽位的读者数量
+        PublishedGameState snapshot;        ///< 局面（只在无读者且非最新时由写者修改）
+    };
+    
+    /**
+     * @brief 找一个可写的槽位：非最新且没有读者
+     * @return 槽位下标
+     */
+    int acquireWritableSlot() const;
+    
+    Slot _slots[kSlotCount];        ///< 局面槽位
+    std::atomic<int> _latest;       ///< 最新槽位下标，尚未发布时为-1
+    std::atomic<uint64_t> _epoch;   ///< 最新版本号
+};
+
+#endif // __GAME_STATE_PUBLISHER_H__
@@ -0,0 +1,127 @@
+/**
+ * @file HintManager.cpp
+ * @brief 提示管理器实现
+ */
+
+#include "managers/HintManager.h"
+#include "services/GameSnapshotService.h"
+#include "cocos2d.h"
+
+USING_NS_CC;
+
+HintManager::HintManager()
+    : _hasRequest(false)
+    , _isStopping(false)
+    , _publisher(nullptr)
+    , _pendingGeneration(0)
+    , _budgetMs(kDefaultBudgetMs)
+    , _generation(std::make_shared<std::atomic<unsigned>>(0))
+{
+}
+
+HintManager::~HintManager()
+{
+    cancel();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+    _condition.notify_one();
+    if (_worker.joinable())
+    {
+        _worker.join();
+    }
+}
+
+void HintManager::ensureWorker()
+{
+    if (!_worker.joinable())
+    {
+        _worker = std::thread(&HintManager::workerLoop, this);
+    }
+}
+
+void HintManager::init(const GameStatePublisher* publisher)
+{
+    _publisher = publisher;
+}
+
+void HintManager::requestHint(const HintCallback& callback)
+{
+    if (!_publisher)
+    {
+        CCLOG("HintManager: No state publisher, ignoring hint request");
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pendingGeneration = ++(*_generation);
+        _pendingCallback = callback;
+        _hasRequest = true;
+    }
+    ensureWorker();
+    _condition.notify_one();
+}
+
+void HintManager::cancel()
+{
+    ++(*_generation);
+    
+    std::lock_guard<std::mutex> lock(_mutex);
+    _hasRequest = false;
+    _pendingCallback = nullptr;
+}
+
+void HintManager::workerLoop()
+{
+    GameModel gameModel;
+    PublishedGameState published;
+    for (;;)
+    {
+        unsigned generation = 0;
+        HintCallback callback;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this]() { return _hasRequest || _isStopping; });
+            if (_isStopping)
+            {
+                return;
+            }
+            generation = _pendingGeneration;
+            callback.swap(_pendingCallback);
+            _hasRequest = false;
+        }
+        
+        std::shared_ptr<std::atomic<unsigned>> token = _generation;
+        auto isCancelled = [&token, generation]() { return token->load() != generation; };
+        if (isCancelled())
+        {
+            continue;
+        }
+        
+        // 读取最新提交的局面，还原为搜索用的模型（在工作线程进行，主线程不受影响）
+        if (!_publisher->readLatest(published) || !published.state.isValid())
+        {
+            continue;
+        }
+        GameSnapshotService::restoreState(published.state, gameModel);
+        
+        _cache.bindLevel(published.levelHash);
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_budgetMs.load());
+        HintResult result = HintSolver::findBestMove(gameModel, _cache, deadline, isCancelled);
+        if (isCancelled())
+        {
+            continue;
+        }
+        
+        // 回到主线程交付结果；交付前玩家可能已操作，需再次确认
+        Director::getInstance()->getScheduler()->performFunctionInCocosThread(
+            [token, generation, callback, result]() {
+                if (token->load() == generation && callback)
+                {
+                    callback(result);
+                }
+            });
+    }
+}
@@ -0,0 +1,110 @@
+/**
+ * @file HintManager.h
+ * @brief 提示管理器
+ * 
+ * 负责在后台线程中计算提示，包括：
+ * - 工作线程从局面发布器读取最新局面进行搜索，主线程不复制模型
+ * - 时间预算控制，超时返回当前最优结果
+ * - 玩家操作后立即取消未完成的提示
+ * - 在同一关卡内复用搜索缓存
+ * 
+ * 作为controller的成员变量使用，可持有model数据。
+ */
+
+#ifndef __HINT_MANAGER_H__
+#define __HINT_MANAGER_H__
+
+#include "managers/GameStatePublisher.h"
+#include "models/GameModel.h"
+#include "services/HintSolver.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief 提示管理器类
+ * 
+ * 主线程只负责发出请求和接收结果，局面读取和搜索全部在工作线程中进行。
+ * 结果通过cocos调度器回到主线程，回调前会确认请求没有被取消。
+ * 符合managers层的设计规范：
+ * - 作为controller的成员变量
+ * - 可持有model数据
+ * - 禁止单例模式
+ * - 通过回调与其他模块交互
+ */
+class HintManager
+{
+public:
+    /// 提示结果回调类型（在主线程调用）
+    using HintCallback = std::function<void(const HintResult& result)>;
+    
+    /// 默认搜索时间预算（毫秒）
+    static const int kDefaultBudgetMs = 5;
+    
+    /**
+     * @brief 构造函数
+     */
+    HintManager();
+    
+    /**
+     * @brief 析构函数，取消未完成的提示并等待工作线程退出
+     */
+    ~HintManager();
+    
+    /**
+     * @brief 初始化
+     * @param publisher 局面发布器（生命周期须长于本管理器）
+     */
+    void init(const GameStatePublisher* publisher);
+    
+    /**
+     * @brief 请求提示，立即返回，覆盖尚未完成的请求
+     * 
+     * 搜索最新发布的局面，关卡哈希随局面一起发布，用于决定是否复用搜索缓存。
+     * @param callback 结果回调
+     */
+    void requestHint(const HintCallback& callback);
+    
+    /**
+     * @brief 取消尚未返回的提示（玩家操作后调用）
+     */
+    void cancel();
+    
+    /**
+     * @brief 设置搜索时间预算
+     * @param budgetMs 毫秒数
+     */
+    void setTimeBudget(int budgetMs) { _budgetMs = budgetMs; }
+
+private:
+    /**
+     * @brief 工作线程主循环
+     */
+    void workerLoop();
+    
+    /**
+     * @brief 确保工作线程已启动
+     */
+    void ensureWorker();
+
+private:
+    std::thread _worker;                    ///< 工作线程（首次请求时启动）
+    std::mutex _mutex;                      ///< 保护待处理请求
+    std::condition_variable _condition;     ///< 通知工作线程
+    bool _hasRequest;                       ///< 是否有待处理请求
+    bool _isStopping;                       ///< 是否正在退出
+    const GameStatePublisher* _publisher;   ///< 局面发布器（工作线程只读）
+    unsigned _pendingGeneration;            ///< 待处理请求的序号
+    HintCallback _pendingCallback;          ///< 待处理请求的回调
+    std::atomic<int> _budgetMs;             ///< 搜索时间预算（毫秒）
+    
+    /// 当前有效请求序号，取消时递增；与主线程回调共享，管理器销毁后仍可安全检查
+    std::shared_ptr<std::atomic<unsigned>> _generation;
+    
+    HintCache _cache;                       ///< 搜索缓存（仅工作线程访问）
+};
+
+#endif // __HINT_MANAGER_H__
@@ -0,0 +1,226 @@
+/**
+ * @file LevelConfigCache.cpp
+ * @brief 关卡缓存实现
+ */
+
+#include "managers/LevelConfigCache.h"
+#include "configs/LevelConfigLoader.h"
+#include "models/GameModel.h"
+#include "services/GameModelGenerator.h"
+#include "services/GameSnapshotService.h"
+#include "services/LevelCompiler.h"
+#include "cocos2d.h"
+#include <algorithm>
+
+const size_t LevelConfigCache::kDefaultCapacity;
+
+namespace
+{
+    /**
+     * @brief 默认加载函数：从资源目录读取关卡文件
+     */
+    bool loadFromResources(int levelId, LevelConfig& outConfig)
+    {
+        return LevelConfigLoader::loadFromFile(LevelConfigLoader::getLevelConfigPath(levelId), outConfig);
+    }
+}
+
+LevelConfigCache::LevelConfigCache(size_t capacity, LoadFunction loadFunction)
+    : _capacity(std::max<size_t>(capacity, 1))
+    , _loadFunction(loadFunction ? std::move(loadFunction) : LoadFunction(loadFromResources))
+    , _hitCount(0)
+    , _missCount(0)
+{
+    _entriesById.reserve(_capacity);
+    _entriesByHash.reserve(_capacity);
+}
+
+std::shared_ptr<const CachedLevel> LevelConfigCache::getLevel(int levelId)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto iter = _entriesById.find(levelId);
+        if (iter != _entriesById.end())
+        {
+            _hitCount++;
+            touch(iter->second);
+            return iter->second->level;
+        }
+        _missCount++;
+    }
+    
+    // 加载和编译在锁外进行，其他线程仍可读取已缓存的关卡
+    std::shared_ptr<LevelConfig> levelConfig = std::make_shared<LevelConfig>();
+    std::shared_ptr<const CachedLevel> level;
+    if (_loadFunction(levelId, *levelConfig))
+    {
+        // 录像需要记录关卡ID：文件未写明时按请求的ID补填；已写明时以文件为准（发牌顺序取决于它）
+        if (levelConfig->getLevelId() == 0)
+        {
+            levelConfig->setLevelId(levelId);
+        }
+        else if (levelConfig->getLevelId() != levelId)
+        {
+            CCLOG("LevelConfigCache: Level %d declares LevelId %d", levelId, levelConfig->getLevelId());
+        }
+        level = buildLevel(std::move(levelConfig));
+    }
+    if (!level)
+    {
+        CCLOG("LevelConfigCache: Failed to load level %d", levelId);
+    }
+    
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto iter = _entriesById.find(levelId);
+    if (iter != _entriesById.end())
+    {
+        // 其他线程已同时加载了同一关卡，使用先缓存的一份
+        touch(iter->second);
+        return iter->second->level;
+    }
+    return addEntry(levelId, std::move(level))->level;
+}
+
+std::shared_ptr<const CachedLevel> LevelConfigCache::findByHash(uint32_t contentHash)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto iter = _entriesByHash.find(contentHash);
+    if (iter == _entriesByHash.end())
+    {
+        _missCount++;
+        return nullptr;
+    }
+    _hitCount++;
+    touch(iter->second);
+    return iter->second->level;
+}
+
+std::shared_ptr<const CachedLevel> LevelConfigCache::insert(const LevelConfig& levelConfig)
+{
+    const int levelId = std::max(levelConfig.getLevelId(), 0);
+    const uint32_t contentHash = levelConfig.computeContentHash();
+    
+    // 内容相同且ID一致（或未指定ID）时直接复用
+    auto findSame = [this, levelId, contentHash]() {
+        auto iter = _entriesByHash.find(contentHash);
+        if (iter != _entriesByHash.end() && (levelId == 0 || iter->second->levelId == levelId))
+        {
+            return iter->second;
+        }
+        return _entries.end();
+    };
+    
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto iter = findSame();
+        if (iter != _entries.end())
+        {
+            _hitCount++;
+            touch(iter);
+            return iter->level;
+        }
+        _missCount++;
+    }
+    
+    std::shared_ptr<const CachedLevel> level = buildLevel(std::make_shared<LevelConfig>(levelConfig));
+    if (!level)
+    {
+        CCLOG("LevelConfigCache: Invalid level config (hash %08x)", contentHash);
+        return nullptr;
+    }
+    
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto iter = findSame();
+    if (iter != _entries.end())
+    {
+        touch(iter);
+        return iter->level;
+    }
+    return addEntry(levelId, std::move(level))->level;
+}
+
+void LevelConfigCache::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entriesById.clear();
+    _entriesByHash.clear();
+    _entries.clear();
+}
+
+size_t LevelConfigCache::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+}
+
+uint64_t LevelConfigCache::getHitCount() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _hitCount;
+}
+
+uint64_t LevelConfigCache::getMissCount() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _missCount;
+}
+
+std::shared_ptr<const CachedLevel> LevelConfigCache::buildLevel(std::shared_ptr<LevelConfig> levelConfig)
+{
+    // 预编译后所有对局的模型共享同一份遮挡数据，不再各自计算
+    if (!levelConfig->isCompiled() && !LevelCompiler::compile(*levelConfig))
+    {
+        return nullptr;
+    }
+    
+    GameModel gameModel;
+    std::shared_ptr<CachedLevel> level = std::make_shared<CachedLevel>();
+    if (!GameModelGenerator::generate(*levelConfig, gameModel) ||
+        !GameSnapshotService::captureState(gameModel, level->initialState))
+    {
+        return nullptr;
+    }
+    level->contentHash = levelConfig->computeContentHash();
+    level->config = std::move(levelConfig);
+    return level;
+}
+
+void LevelConfigCache::touch(EntryList::iterator iter)
+{
+    _entries.splice(_entries.begin(), _entries, iter);
+}
+
+LevelConfigCache::EntryList::iterator LevelConfigCache::addEntry(int levelId, std::shared_ptr<const CachedLevel> level)
+{
+    _entries.push_front(Entry{levelId, std::move(level)});
+    EntryList::iterator entry = _entries.begin();
+    if (levelId > 0)
+    {
+        _entriesById[levelId] = entry;
+    }
+    if (entry->level)
+    {
+        _entriesByHash[entry->level->contentHash] = entry;
+    }
+    
+    // 淘汰最久未使用的缓存项，索引只在仍指向该项时删除（同ID或同内容的新项可能已替换索引）
+    while (_entries.size() > _capacity)
+    {
+        EntryList::iterator oldest = std::prev(_entries.end());
+        auto idIter = _entriesById.find(oldest->levelId);
+        if (idIter != _entriesById.end() && idIter->second == oldest)
+        {
+            _entriesById.erase(idIter);
+        }
+        if (oldest->level)
+        {
+            auto hashIter = _entriesByHash.find(oldest->level->contentHash);
+            if (hashIter != _entriesByHash.end() && hashIter->second == oldest)
+            {
+                _entriesByHash.erase(hashIter);
+            }
+        }
+        _entries.pop_back();
+    }
+    return entry;
+}
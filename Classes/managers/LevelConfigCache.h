@@ -0,0 +1,139 @@
+/**
+ * @file LevelConfigCache.h
+ * @brief 关卡缓存
+ * 
+ * 同一关卡的所有对局共享一份只读数据：
+ * - 关卡配置加载后立即预编译（遮挡关系、绘制顺序），之后不再修改
+ * - 同时生成开局局面，局面的关卡数据（布局、牌面、遮挡）由所有对局共享
+ * - 按关卡ID和内容哈希两种键查找，超出容量时淘汰最久未使用的关卡
+ * 新对局复制开局局面只增加引用计数，不分配内存；被淘汰的关卡在最后一个对局结束后释放。
+ * 
+ * 线程安全，加载和编译在锁外进行。作为场景或工具的成员变量使用，禁止单例。
+ */
+
+#ifndef __LEVEL_CONFIG_CACHE_H__
+#define __LEVEL_CONFIG_CACHE_H__
+
+#include "configs/LevelConfig.h"
+#include "models/GameState.h"
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * @brief 缓存的关卡（创建后不再修改，可在多个线程中同时读取）
+ */
+struct CachedLevel
+{
+    std::shared_ptr<const LevelConfig> config;  ///< 已预编译的关卡配置
+    GameState initialState;                     ///< 开局局面
+    uint32_t contentHash;                       ///< 关卡内容哈希
+    
+    CachedLevel()
+        : contentHash(0)
+    {
+    }
+};
+
+/**
+ * @brief 关卡缓存类
+ */
+class LevelConfigCache
+{
+public:
+    /// 按关卡ID加载配置的函数类型，成功返回true
+    using LoadFunction = std::function<bool(int levelId, LevelConfig& outConfig)>;
+    
+    /// 默认容量（关卡数）
+    static const size_t kDefaultCapacity = 16;
+    
+    /**
+     * @brief 构造函数
+     * @param capacity 最多缓存的关卡数（至少为1）
+     * @param loadFunction 加载函数，为空时通过LevelConfigLoader从资源目录加载
+     * 
+     * 默认加载函数使用FileUtils，只能在主线程调用getLevel；
+     * 多个线程同时加载时须提供线程安全的加载函数。
+     */
+    explicit LevelConfigCache(size_t capacity = kDefaultCapacity, LoadFunction loadFunction = nullptr);
+    
+    LevelConfigCache(const LevelConfigCache&) = delete;
+    LevelConfigCache& operator=(const LevelConfigCache&) = delete;
+    
+    /**
+     * @brief 按关卡ID获取关卡，未缓存时加载
+     * @param levelId 关卡ID
+     * @return 缓存的关卡，加载失败返回nullptr（失败结果同样缓存，直到被淘汰或clear）
+     */
+    std::shared_ptr<const CachedLevel> getLevel(int levelId);
+    
+    /**
+     * @brief 按内容哈希查找已缓存的关卡（不加载）
+     * @param contentHash 关卡内容哈希
+     * @return 缓存的关卡，未缓存返回nullptr
+     */
+    std::shared_ptr<const CachedLevel> findByHash(uint32_t contentHash);
+    
+    /**
+     * @brief 缓存一个已加载的关卡（如生成的关卡），内容相同的关卡只保留一份
+     * @param levelConfig 关卡配置，ID大于0时同时可按ID查找
+     * @return 缓存的关卡，配置无效返回nullptr
+     */
+    std::shared_ptr<const CachedLevel> insert(const LevelConfig& levelConfig);
+    
+    /**
+     * @brief 清空缓存（已取得的关卡仍然有效）
+     */
+    void clear();
+    
+    // ========== 统计 ==========
+    
+    size_t size() const;
+    size_t getCapacity() const { return _capacity; }
+    uint64_t getHitCount() const;
+    uint64_t getMissCount() const;
+
+private:
+    /**
+     * @brief 缓存项，链表头部为最近使用
+     */
+    struct Entry
+    {
+        int levelId;                                ///< 关卡ID，未知为0
+        std::shared_ptr<const CachedLevel> level;   ///< 缓存的关卡，加载失败为空
+    };
+    
+    using EntryList = std::list<Entry>;
+    
+    /**
+     * @brief 编译关卡并生成开局局面
+     * @param levelConfig 关卡配置（所有权转移给结果）
+     * @return 缓存的关卡，配置无效返回nullptr
+     */
+    static std::shared_ptr<const CachedLevel> buildLevel(std::shared_ptr<LevelConfig> levelConfig);
+    
+    /**
+     * @brief 把缓存项移到链表头部（须持有锁）
+     */
+    void touch(EntryList::iterator iter);
+    
+    /**
+     * @brief 添加缓存项并淘汰超出容量的部分（须持有锁）
+     * @return 新缓存项
+     */
+    EntryList::iterator addEntry(int levelId, std::shared_ptr<const CachedLevel> level);
+    
+    size_t _capacity;                                               ///< 容量
+    LoadFunction _loadFunction;                                     ///< 加载函数
+    mutable std::mutex _mutex;                                      ///< 保护以下成员
+    EntryList _entries;                                             ///< 按使用时间排列的缓存项
+    std::unordered_map<int, EntryList::iterator> _entriesById;      ///< 关卡ID索引
+    std::unordered_map<uint32_t, EntryList::iterator> _entriesByHash; ///< 内容哈希索引
+    uint64_t _hitCount;                                             ///< 命中次数
+    uint64_t _missCount;                                            ///< 未命中次数
+};
+
+#endif // __LEVEL_CONFIG_CACHE_H__
@@ -0,0 +1,71 @@
+/**
+ * @file ReplayRecorder.cpp
+ * @brief 对局录像管理器实现
+ */
+
+#include "managers/ReplayRecorder.h"
+#include "services/GameRules.h"
+
+ReplayRecorder::ReplayRecorder()
+{
+}
+
+ReplayRecorder::~ReplayRecorder()
+{
+}
+
+void ReplayRecorder::begin(const LevelConfig& levelConfig)
+{
+    begin(levelConfig.getLevelId(), levelConfig.computeContentHash());
+}
+
+void ReplayRecorder::begin(int levelId, uint32_t levelHash)
+{
+    _replay.clear();
+    _replay.setLevel(levelId, levelHash);
+}
+
+void ReplayRecorder::beginTestLevel()
+{
+    _replay.clear();
+}
+
+void ReplayRecorder::restart()
+{
+    int levelId = _replay.getLevelId();
+    uint32_t levelHash = _replay.getLevelHash();
+    _replay.clear();
+    _replay.setLevel(levelId, levelHash);
+}
+
+void ReplayRecorder::recordPlayfieldToStack(int cardId)
+{
+    _replay.addAction(ReplayAction(GameActionType::PLAYFIELD_TO_STACK, cardId));
+}
+
+void ReplayRecorder::recordReserveToStack()
+{
+    _replay.addAction(ReplayAction(GameActionType::RESERVE_TO_STACK, -1));
+}
+
+void ReplayRecorder::recordUndo()
+{
+    _replay.addAction(ReplayAction(GameActionType::UNDO, -1));
+}
+
+void ReplayRecorder::reserveFor(const GameModel& gameModel)
+{
+    // 不撤销时操作数不超过剩余牌数，再留同样多给回退及其后的重走
+    size_t cardCount = gameModel.getPlayfieldCards().size() + gameModel.getReserveCardCount();
+    _replay.reserveActions(_replay.getActions().size() + cardCount * 2);
+}
+
+void ReplayRecorder::updateResult(const GameModel& gameModel)
+{
+    _replay.setClaimedResult(GameRules::isWin(gameModel), gameModel.computeStateHash());
+}
+
+void ReplayRecorder::resume(const ReplayModel& replay)
+{
+    _replay = replay;
+}
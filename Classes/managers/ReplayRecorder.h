@@ -0,0 +1,106 @@
+/**
+ * @file ReplayRecorder.h
+ * @brief 对局录像管理器
+ * 
+ * 负责在对局过程中记录玩家的每一次有效操作，生成ReplayModel。
+ * 
+ * 作为controller的成员变量使用，可持有model数据。
+ */
+
+#ifndef __REPLAY_RECORDER_H__
+#define __REPLAY_RECORDER_H__
+
+#include "models/ReplayModel.h"
+#include "models/GameModel.h"
+#include "configs/LevelConfig.h"
+
+/**
+ * @brief 对局录像管理器类
+ * 
+ * 只记录已被规则接受的操作，回放时按相同顺序重新执行即可复现对局。
+ * 符合managers层的设计规范：
+ * - 作为controller的成员变量
+ * - 可持有model数据
+ * - 禁止单例模式
+ */
+class ReplayRecorder
+{
+public:
+    /**
+     * @brief 构造函数
+     */
+    ReplayRecorder();
+    
+    /**
+     * @brief 析构函数
+     */
+    ~ReplayRecorder();
+    
+    /**
+     * @brief 开始录制新的对局
+     * @param levelConfig 关卡配置
+     */
+    void begin(const LevelConfig& levelConfig);
+    
+    /**
+     * @brief 按关卡ID和哈希开始录制（从快照恢复而录像缺失时使用）
+     * @param levelId 关卡ID
+     * @param levelHash 关卡内容哈希
+     */
+    void begin(int levelId, uint32_t levelHash);
+    
+    /**
+     * @brief 开始录制测试数据对局（无关卡配置，无法回放校验）
+     */
+    void beginTestLevel();
+    
+    /**
+     * @brief 重玩本关：清空已录制的操作，保留关卡ID和哈希（已预留的容量不释放）
+     */
+    void restart();
+    
+    /**
+     * @brief 记录主牌区到手牌区的移动
+     * @param cardId 卡牌ID
+     */
+    void recordPlayfieldToStack(int cardId);
+    
+    /**
+     * @brief 记录备用牌堆翻牌
+     */
+    void recordReserveToStack();
+    
+    /**
+     * @brief 记录回退
+     */
+    void recordUndo();
+    
+    /**
+     * @brief 按局面规模预留录像容量，避免对局中追加操作时分配内存
+     * @param gameModel 游戏模型
+     */
+    void reserveFor(const GameModel& gameModel);
+    
+    /**
+     * @brief 用当前局面更新声明的终局结果
+     * @param gameModel 游戏模型
+     */
+    void updateResult(const GameModel& gameModel);
+    
+    /**
+     * @brief 获取录像数据
+     * @return 录像模型的只读引用
+     */
+    const ReplayModel& getReplay() const { return _replay; }
+    
+    /**
+     * @brief 用已有录像继续录制（从存档恢复对局时使用）
+     * @param replay 录像模型
+     */
+    void resume(const ReplayModel& replay);
+
+private:
+    ReplayModel _replay;    ///< 正在录制的录像
+};
+
+#endif // __REPLAY_RECORDER_H__
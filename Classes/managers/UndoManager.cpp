@@ -28,7 +28,6 @@ void UndoManager::recordAction(const UndoModel& undoModel)
     if (undoModel.isValid())
     {
         _undoStack.push_back(undoModel);
-        CCLOG("UndoManager: Recorded action, stack size: %zu", _undoStack.size());
     }
 }
 
@@ -69,19 +68,9 @@ bool UndoManager::undo()
     _undoStack.pop_back();
     
     // 根据操作类型执行撤销
-    switch (undoModel.getOperationType())
+    if (!applyUndoModel(_gameModel, undoModel))
     {
-        case CardOperationType::PLAYFIELD_TO_STACK:
-            undoPlayfieldToStack(undoModel);
-            break;
-            
-        case CardOperationType::RESERVE_TO_STACK:
-            undoReserveToStack(undoModel);
-            break;
-            
-        default:
-            CCLOG("UndoManager: Unknown operation type");
-            return false;
+        return false;
     }
     
     // 通知回调执行视图更新
@@ -89,11 +78,17 @@ bool UndoManager::undo()
     {
         _undoExecuteCallback(undoModel);
     }
-    
-    CCLOG("UndoManager: Undo executed, remaining stack size: %zu", _undoStack.size());
     return true;
 }
 
+void UndoManager::rewind(GameModel& gameModel) const
+{
+    for (auto it = _undoStack.rbegin(); it != _undoStack.rend(); ++it)
+    {
+        applyUndoModel(&gameModel, *it);
+    }
+}
+
 bool UndoManager::canUndo() const
 {
     return !_undoStack.empty();
@@ -104,14 +99,74 @@ void UndoManager::clearUndoStack()
     _undoStack.clear();
 }
 
+void UndoManager::setArena(LevelArena* arena)
+{
+    _undoStack = ArenaVector<UndoModel>(ArenaAllocator<UndoModel>(arena));
+}
+
+void UndoManager::serializeBinary(BinaryWriter& writer) const
+{
+    writer.writeU32(static_cast<uint32_t>(_undoStack.size()));
+    
+    uint8_t* out = writer.append(_undoStack.size() * UndoModel::kBinaryRecordSize);
+    for (const auto& undoModel : _undoStack)
+    {
+        undoModel.writeBinary(out);
+        out += UndoModel::kBinaryRecordSize;
+    }
+}
+
+bool UndoManager::deserializeBinary(BinaryReader& reader)
+{
+    uint32_t undoCount = 0;
+    if (!reader.readU32(undoCount))
+    {
+        return false;
+    }
+    
+    if (reader.remaining() / UndoModel::kBinaryRecordSize < undoCount)
+    {
+        return false;
+    }
+    const uint8_t* in = reader.consume(undoCount * UndoModel::kBinaryRecordSize);
+    
+    _undoStack.resize(undoCount);
+    for (auto& undoModel : _undoStack)
+    {
+        undoModel.readBinary(in);
+        in += UndoModel::kBinaryRecordSize;
+    }
+    
+    CCLOG("UndoManager: Restored undo stack, size: %zu", _undoStack.size());
+    return true;
+}
+
 void UndoManager::setUndoExecuteCallback(const UndoExecuteCallback& callback)
 {
     _undoExecuteCallback = callback;
 }
 
-void UndoManager::undoPlayfieldToStack(const UndoModel& undoModel)
+bool UndoManager::applyUndoModel(GameModel* gameModel, const UndoModel& undoModel)
 {
-    if (!_gameModel)
+    switch (undoModel.getOperationType())
+    {
+        case CardOperationType::PLAYFIELD_TO_STACK:
+            undoPlayfieldToStack(gameModel, undoModel);
+            return true;
+            
+        case CardOperationType::RESERVE_TO_STACK:
+            undoReserveToStack(gameModel, undoModel);
+            return true;
+            
+        default:
+            CCLOG("UndoManager: Unknown operation type");
+            return false;
+    }
+}
+
+void UndoManager::undoPlayfieldToStack(GameModel* gameModel, const UndoModel& undoModel)
+{
+    if (!gameModel)
     {
         return;
     }
@@ -125,17 +180,15 @@ void UndoManager::undoPlayfieldToStack(const UndoModel& undoModel)
     cardToRestore.setPosition(undoModel.getOriginalPosition());
     cardToRestore.setFaceUp(true);
     cardToRestore.setClickable(true);
-    _gameModel->addPlayfieldCard(cardToRestore);
+    gameModel->addPlayfieldCard(cardToRestore);
     
     // 2. 恢复原来的顶部牌
-    _gameModel->setStackTopCard(previousTopCard);
-    
-    CCLOG("UndoManager: Undone PLAYFIELD_TO_STACK for card %d", movedCard.getCardId());
+    gameModel->setStackTopCard(previousTopCard);
 }
 
-void UndoManager::undoReserveToStack(const UndoModel& undoModel)
+void UndoManager::undoReserveToStack(GameModel* gameModel, const UndoModel& undoModel)
 {
-    if (!_gameModel)
+    if (!gameModel)
     {
         return;
     }
@@ -148,10 +201,8 @@ void UndoManager::undoReserveToStack(const UndoModel& undoModel)
     cardToRestore.setArea(CardAreaType::RESERVE);
     cardToRestore.setFaceUp(false);
     cardToRestore.setClickable(false);
-    _gameModel->pushReserveCard(cardToRestore);
+    gameModel->pushReserveCard(cardToRestore);
     
     // 2. 恢复原来的顶部牌
-    _gameModel->setStackTopCard(previousTopCard);
-    
-    CCLOG("UndoManager: Undone RESERVE_TO_STACK for card %d", drawnCard.getCardId());
+    gameModel->setStackTopCard(previousTopCard);
 }
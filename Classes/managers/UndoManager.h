@@ -15,7 +15,7 @@
 
 #include "models/UndoModel.h"
 #include "models/GameModel.h"
-#include <vector>
+#include "utils/LevelArena.h"
 #include <functional>
 
 /**
@@ -88,6 +88,12 @@ public:
      */
     bool undo();
     
+    /**
+     * @brief 在指定模型上按逆序退回全部记录（不修改撤销栈，不通知回调）
+     * @param gameModel 当前局面的副本，退回后为开局局面（可点击状态需另行更新）
+     */
+    void rewind(GameModel& gameModel) const;
+    
     /**
      * @brief 检查是否可以撤销
      * @return 可以撤销返回true
@@ -100,6 +106,28 @@ public:
      */
     size_t getUndoStackSize() const { return _undoStack.size(); }
     
+    /**
+     * @brief 预留撤销栈容量
+     * @param capacity 预计的最大撤销深度
+     * 
+     * 每张牌最多离开原位置一次，开局时按主牌区与备用牌堆的牌数预留，
+     * 之后整局记录撤销都不再分配内存
+     */
+    void reserve(size_t capacity) { _undoStack.reserve(capacity); }
+    
+    /**
+     * @brief 清空并释放撤销栈，之后的空间从指定内存池分配
+     * @param arena 关卡内存池，nullptr为全局堆
+     */
+    void setArena(LevelArena* arena);
+    
+    /**
+     * @brief 预留指定撤销深度所需的内存池字节数
+     * @param capacity 撤销深度
+     * @return 字节数
+     */
+    static size_t getArenaBytes(size_t capacity) { return LevelArena::alignedSize(capacity * sizeof(UndoModel)); }
+    
     // ========== 清理方法 ==========
     
     /**
@@ -107,6 +135,23 @@ public:
      */
     void clearUndoStack();
     
+    // ========== 存档方法 ==========
+    
+    /**
+     * @brief 将撤销栈序列化为定长二进制记录
+     * @param writer 二进制写入器
+     * 
+     * 布局：undoCount(u32) 撤销记录...（栈底在前）
+     */
+    void serializeBinary(BinaryWriter& writer) const;
+    
+    /**
+     * @brief 从二进制记录恢复撤销栈
+     * @param reader 二进制读取器
+     * @return 是否成功，失败时撤销栈保持不变
+     */
+    bool deserializeBinary(BinaryReader& reader);
+    
     // ========== 回调设置 ==========
     
     /**
@@ -116,21 +161,31 @@ public:
     void setUndoExecuteCallback(const UndoExecuteCallback& callback);
 
 private:
+    /**
+     * @brief 按操作类型执行一条撤销记录
+     * @param gameModel 游戏数据模型
+     * @param undoModel 撤销数据
+     * @return 操作类型未知时返回false
+     */
+    static bool applyUndoModel(GameModel* gameModel, const UndoModel& undoModel);
+    
     /**
      * @brief 执行主牌区到手牌区的撤销
+     * @param gameModel 游戏数据模型
      * @param undoModel 撤销数据
      */
-    void undoPlayfieldToStack(const UndoModel& undoModel);
+    static void undoPlayfieldToStack(GameModel* gameModel, const UndoModel& undoModel);
     
     /**
      * @brief 执行备用牌堆到手牌区的撤销
+     * @param gameModel 游戏数据模型
      * @param undoModel 撤销数据
      */
-    void undoReserveToStack(const UndoModel& undoModel);
+    static void undoReserveToStack(GameModel* gameModel, const UndoModel& undoModel);
 
 private:
     GameModel* _gameModel;                      // 游戏数据模型指针
-    std::vector<UndoModel> _undoStack;          // 撤销栈
+    ArenaVector<UndoModel> _undoStack;          // 撤销栈
     UndoExecuteCallback _undoExecuteCallback;   // 撤销执行回调
 };
 
@@ -5,49 +5,94 @@
 
 #include "models/CardModel.h"
 #include "utils/CardUtils.h"
+#include "utils/BinaryStream.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    const uint8_t kBinaryFlagFaceUp = 1 << 0;
+    const uint8_t kBinaryFlagClickable = 1 << 1;
+}
+
+// 模型按值大量复制，保持紧凑
+static_assert(sizeof(CardModel) == 8, "CardModel must stay 8 bytes");
+
+const size_t CardModel::kBinaryRecordSize;
+const int CardModel::kMaxCardId;
+const int CardModel::kMinCoordinate;
+const int CardModel::kMaxCoordinate;
 
 CardModel::CardModel()
-    : _cardId(-1)
-    , _suit(CardSuitType::NONE)
-    , _face(CardFaceType::NONE)
-    , _position(cocos2d::Vec2::ZERO)
-    , _area(CardAreaType::NONE)
-    , _isFaceUp(false)
-    , _isClickable(false)
+    : _cardId(kInvalidId)
+    , _x(0)
+    , _y(0)
+    , _identity(encodeIdentity(CardSuitType::NONE, CardFaceType::NONE))
+    , _flags(0)
 {
+    setArea(CardAreaType::NONE);
 }
 
 CardModel::CardModel(int cardId, CardSuitType suit, CardFaceType face)
-    : _cardId(cardId)
-    , _suit(suit)
-    , _face(face)
-    , _position(cocos2d::Vec2::ZERO)
-    , _area(CardAreaType::NONE)
-    , _isFaceUp(false)
-    , _isClickable(false)
+    : _cardId(kInvalidId)
+    , _x(0)
+    , _y(0)
+    , _identity(encodeIdentity(suit, face))
+    , _flags(0)
 {
+    setCardId(cardId);
+    setArea(CardAreaType::NONE);
 }
 
 CardModel::~CardModel()
 {
 }
 
+void CardModel::setCardId(int cardId)
+{
+    if (cardId < 0 || cardId > kMaxCardId)
+    {
+        if (cardId >= 0)
+        {
+            CCLOG("CardModel: Card id %d exceeds %d, stored as invalid", cardId, kMaxCardId);
+        }
+        _cardId = kInvalidId;
+        return;
+    }
+    _cardId = static_cast<uint16_t>(cardId);
+}
+
+int16_t CardModel::toCoordinate(float value)
+{
+    long rounded = std::lround(value);
+    rounded = std::max<long>(kMinCoordinate, std::min<long>(kMaxCoordinate, rounded));
+    return static_cast<int16_t>(rounded);
+}
+
+void CardModel::setPosition(const cocos2d::Vec2& position)
+{
+    _x = toCoordinate(position.x);
+    _y = toCoordinate(position.y);
+}
+
 rapidjson::Value CardModel::serialize(rapidjson::Document::AllocatorType& allocator) const
 {
     rapidjson::Value json(rapidjson::kObjectType);
     
-    json.AddMember("cardId", _cardId, allocator);
-    json.AddMember("suit", static_cast<int>(_suit), allocator);
-    json.AddMember("face", static_cast<int>(_face), allocator);
+    json.AddMember("cardId", getCardId(), allocator);
+    json.AddMember("suit", static_cast<int>(getSuit()), allocator);
+    json.AddMember("face", static_cast<int>(getFace()), allocator);
     
+    // 存档格式保持浮点坐标
     rapidjson::Value posObj(rapidjson::kObjectType);
-    posObj.AddMember("x", _position.x, allocator);
-    posObj.AddMember("y", _position.y, allocator);
+    posObj.AddMember("x", static_cast<float>(_x), allocator);
+    posObj.AddMember("y", static_cast<float>(_y), allocator);
     json.AddMember("position", posObj, allocator);
     
-    json.AddMember("area", static_cast<int>(_area), allocator);
-    json.AddMember("isFaceUp", _isFaceUp, allocator);
-    json.AddMember("isClickable", _isClickable, allocator);
+    json.AddMember("area", static_cast<int>(getArea()), allocator);
+    json.AddMember("isFaceUp", isFaceUp(), allocator);
+    json.AddMember("isClickable", isClickable(), allocator);
     
     return json;
 }
@@ -61,17 +106,17 @@ bool CardModel::deserialize(const rapidjson::Value& json)
     
     if (json.HasMember("cardId") && json["cardId"].IsInt())
     {
-        _cardId = json["cardId"].GetInt();
+        setCardId(json["cardId"].GetInt());
     }
     
     if (json.HasMember("suit") && json["suit"].IsInt())
     {
-        _suit = static_cast<CardSuitType>(json["suit"].GetInt());
+        setSuit(static_cast<CardSuitType>(json["suit"].GetInt()));
     }
     
     if (json.HasMember("face") && json["face"].IsInt())
     {
-        _face = static_cast<CardFaceType>(json["face"].GetInt());
+        setFace(static_cast<CardFaceType>(json["face"].GetInt()));
     }
     
     if (json.HasMember("position") && json["position"].IsObject())
@@ -79,43 +124,52 @@ bool CardModel::deserialize(const rapidjson::Value& json)
         const auto& posObj = json["position"];
         if (posObj.HasMember("x") && posObj.HasMember("y"))
         {
-            _position.x = posObj["x"].GetFloat();
-            _position.y = posObj["y"].GetFloat();
+            setPosition(cocos2d::Vec2(posObj["x"].GetFloat(), posObj["y"].GetFloat()));
         }
     }
     
     if (json.HasMember("area") && json["area"].IsInt())
     {
-        _area = static_cast<CardAreaType>(json["area"].GetInt());
+        setArea(static_cast<CardAreaType>(json["area"].GetInt()));
     }
     
     if (json.HasMember("isFaceUp") && json["isFaceUp"].IsBool())
     {
-        _isFaceUp = json["isFaceUp"].GetBool();
+        setFaceUp(json["isFaceUp"].GetBool());
     }
     
     if (json.HasMember("isClickable") && json["isClickable"].IsBool())
     {
-        _isClickable = json["isClickable"].GetBool();
+        setClickable(json["isClickable"].GetBool());
     }
     
     return true;
 }
 
-bool CardModel::canMatchWith(const CardModel& other) const
+void CardModel::writeBinary(uint8_t* out) const
+{
+    BinaryUtils::storeU32(out, static_cast<uint32_t>(getCardId()));
+    out[4] = static_cast<uint8_t>(static_cast<int8_t>(getSuit()));
+    out[5] = static_cast<uint8_t>(static_cast<int8_t>(getFace()));
+    out[6] = static_cast<uint8_t>(getArea());
+    out[7] = (isFaceUp() ? kBinaryFlagFaceUp : 0) | (isClickable() ? kBinaryFlagClickable : 0);
+    BinaryUtils::storeF32(out + 8, static_cast<float>(_x));
+    BinaryUtils::storeF32(out + 12, static_cast<float>(_y));
+}
+
+void CardModel::readBinary(const uint8_t* in)
 {
-    return CardUtils::canMatch(_face, other._face);
+    setCardId(static_cast<int>(BinaryUtils::loadU32(in)));
+    _identity = encodeIdentity(static_cast<CardSuitType>(static_cast<int8_t>(in[4])),
+                               static_cast<CardFaceType>(static_cast<int8_t>(in[5])));
+    _flags = 0;
+    setArea(static_cast<CardAreaType>(in[6]));
+    setFaceUp((in[7] & kBinaryFlagFaceUp) != 0);
+    setClickable((in[7] & kBinaryFlagClickable) != 0);
+    setPosition(cocos2d::Vec2(BinaryUtils::loadF32(in + 8), BinaryUtils::loadF32(in + 12)));
 }
 
 CardModel CardModel::clone() const
 {
-    CardModel copy;
-    copy._cardId = _cardId;
-    copy._suit = _suit;
-    copy._face = _face;
-    copy._position = _position;
-    copy._area = _area;
-    copy._isFaceUp = _isFaceUp;
-    copy._isClickable = _isClickable;
-    return copy;
+    return *this;
 }
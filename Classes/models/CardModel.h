@@ -4,6 +4,11 @@
  * 
  * 表示单张卡牌的数据结构，包含花色、点数、位置等信息。
  * 支持序列化和反序列化以实现存档功能。
+ * 
+ * 卡牌在模型、回退记录和求解器中按值大量复制，因此紧凑存储为8字节：
+ * ID(u16) x(i16) y(i16) 点数花色(u8) 标志位(u8)。
+ * 位置是以设计分辨率像素为单位的定点整数，只在视图边界转换为Vec2，
+ * 重叠判断因此是精确的整数比较，在所有平台上结果一致。
  */
 
 #ifndef __CARD_MODEL_H__
@@ -13,6 +18,7 @@
 #include "cocos2d.h"
 #include "json/document.h"
 #include <utils/CardUtils.h>
+#include <cstdint>
 
 /**
  * @brief 卡牌数据模型类
@@ -23,6 +29,13 @@
 class CardModel
 {
 public:
+    /// 卡牌ID上限（ID以16位存储，全1表示无效ID -1）
+    static const int kMaxCardId = 0xFFFE;
+    
+    /// 位置坐标范围（以16位有符号整数存储）
+    static const int kMinCoordinate = -32768;
+    static const int kMaxCoordinate = 32767;
+    
     /**
      * @brief 默认构造函数
      */
@@ -47,49 +60,61 @@ public:
      * @brief 获取卡牌ID
      * @return 卡牌唯一标识
      */
-    int getCardId() const { return _cardId; }
+    int getCardId() const { return _cardId == kInvalidId ? -1 : static_cast<int>(_cardId); }
     
     /**
      * @brief 获取花色
      * @return 花色类型
      */
-    CardSuitType getSuit() const { return _suit; }
+    CardSuitType getSuit() const { return decodeSuit(_identity); }
     
     /**
      * @brief 获取点数
      * @return 点数类型
      */
-    CardFaceType getFace() const { return _face; }
+    CardFaceType getFace() const { return decodeFace(_identity); }
     
     /**
      * @brief 获取位置
-     * @return 卡牌在场景中的位置
+     * @return 卡牌在场景中的位置（视图使用）
+     */
+    cocos2d::Vec2 getPosition() const { return cocos2d::Vec2(_x, _y); }
+    
+    /**
+     * @brief 获取位置的x坐标（定点整数）
+     * @return x坐标，单位为设计分辨率像素
+     */
+    int getX() const { return _x; }
+    
+    /**
+     * @brief 获取位置的y坐标（定点整数）
+     * @return y坐标，单位为设计分辨率像素
      */
-    cocos2d::Vec2 getPosition() const { return _position; }
+    int getY() const { return _y; }
     
     /**
      * @brief 获取卡牌所在区域
      * @return 区域类型
      */
-    CardAreaType getArea() const { return _area; }
+    CardAreaType getArea() const { return static_cast<CardAreaType>((_flags & kFlagAreaMask) >> kFlagAreaShift); }
     
     /**
      * @brief 是否正面朝上
      * @return true表示正面朝上
      */
-    bool isFaceUp() const { return _isFaceUp; }
+    bool isFaceUp() const { return (_flags & kFlagFaceUp) != 0; }
     
     /**
      * @brief 是否可以被点击
      * @return true表示可以点击
      */
-    bool isClickable() const { return _isClickable; }
+    bool isClickable() const { return (_flags & kFlagClickable) != 0; }
     
     /**
      * @brief 是否是红色花色（红桃或方块）
      * @return true表示红色
      */
-    bool isRed() const { return CardUtils::isRedSuit(_suit); }
+    bool isRed() const { return CardUtils::isRedSuit(getSuit()); }
     
     // ========== Setter方法 ==========
     
@@ -97,43 +122,53 @@ public:
      * @brief 设置卡牌ID
      * @param cardId 卡牌唯一标识
      */
-    void setCardId(int cardId) { _cardId = cardId; }
+    void setCardId(int cardId);
     
     /**
      * @brief 设置花色
      * @param suit 花色类型
      */
-    void setSuit(CardSuitType suit) { _suit = suit; }
+    void setSuit(CardSuitType suit) { _identity = encodeIdentity(suit, getFace()); }
     
     /**
      * @brief 设置点数
      * @param face 点数类型
      */
-    void setFace(CardFaceType face) { _face = face; }
+    void setFace(CardFaceType face) { _identity = encodeIdentity(getSuit(), face); }
     
     /**
      * @brief 设置位置
-     * @param position 场景中的位置
+     * @param position 场景中的位置，四舍五入到整数像素，超出范围时截断
+     */
+    void setPosition(const cocos2d::Vec2& position);
+    
+    /**
+     * @brief 把场景坐标转换为模型使用的定点整数坐标
+     * @param value 坐标（设计分辨率像素）
+     * @return 四舍五入后的坐标，超出[kMinCoordinate, kMaxCoordinate]时截断（在模型热路径上调用，不输出日志）
      */
-    void setPosition(const cocos2d::Vec2& position) { _position = position; }
+    static int16_t toCoordinate(float value);
     
     /**
      * @brief 设置所在区域
      * @param area 区域类型
      */
-    void setArea(CardAreaType area) { _area = area; }
+    void setArea(CardAreaType area)
+    {
+        _flags = static_cast<uint8_t>((_flags & ~kFlagAreaMask) | (static_cast<uint8_t>(area) << kFlagAreaShift));
+    }
     
     /**
      * @brief 设置是否正面朝上
      * @param faceUp true表示正面朝上
      */
-    void setFaceUp(bool faceUp) { _isFaceUp = faceUp; }
+    void setFaceUp(bool faceUp) { setFlag(kFlagFaceUp, faceUp); }
     
     /**
      * @brief 设置是否可点击
      * @param clickable true表示可以点击
      */
-    void setClickable(bool clickable) { _isClickable = clickable; }
+    void setClickable(bool clickable) { setFlag(kFlagClickable, clickable); }
     
     // ========== 序列化方法 ==========
     
@@ -151,14 +186,42 @@ public:
      */
     bool deserialize(const rapidjson::Value& json);
     
+    /// 二进制记录的固定长度（字节）
+    static const size_t kBinaryRecordSize = 16;
+    
+    /**
+     * @brief 写入定长二进制记录（小端序）
+     * @param out 输出地址，至少kBinaryRecordSize字节
+     * 
+     * 布局：cardId(i32) suit(i8) face(i8) area(u8) flags(u8) x(f32) y(f32)
+     */
+    void writeBinary(uint8_t* out) const;
+    
+    /**
+     * @brief 从定长二进制记录读取
+     * @param in 输入地址，至少kBinaryRecordSize字节
+     */
+    void readBinary(const uint8_t* in);
+    
     // ========== 工具方法 ==========
     
+    /**
+     * @brief 获取匹配下标（花色和点数的组合，用于查匹配表）
+     * @return 匹配下标，花色或点数无效时为MatchRules::kNoneIndex
+     */
+    int getMatchIndex() const { return MatchRules::toIndex(getSuit(), getFace()); }
+    
     /**
      * @brief 判断是否可以与另一张牌匹配
+     * @tparam Rule 匹配规则，默认为游戏规则
      * @param other 另一张卡牌
      * @return 可以匹配返回true
      */
-    bool canMatchWith(const CardModel& other) const;
+    template <typename Rule = MatchRules::Default>
+    bool canMatchWith(const CardModel& other) const
+    {
+        return MatchRules::Table<Rule>::matches(getMatchIndex(), other.getMatchIndex());
+    }
     
     /**
      * @brief 复制卡牌数据
@@ -167,13 +230,48 @@ public:
     CardModel clone() const;
 
 private:
-    int _cardId;                ///< 卡牌唯一标识
-    CardSuitType _suit;         ///< 花色
-    CardFaceType _face;         ///< 点数
-    cocos2d::Vec2 _position;    ///< 位置
-    CardAreaType _area;         ///< 所在区域
-    bool _isFaceUp;             ///< 是否正面朝上
-    bool _isClickable;          ///< 是否可点击
+    // ========== 位域编码 ==========
+    
+    static const uint16_t kInvalidId = 0xFFFF;      ///< 无效ID（-1）
+    static const uint8_t kNoneNibble = 0x0F;        ///< NONE花色或点数的编码
+    static const uint8_t kFlagFaceUp = 1 << 0;      ///< 正面朝上
+    static const uint8_t kFlagClickable = 1 << 1;   ///< 可点击
+    static const uint8_t kFlagAreaShift = 2;        ///< 区域所在位
+    static const uint8_t kFlagAreaMask = 0x03 << kFlagAreaShift;
+    
+    /**
+     * @brief 点数放低4位，花色放高4位，NONE编码为0xF
+     */
+    static uint8_t encodeIdentity(CardSuitType suit, CardFaceType face)
+    {
+        uint8_t suitBits = suit == CardSuitType::NONE ? kNoneNibble : static_cast<uint8_t>(suit);
+        uint8_t faceBits = face == CardFaceType::NONE ? kNoneNibble : static_cast<uint8_t>(face);
+        return static_cast<uint8_t>((suitBits << 4) | faceBits);
+    }
+    
+    static CardSuitType decodeSuit(uint8_t identity)
+    {
+        uint8_t bits = identity >> 4;
+        return bits == kNoneNibble ? CardSuitType::NONE : static_cast<CardSuitType>(bits);
+    }
+    
+    static CardFaceType decodeFace(uint8_t identity)
+    {
+        uint8_t bits = identity & kNoneNibble;
+        return bits == kNoneNibble ? CardFaceType::NONE : static_cast<CardFaceType>(bits);
+    }
+    
+    void setFlag(uint8_t flag, bool value)
+    {
+        _flags = static_cast<uint8_t>(value ? (_flags | flag) : (_flags & ~flag));
+    }
+
+private:
+    uint16_t _cardId;           ///< 卡牌唯一标识（kInvalidId表示-1）
+    int16_t _x;                 ///< 位置x（设计分辨率像素）
+    int16_t _y;                 ///< 位置y（设计分辨率像素）
+    uint8_t _identity;          ///< 点数（低4位）与花色（高4位）
+    uint8_t _flags;             ///< 正面朝上、可点击、所在区域
 };
 
 #endif // __CARD_MODEL_H__
@@ -5,10 +5,13 @@
 
 #include "models/GameModel.h"
 #include <algorithm>
+#include <iterator>
 
 GameModel::GameModel()
     : _nextCardId(0)
+    , _clickableMatchMask(0)
 {
+    std::fill(std::begin(_clickableMatchCounts), std::end(_clickableMatchCounts), 0);
 }
 
 GameModel::~GameModel()
@@ -17,36 +20,157 @@ GameModel::~GameModel()
 
 void GameModel::addPlayfieldCard(const CardModel& card)
 {
-    _playfieldCards.push_back(card);
+    int cardId = card.getCardId();
+    if (_playfieldCards.findSlot(cardId) >= 0)
+    {
+        CCLOG("GameModel: Card %d is already on the playfield, replaced", cardId);
+        removePlayfieldCard(cardId);
+    }
+    
+    // 回退时卡牌回到原槽位，遍历顺序保持不变
+    size_t slot = _playfieldCards.insert(card);
+    adjustClickableMatchCount(slot, 1);
+    
+    // 已关联预编译数据时，卡牌自身的可点击状态以遮挡计数为准
+    if (_compiledPlayfield && cardId >= 0 && cardId < static_cast<int>(_blockerCounts.size()))
+    {
+        setPlayfieldCardClickable(slot, _blockerCounts[cardId] == 0);
+    }
+    adjustCompiledBlockers(cardId, 1);
 }
 
 bool GameModel::removePlayfieldCard(int cardId)
 {
-    auto it = std::find_if(_playfieldCards.begin(), _playfieldCards.end(),
-        [cardId](const CardModel& card) {
-            return card.getCardId() == cardId;
-        });
-    
-    if (it != _playfieldCards.end())
+    int slot = _playfieldCards.findSlot(cardId);
+    if (slot >= 0)
     {
-        _playfieldCards.erase(it);
+        adjustClickableMatchCount(slot, -1);
+        _playfieldCards.remove(slot);
+        adjustCompiledBlockers(cardId, -1);
         return true;
     }
     return false;
 }
 
-CardModel* GameModel::getPlayfieldCardById(int cardId)
+void GameModel::setPlayfieldCardClickable(size_t slot, bool clickable)
 {
-    auto it = std::find_if(_playfieldCards.begin(), _playfieldCards.end(),
-        [cardId](const CardModel& card) {
-            return card.getCardId() == cardId;
-        });
+    if (slot >= _playfieldCards.slotCount() || !_playfieldCards.isOccupied(slot))
+    {
+        return;
+    }
+    
+    if (_playfieldCards.isClickable(slot) == clickable)
+    {
+        return;
+    }
+    
+    adjustClickableMatchCount(slot, -1);
+    _playfieldCards.setClickable(slot, clickable);
+    adjustClickableMatchCount(slot, 1);
+}
+
+bool GameModel::setCompiledPlayfield(std::shared_ptr<const CompiledPlayfield> compiledPlayfield)
+{
+    // 要求槽位与卡牌ID一一对应且没有空槽位
+    if (!compiledPlayfield || compiledPlayfield->size() != _playfieldCards.size()
+        || _playfieldCards.slotCount() != _playfieldCards.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < _playfieldCards.slotCount(); i++)
+    {
+        if (_playfieldCards.getCardId(i) != static_cast<int>(i))
+        {
+            return false;
+        }
+    }
+    
+    _compiledPlayfield = std::move(compiledPlayfield);
+    _blockerCounts.resize(_playfieldCards.size());
+    for (size_t i = 0; i < _playfieldCards.size(); i++)
+    {
+        const CompiledCardData& compiled = (*_compiledPlayfield)[i];
+        _blockerCounts[i] = static_cast<int>(compiled.blockers.size());
+        setPlayfieldCardClickable(i, compiled.isClickable);
+    }
+    return true;
+}
+
+int GameModel::getPlayfieldZOrder(int cardId) const
+{
+    if (_compiledPlayfield && cardId >= 0 && cardId < static_cast<int>(_compiledPlayfield->size()))
+    {
+        return (*_compiledPlayfield)[cardId].zOrder;
+    }
+    return cardId;
+}
+
+void GameModel::adjustClickableMatchCount(size_t slot, int delta)
+{
+    if (!_playfieldCards.isClickable(slot))
+    {
+        return;
+    }
+    
+    int index = _playfieldCards.getMatchIndex(slot);
+    int& count = _clickableMatchCounts[index];
+    count += delta;
+    if (count > 0)
+    {
+        _clickableMatchMask |= 1ull << index;
+    }
+    else
+    {
+        _clickableMatchMask &= ~(1ull << index);
+    }
+}
+
+void GameModel::rebuildClickableMatchCounts()
+{
+    std::fill(std::begin(_clickableMatchCounts), std::end(_clickableMatchCounts), 0);
+    _clickableMatchMask = 0;
+    for (size_t slot = 0; slot < _playfieldCards.slotCount(); slot++)
+    {
+        if (_playfieldCards.isOccupied(slot))
+        {
+            adjustClickableMatchCount(slot, 1);
+        }
+    }
+}
+
+void GameModel::adjustCompiledBlockers(int cardId, int delta)
+{
+    if (!_compiledPlayfield || cardId < 0 || cardId >= static_cast<int>(_compiledPlayfield->size()))
+    {
+        return;
+    }
     
-    if (it != _playfieldCards.end())
+    for (int covered : (*_compiledPlayfield)[cardId].covers)
     {
-        return &(*it);
+        int& count = _blockerCounts[covered];
+        count += delta;
+        
+        // 只有遮挡计数在0和非0之间变化时才影响可点击状态
+        if (count == 0 || (delta > 0 && count == 1))
+        {
+            int slot = _playfieldCards.findSlot(covered);
+            if (slot >= 0)
+            {
+                setPlayfieldCardClickable(slot, count == 0);
+            }
+        }
     }
-    return nullptr;
+}
+
+bool GameModel::getPlayfieldCardById(int cardId, CardModel& outCard) const
+{
+    int slot = _playfieldCards.findSlot(cardId);
+    if (slot < 0)
+    {
+        return false;
+    }
+    outCard = _playfieldCards.getCard(slot);
+    return true;
 }
 
 void GameModel::setStackTopCard(const CardModel& card)
@@ -77,19 +201,19 @@ void GameModel::pushReserveCard(const CardModel& card)
     _reserveCards.push_back(card);
 }
 
-CardModel* GameModel::findCardById(int cardId)
+bool GameModel::findCardById(int cardId, CardModel& outCard) const
 {
     // 先在主牌区查找
-    CardModel* card = getPlayfieldCardById(cardId);
-    if (card)
+    if (getPlayfieldCardById(cardId, outCard))
     {
-        return card;
+        return true;
     }
     
     // 检查手牌区顶部牌
     if (_stackTopCard.getCardId() == cardId)
     {
-        return &_stackTopCard;
+        outCard = _stackTopCard;
+        return true;
     }
     
     // 在备用牌堆查找
@@ -100,25 +224,93 @@ CardModel* GameModel::findCardById(int cardId)
     
     if (it != _reserveCards.end())
     {
-        return &(*it);
+        outCard = *it;
+        return true;
     }
     
-    return nullptr;
+    return false;
 }
 
 void GameModel::clear()
 {
-    _playfieldCards.clear();
+    clearPlayfield();
     _stackTopCard = CardModel();
     _reserveCards.clear();
     _nextCardId = 0;
 }
 
+void GameModel::clearPlayfield()
+{
+    _playfieldCards.clear();
+    std::fill(std::begin(_clickableMatchCounts), std::end(_clickableMatchCounts), 0);
+    _clickableMatchMask = 0;
+    _compiledPlayfield.reset();
+    _blockerCounts.clear();
+}
+
+void GameModel::setArena(LevelArena* arena)
+{
+    clear();
+    _playfieldCards.setArena(arena);
+    _reserveCards = ArenaVector<CardModel>(ArenaAllocator<CardModel>(arena));
+    _blockerCounts = ArenaVector<int>(ArenaAllocator<int>(arena));
+}
+
+void GameModel::reserve(size_t playfieldCount, size_t reserveCount)
+{
+    _playfieldCards.reserve(playfieldCount);
+    _reserveCards.reserve(reserveCount);
+    _blockerCounts.reserve(playfieldCount);
+}
+
+size_t GameModel::getArenaBytes(size_t playfieldCount, size_t reserveCount)
+{
+    return PlayfieldCardArray::getArenaBytes(playfieldCount)
+        + LevelArena::alignedSize(reserveCount * sizeof(CardModel))
+        + LevelArena::alignedSize(playfieldCount * sizeof(int));
+}
+
 int GameModel::getNextCardId()
 {
     return _nextCardId++;
 }
 
+namespace
+{
+    /// 32位整数混合函数，使求和组合后的结果分布均匀
+    inline uint32_t mixHash(uint32_t value)
+    {
+        value ^= value >> 16;
+        value *= 0x7feb352du;
+        value ^= value >> 15;
+        value *= 0x846ca68bu;
+        value ^= value >> 16;
+        return value;
+    }
+}
+
+uint32_t GameModel::computeStateHash() const
+{
+    // 快照恢复后槽位会重新紧凑排列，因此用求和组合保证与顺序无关
+    uint32_t playfieldHash = 0;
+    for (size_t slot = 0; slot < _playfieldCards.slotCount(); slot++)
+    {
+        if (_playfieldCards.isOccupied(slot))
+        {
+            playfieldHash += mixHash(static_cast<uint32_t>(_playfieldCards.getCardId(slot)) * 2654435761u);
+        }
+    }
+    
+    // 非零初始值，避免空局面的哈希恰好为0
+    uint32_t hash = mixHash(0x9E3779B9u ^ playfieldHash ^ static_cast<uint32_t>(_playfieldCards.size()));
+    hash = mixHash(hash ^ static_cast<uint32_t>(_stackTopCard.getCardId()));
+    for (const auto& card : _reserveCards)
+    {
+        hash = mixHash(hash ^ static_cast<uint32_t>(card.getCardId()));
+    }
+    return hash;
+}
+
 rapidjson::Value GameModel::serialize(rapidjson::Document::AllocatorType& allocator) const
 {
     rapidjson::Value json(rapidjson::kObjectType);
@@ -165,7 +357,7 @@ bool GameModel::deserialize(const rapidjson::Value& json)
             CardModel card;
             if (card.deserialize(playfieldArray[i]))
             {
-                _playfieldCards.push_back(card);
+                addPlayfieldCard(card);
             }
         }
     }
@@ -197,3 +389,77 @@ bool GameModel::deserialize(const rapidjson::Value& json)
     
     return true;
 }
+
+void GameModel::serializeBinary(BinaryWriter& writer) const
+{
+    writer.writeU32(static_cast<uint32_t>(_playfieldCards.size()));
+    writer.writeU32(static_cast<uint32_t>(_reserveCards.size()));
+    writer.writeI32(_nextCardId);
+    
+    // 所有卡牌记录定长，一次性预留空间后顺序写入
+    size_t cardCount = 1 + _playfieldCards.size() + _reserveCards.size();
+    uint8_t* out = writer.append(cardCount * CardModel::kBinaryRecordSize);
+    
+    _stackTopCard.writeBinary(out);
+    out += CardModel::kBinaryRecordSize;
+    
+    for (const auto& card : _playfieldCards)
+    {
+        card.writeBinary(out);
+        out += CardModel::kBinaryRecordSize;
+    }
+    
+    for (const auto& card : _reserveCards)
+    {
+        card.writeBinary(out);
+        out += CardModel::kBinaryRecordSize;
+    }
+}
+
+bool GameModel::deserializeBinary(BinaryReader& reader)
+{
+    uint32_t playfieldCount = 0;
+    uint32_t reserveCount = 0;
+    int32_t nextCardId = 0;
+    if (!reader.readU32(playfieldCount) || !reader.readU32(reserveCount) || !reader.readI32(nextCardId))
+    {
+        return false;
+    }
+    
+    // 先校验长度，避免损坏的计数导致超大分配
+    size_t cardCount = 1 + static_cast<size_t>(playfieldCount) + reserveCount;
+    if (reader.remaining() / CardModel::kBinaryRecordSize < cardCount)
+    {
+        return false;
+    }
+    const uint8_t* in = reader.consume(cardCount * CardModel::kBinaryRecordSize);
+    
+    // 直接从缓冲区解码到模型数组，不经过中间对象
+    _stackTopCard.readBinary(in);
+    in += CardModel::kBinaryRecordSize;
+    
+    _playfieldCards.clear();
+    _playfieldCards.reserve(playfieldCount);
+    CardModel card;
+    for (size_t i = 0; i < playfieldCount; i++)
+    {
+        card.readBinary(in);
+        _playfieldCards.insert(card);
+        in += CardModel::kBinaryRecordSize;
+    }
+    rebuildClickableMatchCounts();
+    
+    // 快照不含预编译数据，恢复后的可点击状态由调用方按几何重新计算
+    _compiledPlayfield.reset();
+    _blockerCounts.clear();
+    
+    _reserveCards.resize(reserveCount);
+    for (auto& card : _reserveCards)
+    {
+        card.readBinary(in);
+        in += CardModel::kBinaryRecordSize;
+    }
+    
+    _nextCardId = nextCardId;
+    return true;
+}
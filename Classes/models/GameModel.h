@@ -14,7 +14,13 @@
 
 #include <vector>
 #include <map>
+#include <memory>
+#include "configs/LevelConfig.h"
 #include "models/CardModel.h"
+#include "models/PlayfieldCardArray.h"
+#include "utils/BinaryStream.h"
+#include "utils/LevelArena.h"
+#include "utils/MatchRules.h"
 #include "json/document.h"
 
 /**
@@ -22,6 +28,8 @@
  * 
  * 管理游戏运行时的所有卡牌数据和状态。
  * 纯数据类，不包含业务逻辑。
+ * 主牌区按列存储在稳定槽位中（PlayfieldCardArray），遍历时按值得到CardModel，
+ * 热点循环可直接读取坐标、点数、标志位等整列数据；按ID查找、移除、回退恢复都是O(1)。
  */
 class GameModel
 {
@@ -53,22 +61,33 @@ public:
     
     /**
      * @brief 获取主牌区所有卡牌
-     * @return 卡牌列表的只读引用
+     * @return 列式存储的只读引用，可按下标或迭代得到CardModel
      */
-    const std::vector<CardModel>& getPlayfieldCards() const { return _playfieldCards; }
+    const PlayfieldCardArray& getPlayfieldCards() const { return _playfieldCards; }
     
     /**
-     * @brief 获取主牌区所有卡牌（可修改）
-     * @return 卡牌列表的引用
+     * @brief 设置主牌区卡牌的可点击状态，同时维护点数统计
+     * @param slot 卡牌在主牌区中的槽位（空槽位忽略）
+     * @param clickable 是否可点击
      */
-    std::vector<CardModel>& getPlayfieldCardsMutable() { return _playfieldCards; }
+    void setPlayfieldCardClickable(size_t slot, bool clickable);
     
     /**
      * @brief 根据ID获取主牌区卡牌
      * @param cardId 卡牌ID
-     * @return 卡牌指针，未找到返回nullptr
+     * @param outCard 输出的卡牌（副本）
+     * @return 找到返回true
+     * 
+     * 可点击状态须通过setPlayfieldCardClickable修改
+     */
+    bool getPlayfieldCardById(int cardId, CardModel& outCard) const;
+    
+    /**
+     * @brief 主牌区是否有指定ID的卡牌
+     * @param cardId 卡牌ID
+     * @return 存在返回true
      */
-    CardModel* getPlayfieldCardById(int cardId);
+    bool hasPlayfieldCard(int cardId) const { return _playfieldCards.findSlot(cardId) >= 0; }
     
     /**
      * @brief 获取主牌区卡牌数量
@@ -76,6 +95,55 @@ public:
      */
     size_t getPlayfieldCardCount() const { return _playfieldCards.size(); }
     
+    /**
+     * @brief 获取主牌区可点击卡牌的匹配下标集合
+     * @return 64位掩码，第i位表示存在匹配下标为i的可点击卡牌
+     * 
+     * 与匹配表的一行按位与即可判断是否有可匹配的卡牌，O(1)
+     */
+    uint64_t getClickableMatchMask() const { return _clickableMatchMask; }
+    
+    /**
+     * @brief 关联关卡的预编译遮挡数据，并据此设置可点击状态
+     * @param compiledPlayfield 预编译数据
+     * @return 与当前主牌区匹配返回true
+     * 
+     * 要求主牌区卡牌ID依次为0..n-1（由GameModelGenerator生成）。
+     * 关联后添加和移除主牌区卡牌时按遮挡关系增量更新可点击状态，不再需要几何计算。
+     */
+    bool setCompiledPlayfield(std::shared_ptr<const CompiledPlayfield> compiledPlayfield);
+    
+    /**
+     * @brief 是否已关联预编译遮挡数据
+     * @return 已关联返回true
+     */
+    bool hasCompiledPlayfield() const { return _compiledPlayfield != nullptr; }
+    
+    /**
+     * @brief 获取关联的预编译遮挡数据
+     * @return 预编译数据，未关联时为空
+     */
+    const std::shared_ptr<const CompiledPlayfield>& getCompiledPlayfield() const { return _compiledPlayfield; }
+    
+    /**
+     * @brief 获取遮挡某张卡牌且仍在主牌区的卡牌数量
+     * @param cardId 卡牌ID
+     * @return 遮挡者数量，未关联预编译数据或ID无效时为-1
+     */
+    int getBlockerCount(int cardId) const
+    {
+        return _compiledPlayfield && cardId >= 0 && cardId < static_cast<int>(_blockerCounts.size())
+            ? _blockerCounts[cardId]
+            : -1;
+    }
+    
+    /**
+     * @brief 获取主牌区卡牌的绘制顺序
+     * @param cardId 卡牌ID
+     * @return 预编译的绘制顺序，未关联预编译数据时为卡牌ID
+     */
+    int getPlayfieldZOrder(int cardId) const;
+    
     // ========== 手牌区顶部牌（Stack）操作 ==========
     
     /**
@@ -127,7 +195,7 @@ public:
      * @brief 获取备用牌堆所有卡牌
      * @return 卡牌列表的只读引用
      */
-    const std::vector<CardModel>& getReserveCards() const { return _reserveCards; }
+    const ArenaVector<CardModel>& getReserveCards() const { return _reserveCards; }
     
     /**
      * @brief 获取备用牌堆剩余数量
@@ -146,21 +214,61 @@ public:
     /**
      * @brief 根据ID查找卡牌（在所有区域中搜索）
      * @param cardId 卡牌ID
-     * @return 卡牌指针，未找到返回nullptr
+     * @param outCard 输出的卡牌（副本）
+     * @return 找到返回true
      */
-    CardModel* findCardById(int cardId);
+    bool findCardById(int cardId, CardModel& outCard) const;
     
     /**
      * @brief 清空所有数据
      */
     void clear();
     
+    /**
+     * @brief 只清空主牌区（含槽位分配和预编译数据），手牌区与备用牌堆不变
+     */
+    void clearPlayfield();
+    
+    // ========== 内存管理 ==========
+    
+    /**
+     * @brief 清空所有数据并释放容器空间，之后的空间从指定内存池分配
+     * @param arena 关卡内存池，nullptr为全局堆
+     * 
+     * 回收内存池前须先调用（传入nullptr或新的内存池），否则容器仍指向已回收的内存。
+     */
+    void setArena(LevelArena* arena);
+    
+    /**
+     * @brief 按关卡的牌数预留容器空间，之后逐张加入卡牌不再扩容
+     * @param playfieldCount 主牌区卡牌数
+     * @param reserveCount 备用牌堆卡牌数
+     */
+    void reserve(size_t playfieldCount, size_t reserveCount);
+    
+    /**
+     * @brief 一局所需的内存池字节数（与reserve预留的空间一致）
+     * @param playfieldCount 主牌区卡牌数
+     * @param reserveCount 备用牌堆卡牌数
+     * @return 字节数
+     */
+    static size_t getArenaBytes(size_t playfieldCount, size_t reserveCount);
+    
     /**
      * @brief 获取下一个可用的卡牌ID
      * @return 新的卡牌ID
      */
     int getNextCardId();
     
+    /**
+     * @brief 计算当前局面的哈希值
+     * @return 32位哈希值
+     * 
+     * 覆盖主牌区剩余卡牌（与顺序无关）、手牌区顶部牌和备用牌堆（与顺序相关），
+     * 用于录像回放时校验终局状态。
+     */
+    uint32_t computeStateHash() const;
+    
     // ========== 序列化方法 ==========
     
     /**
@@ -176,12 +284,55 @@ public:
      * @return 是否成功
      */
     bool deserialize(const rapidjson::Value& json);
+    
+    /**
+     * @brief 序列化为定长二进制记录
+     * @param writer 二进制写入器
+     * 
+     * 布局：playfieldCount(u32) reserveCount(u32) nextCardId(i32)
+     *       stackTopCard 主牌区记录... 备用牌堆记录...
+     */
+    void serializeBinary(BinaryWriter& writer) const;
+    
+    /**
+     * @brief 从二进制记录反序列化
+     * @param reader 二进制读取器
+     * @return 是否成功，失败时模型保持不变
+     */
+    bool deserializeBinary(BinaryReader& reader);
 
 private:
-    std::vector<CardModel> _playfieldCards;     ///< 主牌区卡牌
+    /**
+     * @brief 按主牌区卡牌重新统计可点击卡牌（整体替换主牌区后调用）
+     */
+    void rebuildClickableMatchCounts();
+    
+    /**
+     * @brief 更新主牌区单张卡牌在可点击统计中的计数
+     * @param slot 卡牌在主牌区中的槽位
+     * @param delta 计数变化
+     */
+    void adjustClickableMatchCount(size_t slot, int delta);
+    
+    /**
+     * @brief 卡牌加入或离开主牌区时，更新其下方卡牌的遮挡计数和可点击状态
+     * @param cardId 卡牌ID
+     * @param delta 加入为1，离开为-1
+     */
+    void adjustCompiledBlockers(int cardId, int delta);
+
+private:
+    PlayfieldCardArray _playfieldCards;          ///< 主牌区卡牌（列式存储）
     CardModel _stackTopCard;                     ///< 手牌区顶部牌
-    std::vector<CardModel> _reserveCards;        ///< 备用牌堆
+    ArenaVector<CardModel> _reserveCards;        ///< 备用牌堆
     int _nextCardId;                             ///< 下一个可用的卡牌ID
+    
+    /// 主牌区可点击卡牌按匹配下标的计数，随添加、移除和可点击状态变化增量维护
+    int _clickableMatchCounts[MatchRules::kIndexCount];
+    uint64_t _clickableMatchMask;               ///< 计数非零的匹配下标集合
+    
+    std::shared_ptr<const CompiledPlayfield> _compiledPlayfield;   ///< 关卡预编译数据（多个模型共享）
+    ArenaVector<int> _blockerCounts;    ///< 按卡牌ID统计仍在主牌区的遮挡者数量（仅关联预编译数据时使用）
 };
 
 #endif // __GAME_MODEL_H__
@@ -0,0 +1,65 @@
+/**
+ * @file GameState.cpp
+ * @brief 不可变游戏局面实现
+ */
+
+#include "models/GameState.h"
+
+GameState::GameState()
+    : _reserveCount(0)
+{
+}
+
+GameState::GameState(std::shared_ptr<const GameStateLevel> level,
+                     const PersistentBitset& playfield,
+                     const CardModel& stackTopCard,
+                     int reserveCount)
+    : _level(std::move(level))
+    , _playfield(playfield)
+    , _stackTopCard(stackTopCard)
+    , _reserveCount(reserveCount)
+{
+}
+
+bool GameState::isPlayfieldCardClickable(int cardId) const
+{
+    if (!hasPlayfieldCard(cardId))
+    {
+        return false;
+    }
+    for (int blocker : _level->blockers[cardId])
+    {
+        if (_playfield.test(blocker))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+GameState GameState::withPlayfieldCardToStack(int cardId) const
+{
+    if (!hasPlayfieldCard(cardId))
+    {
+        return *this;
+    }
+    
+    // 只有可点击的卡牌能移动，与GameModel中移走的卡牌一致
+    CardModel movedCard = _level->playfieldCards[cardId];
+    movedCard.setArea(CardAreaType::STACK);
+    movedCard.setClickable(true);
+    return GameState(_level, _playfield.withBit(cardId, false), movedCard, _reserveCount);
+}
+
+GameState GameState::withReserveCardToStack() const
+{
+    if (_reserveCount == 0)
+    {
+        return *this;
+    }
+    
+    CardModel drawnCard = _level->reserveCards[_reserveCount - 1];
+    drawnCard.setArea(CardAreaType::STACK);
+    drawnCard.setFaceUp(true);
+    return GameState(_level, _playfield, drawnCard, _reserveCount - 1);
+}
@@ -0,0 +1,139 @@
+/**
+ * @file GameState.h
+ * @brief 不可变的游戏局面（持久化数据结构）
+ * 
+ * 与GameModel记录同样的对局状态，但每个版本创建后不再修改，操作返回新版本：
+ * - 一局内不变的数据（主牌区卡牌、遮挡关系、备用牌堆）放在共享的GameStateLevel中
+ * - 主牌区剩余卡牌是按卡牌ID的持久化位集合，与旧版本共享未修改的节点
+ * - 备用牌堆只记录剩余数量（总是从末尾翻牌）
+ * 因此保存一个版本（快照）是O(1)的复制，一步操作只复制一个叶子节点，
+ * 小关卡（主牌区ID不超过128）完全不分配内存。
+ * 搜索、提示、回放等需要大量快照的后台系统可以同时持有成千上万个版本。
+ * 与GameModel的相互转换见GameSnapshotService，合法性判断见GameRules。
+ */
+
+#ifndef __GAME_STATE_H__
+#define __GAME_STATE_H__
+
+#include "configs/LevelConfig.h"
+#include "models/CardModel.h"
+#include "utils/PersistentBitset.h"
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 一局内不变的局面数据，由同一局的所有GameState版本共享
+ */
+struct GameStateLevel
+{
+    std::vector<CardModel> playfieldCards;      ///< 按卡牌ID索引的主牌区卡牌（无卡牌的ID为默认CardModel）
+    std::vector<std::vector<int>> blockers;     ///< 按卡牌ID索引的遮挡者ID
+    std::vector<CardModel> reserveCards;        ///< 备用牌堆（末尾先翻）
+    std::shared_ptr<const CompiledPlayfield> compiledPlayfield; ///< 来源模型的预编译数据，可为空
+};
+
+/**
+ * @brief 不可变游戏局面类
+ * 
+ * 纯数据类，只提供查询和状态变换，不判断合法性。
+ * 默认构造的局面无效（isValid()为false），只能被赋值。
+ */
+class GameState
+{
+public:
+    /**
+     * @brief 构造无效局面
+     */
+    GameState();
+    
+    /**
+     * @brief 构造局面
+     * @param level 共享的关卡数据
+     * @param playfield 主牌区剩余卡牌（按卡牌ID）
+     * @param stackTopCard 手牌区顶部牌
+     * @param reserveCount 备用牌堆剩余数量
+     */
+    GameState(std::shared_ptr<const GameStateLevel> level,
+              const PersistentBitset& playfield,
+              const CardModel& stackTopCard,
+              int reserveCount);
+    
+    /**
+     * @brief 是否为有效局面
+     */
+    bool isValid() const { return _level != nullptr; }
+    
+    /**
+     * @brief 获取共享的关卡数据（须为有效局面）
+     */
+    const GameStateLevel& getLevel() const { return *_level; }
+    
+    // ========== 主牌区 ==========
+    
+    /**
+     * @brief 卡牌是否在主牌区
+     * @param cardId 卡牌ID
+     * @return 在主牌区返回true
+     */
+    bool hasPlayfieldCard(int cardId) const
+    {
+        return cardId >= 0 && static_cast<size_t>(cardId) < _playfield.size() && _playfield.test(cardId);
+    }
+    
+    /**
+     * @brief 主牌区卡牌是否可点击（在主牌区且没有遮挡者）
+     * @param cardId 卡牌ID
+     * @return 可点击返回true
+     */
+    bool isPlayfieldCardClickable(int cardId) const;
+    
+    /**
+     * @brief 获取主牌区卡牌数量，O(1)
+     */
+    size_t getPlayfieldCardCount() const { return _playfield.count(); }
+    
+    /**
+     * @brief 获取主牌区剩余卡牌集合（按卡牌ID）
+     */
+    const PersistentBitset& getPlayfield() const { return _playfield; }
+    
+    // ========== 手牌区与备用牌堆 ==========
+    
+    /**
+     * @brief 获取手牌区顶部牌
+     */
+    const CardModel& getStackTopCard() const { return _stackTopCard; }
+    
+    /**
+     * @brief 获取备用牌堆剩余数量
+     */
+    int getReserveCardCount() const { return _reserveCount; }
+    
+    /**
+     * @brief 备用牌堆是否为空
+     */
+    bool isReserveEmpty() const { return _reserveCount == 0; }
+    
+    // ========== 状态变换（不判断合法性，返回新版本） ==========
+    
+    /**
+     * @brief 主牌区卡牌移动到手牌区
+     * @param cardId 在主牌区的卡牌ID
+     * @return 新局面
+     */
+    GameState withPlayfieldCardToStack(int cardId) const;
+    
+    /**
+     * @brief 备用牌堆翻一张牌到手牌区
+     * @return 新局面，备用牌堆为空时与当前局面相同
+     */
+    GameState withReserveCardToStack() const;
+
+private:
+    std::shared_ptr<const GameStateLevel> _level;   ///< 共享的关卡数据
+    PersistentBitset _playfield;                    ///< 主牌区剩余卡牌
+    CardModel _stackTopCard;                        ///< 手牌区顶部牌
+    int _reserveCount;                              ///< 备用牌堆剩余数量
+};
+
+#endif // __GAME_STATE_H__
@@ -0,0 +1,145 @@
+/**
+ * @file PlayfieldCardArray.cpp
+ * @brief 主牌区卡牌列式槽位存储实现
+ */
+
+#include "models/PlayfieldCardArray.h"
+
+const uint8_t PlayfieldCardArray::kFlagFaceUp;
+const uint8_t PlayfieldCardArray::kFlagClickable;
+const uint8_t PlayfieldCardArray::kFlagAreaShift;
+const uint8_t PlayfieldCardArray::kFlagAreaMask;
+const uint8_t PlayfieldCardArray::kFlagOccupied;
+const uint16_t PlayfieldCardArray::kInvalidId;
+
+PlayfieldCardArray::PlayfieldCardArray()
+    : _occupiedCount(0)
+{
+}
+
+CardModel PlayfieldCardArray::getCard(size_t slot) const
+{
+    CardModel card(getCardId(slot), getSuit(slot), getFace(slot));
+    card.setPosition(cocos2d::Vec2(_xs[slot], _ys[slot]));
+    card.setArea(static_cast<CardAreaType>((_flags[slot] & kFlagAreaMask) >> kFlagAreaShift));
+    card.setFaceUp(isFaceUp(slot));
+    card.setClickable(isClickable(slot));
+    return card;
+}
+
+size_t PlayfieldCardArray::insert(const CardModel& card)
+{
+    // 曾经分配过槽位的卡牌回到原槽位
+    int cardId = card.getCardId();
+    if (cardId >= 0 && cardId < static_cast<int>(_slotById.size()) && _slotById[cardId] >= 0)
+    {
+        size_t slot = static_cast<size_t>(_slotById[cardId]);
+        if (!isOccupied(slot))
+        {
+            _occupiedCount++;
+        }
+        store(slot, card);
+        return slot;
+    }
+    
+    size_t slot = _ids.size();
+    _ids.push_back(kInvalidId);
+    _faces.push_back(0);
+    _suits.push_back(0);
+    _xs.push_back(0);
+    _ys.push_back(0);
+    _flags.push_back(0);
+    store(slot, card);
+    _occupiedCount++;
+    
+    // 无效ID的卡牌不建立索引，与按ID查找不到的行为一致
+    if (cardId >= 0)
+    {
+        if (cardId >= static_cast<int>(_slotById.size()))
+        {
+            _slotById.resize(cardId + 1, -1);
+        }
+        _slotById[cardId] = static_cast<int>(slot);
+    }
+    return slot;
+}
+
+void PlayfieldCardArray::remove(size_t slot)
+{
+    if (slot >= slotCount() || !isOccupied(slot))
+    {
+        return;
+    }
+    _flags[slot] &= static_cast<uint8_t>(~kFlagOccupied);
+    _occupiedCount--;
+}
+
+void PlayfieldCardArray::store(size_t slot, const CardModel& card)
+{
+    _ids[slot] = static_cast<uint16_t>(card.getCardId());
+    _faces[slot] = static_cast<int8_t>(card.getFace());
+    _suits[slot] = static_cast<int8_t>(card.getSuit());
+    _xs[slot] = static_cast<int16_t>(card.getX());
+    _ys[slot] = static_cast<int16_t>(card.getY());
+    _flags[slot] = static_cast<uint8_t>(kFlagOccupied
+                                        | (card.isFaceUp() ? kFlagFaceUp : 0)
+                                        | (card.isClickable() ? kFlagClickable : 0)
+                                        | (static_cast<uint8_t>(card.getArea()) << kFlagAreaShift));
+}
+
+void PlayfieldCardArray::reserve(size_t capacity)
+{
+    _ids.reserve(capacity);
+    _faces.reserve(capacity);
+    _suits.reserve(capacity);
+    _xs.reserve(capacity);
+    _ys.reserve(capacity);
+    _flags.reserve(capacity);
+    _slotById.reserve(capacity);
+}
+
+void PlayfieldCardArray::clear()
+{
+    _ids.clear();
+    _faces.clear();
+    _suits.clear();
+    _xs.clear();
+    _ys.clear();
+    _flags.clear();
+    _slotById.clear();
+    _occupiedCount = 0;
+}
+
+void PlayfieldCardArray::setArena(LevelArena* arena)
+{
+    // 赋值空容器时分配器随之替换，原有空间按原分配器释放
+    _ids = ArenaVector<uint16_t>(ArenaAllocator<uint16_t>(arena));
+    _faces = ArenaVector<int8_t>(ArenaAllocator<int8_t>(arena));
+    _suits = ArenaVector<int8_t>(ArenaAllocator<int8_t>(arena));
+    _xs = ArenaVector<int16_t>(ArenaAllocator<int16_t>(arena));
+    _ys = ArenaVector<int16_t>(ArenaAllocator<int16_t>(arena));
+    _flags = ArenaVector<uint8_t>(ArenaAllocator<uint8_t>(arena));
+    _slotById = ArenaVector<int>(ArenaAllocator<int>(arena));
+    _occupiedCount = 0;
+}
+
+size_t PlayfieldCardArray::getArenaBytes(size_t capacity)
+{
+    return LevelArena::alignedSize(capacity * sizeof(uint16_t))
+        + LevelArena::alignedSize(capacity * sizeof(int8_t)) * 2
+        + LevelArena::alignedSize(capacity * sizeof(int16_t)) * 2
+        + LevelArena::alignedSize(capacity * sizeof(uint8_t))
+        + LevelArena::alignedSize(capacity * sizeof(int));
+}
+
+void PlayfieldCardArray::setClickable(size_t slot, bool clickable)
+{
+    if (clickable)
+    {
+        _flags[slot] |= kFlagClickable;
+    }
+    else
+    {
+        _flags[slot] &= static_cast<uint8_t>(~kFlagClickable);
+    }
+}
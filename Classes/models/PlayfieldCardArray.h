@@ -0,0 +1,211 @@
+/**
+ * @file PlayfieldCardArray.h
+ * @brief 主牌区卡牌的列式槽位存储
+ * 
+ * 按字段分别存放主牌区卡牌（结构数组转数组结构）：ID、点数、花色、x、y、标志位各占一个数组。
+ * 热点循环只读取所需的列，例如遮挡计算只扫描坐标，匹配查找只扫描点数和标志位，
+ * 连续的小整数数组对缓存友好，也便于编译器向量化。
+ * 
+ * 每张卡牌第一次加入时分配一个槽位，此后槽位不变（稳定句柄）：
+ * - 移除时只把槽位标记为空（墓碑），不移动其他卡牌
+ * - 回退时卡牌回到原槽位，遍历顺序与移除前完全一致
+ * - 按卡牌ID经索引表直接定位槽位，查找、移除、恢复都是O(1)
+ * 对外仍可迭代得到CardModel（按值组装，跳过空槽位），原有的遍历写法无需修改。
+ */
+
+#ifndef __PLAYFIELD_CARD_ARRAY_H__
+#define __PLAYFIELD_CARD_ARRAY_H__
+
+#include "models/CardModel.h"
+#include "utils/LevelArena.h"
+#include "utils/MatchRules.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+/**
+ * @brief 主牌区卡牌列式槽位存储类
+ * 
+ * 纯数据类，只负责存取，可点击状态的统计等由GameModel维护。
+ * 按槽位访问的接口（getX、isClickable等）对空槽位返回的是移除前的旧值，
+ * 按槽位遍历时须用isOccupied跳过。
+ */
+class PlayfieldCardArray
+{
+public:
+    /// 标志位列的含义
+    static const uint8_t kFlagFaceUp = 1 << 0;
+    static const uint8_t kFlagClickable = 1 << 1;
+    static const uint8_t kFlagAreaShift = 2;
+    static const uint8_t kFlagAreaMask = 0x03 << kFlagAreaShift;
+    static const uint8_t kFlagOccupied = 1 << 4;
+    
+    /**
+     * @brief 只读迭代器，按槽位顺序跳过空槽位，解引用时按值组装CardModel
+     */
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef CardModel value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const CardModel* pointer;
+        typedef CardModel reference;
+        
+        const_iterator() : _array(nullptr), _slot(0) {}
+        const_iterator(const PlayfieldCardArray* array, size_t slot) : _array(array), _slot(slot) { skipEmpty(); }
+        
+        CardModel operator*() const { return _array->getCard(_slot); }
+        const_iterator& operator++() { ++_slot; skipEmpty(); return *this; }
+        const_iterator operator++(int) { const_iterator old = *this; ++(*this); return old; }
+        bool operator==(const const_iterator& other) const { return _slot == other._slot; }
+        bool operator!=(const const_iterator& other) const { return _slot != other._slot; }
+        
+        /**
+         * @brief 当前卡牌的槽位
+         */
+        size_t slot() const { return _slot; }
+    
+    private:
+        void skipEmpty()
+        {
+            while (_slot < _array->slotCount() && !_array->isOccupied(_slot))
+            {
+                ++_slot;
+            }
+        }
+        
+        const PlayfieldCardArray* _array;
+        size_t _slot;
+    };
+    
+    /**
+     * @brief 构造函数
+     */
+    PlayfieldCardArray();
+    
+    // ========== 容器接口 ==========
+    
+    /**
+     * @brief 在场卡牌数量（不含空槽位）
+     */
+    size_t size() const { return _occupiedCount; }
+    bool empty() const { return _occupiedCount == 0; }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, slotCount()); }
+    
+    /**
+     * @brief 槽位总数（含空槽位），按槽位遍历时的上界
+     */
+    size_t slotCount() const { return _ids.size(); }
+    
+    /**
+     * @brief 槽位上是否有卡牌
+     */
+    bool isOccupied(size_t slot) const { return (_flags[slot] & kFlagOccupied) != 0; }
+    
+    /**
+     * @brief 按槽位组装卡牌
+     * @param slot 槽位，须小于slotCount()
+     * @return 卡牌模型（副本）
+     */
+    CardModel getCard(size_t slot) const;
+    
+    /**
+     * @brief 加入卡牌
+     * @param card 卡牌模型
+     * @return 卡牌所在槽位
+     * 
+     * 卡牌ID曾经占用过槽位时回到原槽位（已在场时覆盖），否则在末尾分配新槽位。
+     */
+    size_t insert(const CardModel& card);
+    
+    /**
+     * @brief 移除卡牌，槽位标记为空，其他卡牌位置不变
+     * @param slot 槽位
+     */
+    void remove(size_t slot);
+    
+    /**
+     * @brief 为所有列预留空间
+     * @param capacity 槽位数量
+     */
+    void reserve(size_t capacity);
+    
+    /**
+     * @brief 清空所有槽位和ID索引（保留已分配的空间）
+     */
+    void clear();
+    
+    /**
+     * @brief 清空并释放所有列，之后的空间从指定内存池分配
+     * @param arena 关卡内存池，nullptr为全局堆
+     */
+    void setArena(LevelArena* arena);
+    
+    /**
+     * @brief 容纳指定卡牌数所需的内存池字节数（所有列和ID索引）
+     * @param capacity 槽位数量
+     * @return 字节数
+     */
+    static size_t getArenaBytes(size_t capacity);
+    
+    /**
+     * @brief 按ID查找在场卡牌的槽位，O(1)
+     * @param cardId 卡牌ID
+     * @return 槽位，不在场返回-1
+     */
+    int findSlot(int cardId) const
+    {
+        if (cardId < 0 || cardId >= static_cast<int>(_slotById.size()))
+        {
+            return -1;
+        }
+        int slot = _slotById[cardId];
+        return slot >= 0 && isOccupied(slot) ? slot : -1;
+    }
+    
+    // ========== 按槽位读取单个字段 ==========
+    
+    int getCardId(size_t slot) const { return _ids[slot] == kInvalidId ? -1 : static_cast<int>(_ids[slot]); }
+    CardFaceType getFace(size_t slot) const { return static_cast<CardFaceType>(_faces[slot]); }
+    CardSuitType getSuit(size_t slot) const { return static_cast<CardSuitType>(_suits[slot]); }
+    int getX(size_t slot) const { return _xs[slot]; }
+    int getY(size_t slot) const { return _ys[slot]; }
+    bool isFaceUp(size_t slot) const { return (_flags[slot] & kFlagFaceUp) != 0; }
+    bool isClickable(size_t slot) const { return (_flags[slot] & kFlagClickable) != 0; }
+    int getMatchIndex(size_t slot) const { return MatchRules::toIndex(getSuit(slot), getFace(slot)); }
+    
+    /**
+     * @brief 设置可点击状态（不维护统计，须经由GameModel调用）
+     */
+    void setClickable(size_t slot, bool clickable);
+    
+    // ========== 整列访问（热点循环使用，下标为槽位） ==========
+    
+    const ArenaVector<int8_t>& getFaces() const { return _faces; }
+    const ArenaVector<int16_t>& getXs() const { return _xs; }
+    const ArenaVector<int16_t>& getYs() const { return _ys; }
+    const ArenaVector<uint8_t>& getFlags() const { return _flags; }
+
+private:
+    static const uint16_t kInvalidId = 0xFFFF;  ///< 无效ID（-1），与CardModel一致
+    
+    /**
+     * @brief 把卡牌写入槽位并标记为有卡牌
+     */
+    void store(size_t slot, const CardModel& card);
+
+private:
+    ArenaVector<uint16_t> _ids;         ///< 卡牌ID
+    ArenaVector<int8_t> _faces;         ///< 点数
+    ArenaVector<int8_t> _suits;         ///< 花色
+    ArenaVector<int16_t> _xs;           ///< 位置x（设计分辨率像素）
+    ArenaVector<int16_t> _ys;           ///< 位置y（设计分辨率像素）
+    ArenaVector<uint8_t> _flags;        ///< 正面朝上、可点击、所在区域、槽位有卡牌
+    
+    ArenaVector<int> _slotById;         ///< 按卡牌ID索引的槽位，未分配为-1（移除后仍保留）
+    size_t _occupiedCount;              ///< 有卡牌的槽位数量
+};
+
+#endif // __PLAYFIELD_CARD_ARRAY_H__
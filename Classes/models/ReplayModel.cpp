@@ -0,0 +1,183 @@
+/**
+ * @file ReplayModel.cpp
+ * @brief 对局录像数据模型实现
+ */
+
+#include "models/ReplayModel.h"
+#include "utils/BinaryStream.h"
+
+namespace
+{
+    const size_t kHeaderSize = 24;
+    const uint16_t kFlagClaimedWin = 1 << 0;
+    const int kActionTypeShift = 14;
+}
+
+const uint32_t ReplayModel::kMagic;
+const uint16_t ReplayModel::kVersion;
+const int ReplayModel::kMaxCardId;
+
+ReplayModel::ReplayModel()
+    : _levelId(0)
+    , _levelHash(0)
+    , _claimedWin(false)
+    , _claimedStateHash(0)
+{
+}
+
+ReplayModel::~ReplayModel()
+{
+}
+
+void ReplayModel::clear()
+{
+    _levelId = 0;
+    _levelHash = 0;
+    _actions.clear();
+    _claimedWin = false;
+    _claimedStateHash = 0;
+}
+
+bool ReplayModel::serializeBinary(std::vector<uint8_t>& outBuffer) const
+{
+    outBuffer.clear();
+    BinaryWriter writer(outBuffer);
+    
+    writer.writeU32(kMagic);
+    writer.writeU16(kVersion);
+    writer.writeU16(_claimedWin ? kFlagClaimedWin : 0);
+    writer.writeI32(_levelId);
+    writer.writeU32(_levelHash);
+    writer.writeU32(_claimedStateHash);
+    writer.writeU32(static_cast<uint32_t>(_actions.size()));
+    
+    uint8_t* out = writer.append(_actions.size() * 2);
+    for (const auto& action : _actions)
+    {
+        int cardId = action.type == GameActionType::PLAYFIELD_TO_STACK ? action.cardId : 0;
+        if (cardId < 0 || cardId > kMaxCardId)
+        {
+            return false;
+        }
+        uint16_t packed = static_cast<uint16_t>((static_cast<int>(action.type) << kActionTypeShift) | cardId);
+        BinaryUtils::storeU16(out, packed);
+        out += 2;
+    }
+    return true;
+}
+
+bool ReplayModel::deserializeBinary(const uint8_t* data, size_t size)
+{
+    if (!data || size < kHeaderSize || BinaryUtils::loadU32(data) != kMagic)
+    {
+        return false;
+    }
+    
+    BinaryReader reader(data + 4, size - 4);
+    uint16_t version = 0;
+    uint16_t flags = 0;
+    int32_t levelId = 0;
+    uint32_t levelHash = 0;
+    uint32_t stateHash = 0;
+    uint32_t actionCount = 0;
+    reader.readU16(version);
+    reader.readU16(flags);
+    reader.readI32(levelId);
+    reader.readU32(levelHash);
+    reader.readU32(stateHash);
+    reader.readU32(actionCount);
+    // 负载长度须恰好等于操作数据长度，多余的字节说明文件损坏或被拼接
+    if (version != kVersion || reader.remaining() != static_cast<size_t>(actionCount) * 2)
+    {
+        return false;
+    }
+    
+    const uint8_t* in = reader.consume(actionCount * 2);
+    _actions.resize(actionCount);
+    for (auto& action : _actions)
+    {
+        uint16_t packed = BinaryUtils::loadU16(in);
+        in += 2;
+        action.type = static_cast<GameActionType>(packed >> kActionTypeShift);
+        action.cardId = action.type == GameActionType::PLAYFIELD_TO_STACK ? (packed & kMaxCardId) : -1;
+    }
+    
+    _levelId = levelId;
+    _levelHash = levelHash;
+    _claimedWin = (flags & kFlagClaimedWin) != 0;
+    _claimedStateHash = stateHash;
+    return true;
+}
+
+rapidjson::Value ReplayModel::serialize(rapidjson::Document::AllocatorType& allocator) const
+{
+    rapidjson::Value json(rapidjson::kObjectType);
+    
+    json.AddMember("levelId", _levelId, allocator);
+    json.AddMember("levelHash", _levelHash, allocator);
+    json.AddMember("claimedWin", _claimedWin, allocator);
+    json.AddMember("claimedStateHash", _claimedStateHash, allocator);
+    
+    rapidjson::Value actionArray(rapidjson::kArrayType);
+    for (const auto& action : _actions)
+    {
+        rapidjson::Value actionObj(rapidjson::kObjectType);
+        actionObj.AddMember("type", static_cast<int>(action.type), allocator);
+        actionObj.AddMember("cardId", action.cardId, allocator);
+        actionArray.PushBack(actionObj, allocator);
+    }
+    json.AddMember("actions", actionArray, allocator);
+    
+    return json;
+}
+
+bool ReplayModel::deserialize(const rapidjson::Value& json)
+{
+    if (!json.IsObject())
+    {
+        return false;
+    }
+    
+    clear();
+    
+    if (json.HasMember("levelId") && json["levelId"].IsInt())
+    {
+        _levelId = json["levelId"].GetInt();
+    }
+    
+    if (json.HasMember("levelHash") && json["levelHash"].IsUint())
+    {
+        _levelHash = json["levelHash"].GetUint();
+    }
+    
+    if (json.HasMember("claimedWin") && json["claimedWin"].IsBool())
+    {
+        _claimedWin = json["claimedWin"].GetBool();
+    }
+    
+    if (json.HasMember("claimedStateHash") && json["claimedStateHash"].IsUint())
+    {
+        _claimedStateHash = json["claimedStateHash"].GetUint();
+    }
+    
+    if (json.HasMember("actions") && json["actions"].IsArray())
+    {
+        const auto& actionArray = json["actions"];
+        for (rapidjson::SizeType i = 0; i < actionArray.Size(); i++)
+        {
+            const auto& actionObj = actionArray[i];
+            ReplayAction action;
+            if (actionObj.HasMember("type") && actionObj["type"].IsInt())
+            {
+                action.type = static_cast<GameActionType>(actionObj["type"].GetInt());
+            }
+            if (actionObj.HasMember("cardId") && actionObj["cardId"].IsInt())
+            {
+                action.cardId = actionObj["cardId"].GetInt();
+            }
+            _actions.push_back(action);
+        }
+    }
+    
+    return true;
+}
@@ -0,0 +1,167 @@
+/**
+ * @file ReplayModel.h
+ * @brief 对局录像数据模型
+ * 
+ * 记录一局游戏的关卡标识和玩家操作序列，
+ * 以及录制端声明的终局结果，用于回放复现和成绩校验。
+ */
+
+#ifndef __REPLAY_MODEL_H__
+#define __REPLAY_MODEL_H__
+
+#include "configs/CardTypes.h"
+#include "json/document.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 单次玩家操作
+ */
+struct ReplayAction
+{
+    GameActionType type;    ///< 操作类型
+    int cardId;             ///< 主牌区卡牌ID（仅PLAYFIELD_TO_STACK有效）
+    
+    ReplayAction()
+        : type(GameActionType::NONE)
+        , cardId(-1)
+    {
+    }
+    
+    ReplayAction(GameActionType t, int id)
+        : type(t)
+        , cardId(id)
+    {
+    }
+};
+
+/**
+ * @brief 对局录像数据模型类
+ * 
+ * 二进制格式（小端序）：
+ * - 文件头24字节：magic(u32) version(u16) flags(u16) levelId(i32)
+ *   levelHash(u32) claimedStateHash(u32) actionCount(u32)
+ * - 每个操作2字节：高2位为操作类型，低14位为卡牌ID
+ */
+class ReplayModel
+{
+public:
+    static const uint32_t kMagic = 0x50524350;     ///< "PCRP"
+    static const uint16_t kVersion = 1;            ///< 当前录像版本
+    static const int kMaxCardId = 0x3FFF;          ///< 二进制格式可表示的最大卡牌ID
+    
+    /**
+     * @brief 默认构造函数
+     */
+    ReplayModel();
+    
+    /**
+     * @brief 析构函数
+     */
+    ~ReplayModel();
+    
+    // ========== Getter方法 ==========
+    
+    /**
+     * @brief 获取关卡ID
+     * @return 关卡ID，0表示测试数据
+     */
+    int getLevelId() const { return _levelId; }
+    
+    /**
+     * @brief 获取关卡内容哈希
+     * @return 录制时关卡配置的哈希值
+     */
+    uint32_t getLevelHash() const { return _levelHash; }
+    
+    /**
+     * @brief 获取操作序列
+     * @return 操作列表的只读引用
+     */
+    const std::vector<ReplayAction>& getActions() const { return _actions; }
+    
+    /**
+     * @brief 录制端声明是否获胜
+     * @return 获胜返回true
+     */
+    bool isClaimedWin() const { return _claimedWin; }
+    
+    /**
+     * @brief 获取录制端声明的终局状态哈希
+     * @return GameModel::computeStateHash的结果
+     */
+    uint32_t getClaimedStateHash() const { return _claimedStateHash; }
+    
+    // ========== Setter方法 ==========
+    
+    /**
+     * @brief 设置关卡标识
+     * @param levelId 关卡ID
+     * @param levelHash 关卡内容哈希
+     */
+    void setLevel(int levelId, uint32_t levelHash) { _levelId = levelId; _levelHash = levelHash; }
+    
+    /**
+     * @brief 追加一次操作
+     * @param action 操作
+     */
+    void addAction(const ReplayAction& action) { _actions.push_back(action); }
+    
+    /**
+     * @brief 预留操作序列容量
+     * @param capacity 预计的操作数
+     */
+    void reserveActions(size_t capacity) { _actions.reserve(capacity); }
+    
+    /**
+     * @brief 设置声明的终局结果
+     * @param isWin 是否获胜
+     * @param stateHash 终局状态哈希
+     */
+    void setClaimedResult(bool isWin, uint32_t stateHash) { _claimedWin = isWin; _claimedStateHash = stateHash; }
+    
+    /**
+     * @brief 清空所有数据
+     */
+    void clear();
+    
+    // ========== 序列化方法 ==========
+    
+    /**
+     * @brief 序列化为紧凑二进制格式
+     * @param outBuffer 输出缓冲区（原内容会被覆盖）
+     * @return 成功返回true，卡牌ID超出kMaxCardId时返回false
+     */
+    bool serializeBinary(std::vector<uint8_t>& outBuffer) const;
+    
+    /**
+     * @brief 从二进制数据反序列化
+     * @param data 数据
+     * @param size 数据长度
+     * @return 是否成功；长度与操作数不符（含末尾有多余字节）时失败，模型保持不变
+     */
+    bool deserializeBinary(const uint8_t* data, size_t size);
+    
+    /**
+     * @brief 序列化为JSON对象（便于客服人工查看）
+     * @param allocator JSON分配器
+     * @return JSON值对象
+     */
+    rapidjson::Value serialize(rapidjson::Document::AllocatorType& allocator) const;
+    
+    /**
+     * @brief 从JSON对象反序列化
+     * @param json JSON值对象
+     * @return 是否成功
+     */
+    bool deserialize(const rapidjson::Value& json);
+
+private:
+    int _levelId;                           ///< 关卡ID
+    uint32_t _levelHash;                    ///< 关卡内容哈希
+    std::vector<ReplayAction> _actions;     ///< 操作序列
+    bool _claimedWin;                       ///< 声明是否获胜
+    uint32_t _claimedStateHash;             ///< 声明的终局状态哈希
+};
+
+#endif // __REPLAY_MODEL_H__
@@ -4,18 +4,28 @@
  */
 
 #include "models/UndoModel.h"
+#include "utils/BinaryStream.h"
+
+// 撤销栈每步一条记录，保持紧凑
+static_assert(sizeof(UndoModel) == 28, "UndoModel must stay 28 bytes");
+
+const size_t UndoModel::kBinaryRecordSize;
 
 UndoModel::UndoModel()
     : _operationType(CardOperationType::NONE)
-    , _originalPosition(cocos2d::Vec2::ZERO)
-    , _targetPosition(cocos2d::Vec2::ZERO)
+    , _originalX(0)
+    , _originalY(0)
+    , _targetX(0)
+    , _targetY(0)
 {
 }
 
 UndoModel::UndoModel(CardOperationType operationType)
     : _operationType(operationType)
-    , _originalPosition(cocos2d::Vec2::ZERO)
-    , _targetPosition(cocos2d::Vec2::ZERO)
+    , _originalX(0)
+    , _originalY(0)
+    , _targetX(0)
+    , _targetY(0)
 {
 }
 
@@ -32,13 +42,13 @@ rapidjson::Value UndoModel::serialize(rapidjson::Document::AllocatorType& alloca
     json.AddMember("previousStackTopCard", _previousStackTopCard.serialize(allocator), allocator);
     
     rapidjson::Value origPosObj(rapidjson::kObjectType);
-    origPosObj.AddMember("x", _originalPosition.x, allocator);
-    origPosObj.AddMember("y", _originalPosition.y, allocator);
+    origPosObj.AddMember("x", static_cast<float>(_originalX), allocator);
+    origPosObj.AddMember("y", static_cast<float>(_originalY), allocator);
     json.AddMember("originalPosition", origPosObj, allocator);
     
     rapidjson::Value targetPosObj(rapidjson::kObjectType);
-    targetPosObj.AddMember("x", _targetPosition.x, allocator);
-    targetPosObj.AddMember("y", _targetPosition.y, allocator);
+    targetPosObj.AddMember("x", static_cast<float>(_targetX), allocator);
+    targetPosObj.AddMember("y", static_cast<float>(_targetY), allocator);
     json.AddMember("targetPosition", targetPosObj, allocator);
     
     return json;
@@ -71,8 +81,7 @@ bool UndoModel::deserialize(const rapidjson::Value& json)
         const auto& posObj = json["originalPosition"];
         if (posObj.HasMember("x") && posObj.HasMember("y"))
         {
-            _originalPosition.x = posObj["x"].GetFloat();
-            _originalPosition.y = posObj["y"].GetFloat();
+            setOriginalPosition(cocos2d::Vec2(posObj["x"].GetFloat(), posObj["y"].GetFloat()));
         }
     }
     
@@ -81,14 +90,40 @@ bool UndoModel::deserialize(const rapidjson::Value& json)
         const auto& posObj = json["targetPosition"];
         if (posObj.HasMember("x") && posObj.HasMember("y"))
         {
-            _targetPosition.x = posObj["x"].GetFloat();
-            _targetPosition.y = posObj["y"].GetFloat();
+            setTargetPosition(cocos2d::Vec2(posObj["x"].GetFloat(), posObj["y"].GetFloat()));
         }
     }
     
     return true;
 }
 
+void UndoModel::writeBinary(uint8_t* out) const
+{
+    out[0] = static_cast<uint8_t>(_operationType);
+    out[1] = 0;
+    out[2] = 0;
+    out[3] = 0;
+    _movedCard.writeBinary(out + 4);
+    _previousStackTopCard.writeBinary(out + 4 + CardModel::kBinaryRecordSize);
+    
+    uint8_t* posOut = out + 4 + CardModel::kBinaryRecordSize * 2;
+    BinaryUtils::storeF32(posOut, static_cast<float>(_originalX));
+    BinaryUtils::storeF32(posOut + 4, static_cast<float>(_originalY));
+    BinaryUtils::storeF32(posOut + 8, static_cast<float>(_targetX));
+    BinaryUtils::storeF32(posOut + 12, static_cast<float>(_targetY));
+}
+
+void UndoModel::readBinary(const uint8_t* in)
+{
+    _operationType = static_cast<CardOperationType>(in[0]);
+    _movedCard.readBinary(in + 4);
+    _previousStackTopCard.readBinary(in + 4 + CardModel::kBinaryRecordSize);
+    
+    const uint8_t* posIn = in + 4 + CardModel::kBinaryRecordSize * 2;
+    setOriginalPosition(cocos2d::Vec2(BinaryUtils::loadF32(posIn), BinaryUtils::loadF32(posIn + 4)));
+    setTargetPosition(cocos2d::Vec2(BinaryUtils::loadF32(posIn + 8), BinaryUtils::loadF32(posIn + 12)));
+}
+
 bool UndoModel::isValid() const
 {
     // 操作类型必须有效
@@ -4,6 +4,7 @@
  * 
  * 存储单次操作的回退数据，用于实现撤销功能。
  * 记录操作类型、涉及的卡牌和位置信息。
+ * 位置与CardModel一样以16位定点整数存储，每条记录28字节，撤销栈按关卡牌数整块预留。
  */
 
 #ifndef __UNDO_MODEL_H__
@@ -64,13 +65,13 @@ public:
      * @brief 获取卡牌原始位置
      * @return 原始位置
      */
-    cocos2d::Vec2 getOriginalPosition() const { return _originalPosition; }
+    cocos2d::Vec2 getOriginalPosition() const { return cocos2d::Vec2(_originalX, _originalY); }
     
     /**
      * @brief 获取目标位置
      * @return 目标位置
      */
-    cocos2d::Vec2 getTargetPosition() const { return _targetPosition; }
+    cocos2d::Vec2 getTargetPosition() const { return cocos2d::Vec2(_targetX, _targetY); }
     
     // ========== Setter方法 ==========
     
@@ -94,15 +95,23 @@ public:
     
     /**
      * @brief 设置卡牌原始位置
-     * @param position 原始位置
+     * @param position 原始位置，四舍五入到整数像素
      */
-    void setOriginalPosition(const cocos2d::Vec2& position) { _originalPosition = position; }
+    void setOriginalPosition(const cocos2d::Vec2& position)
+    {
+        _originalX = CardModel::toCoordinate(position.x);
+        _originalY = CardModel::toCoordinate(position.y);
+    }
     
     /**
      * @brief 设置目标位置
-     * @param position 目标位置
+     * @param position 目标位置，四舍五入到整数像素
      */
-    void setTargetPosition(const cocos2d::Vec2& position) { _targetPosition = position; }
+    void setTargetPosition(const cocos2d::Vec2& position)
+    {
+        _targetX = CardModel::toCoordinate(position.x);
+        _targetY = CardModel::toCoordinate(position.y);
+    }
     
     // ========== 序列化方法 ==========
     
@@ -120,6 +129,25 @@ public:
      */
     bool deserialize(const rapidjson::Value& json);
     
+    /// 二进制记录的固定长度（字节）
+    static const size_t kBinaryRecordSize = 4 + CardModel::kBinaryRecordSize * 2 + 16;
+    
+    /**
+     * @brief 写入定长二进制记录（小端序）
+     * @param out 输出地址，至少kBinaryRecordSize字节
+     * 
+     * 布局：operationType(u8) 保留(3) movedCard previousStackTopCard
+     *       originalPosition(f32 x2) targetPosition(f32 x2)
+     * 文件格式保持不变，位置读入时取整为定点坐标。
+     */
+    void writeBinary(uint8_t* out) const;
+    
+    /**
+     * @brief 从定长二进制记录读取
+     * @param in 输入地址，至少kBinaryRecordSize字节
+     */
+    void readBinary(const uint8_t* in);
+    
     // ========== 工具方法 ==========
     
     /**
@@ -132,8 +160,10 @@ private:
     CardOperationType _operationType;       ///< 操作类型
     CardModel _movedCard;                   ///< 被移动的卡牌
     CardModel _previousStackTopCard;        ///< 操作前的手牌区顶部牌
-    cocos2d::Vec2 _originalPosition;        ///< 卡牌原始位置
-    cocos2d::Vec2 _targetPosition;          ///< 卡牌目标位置
+    int16_t _originalX;                     ///< 卡牌原始位置x（设计分辨率像素）
+    int16_t _originalY;                     ///< 卡牌原始位置y
+    int16_t _targetX;                       ///< 卡牌目标位置x
+    int16_t _targetY;                       ///< 卡牌目标位置y
 };
 
 #endif // __UNDO_MODEL_H__
@@ -6,12 +6,55 @@
 #include "scenes/GameScene.h"
 #include "configs/CardTypes.h"
 #include "configs/LevelConfigLoader.h"
+#include "services/GameSnapshotService.h"
+#include "services/ReplayService.h"
+#include "utils/TraceProfiler.h"
 
 USING_NS_CC;
 
-Scene* GameScene::createScene()
+Scene* GameScene::createScene(LevelConfigCache* levelCache, LevelArenaPool* levelArenaPool)
 {
-    return GameScene::create();
+    return GameScene::create(levelCache, levelArenaPool);
+}
+
+GameScene* GameScene::create(LevelConfigCache* levelCache, LevelArenaPool* levelArenaPool)
+{
+    GameScene* scene = new (std::nothrow) GameScene(levelCache, levelArenaPool);
+    if (scene && scene->init())
+    {
+        scene->autorelease();
+        return scene;
+    }
+    CC_SAFE_DELETE(scene);
+    return nullptr;
+}
+
+GameScene* GameScene::createForPrebuild(LevelConfigCache* levelCache, LevelArenaPool* levelArenaPool)
+{
+    GameScene* scene = new (std::nothrow) GameScene(levelCache, levelArenaPool);
+    if (scene && scene->Scene::init() && scene->initGameObjects(true))
+    {
+        scene->autorelease();
+        return scene;
+    }
+    CC_SAFE_DELETE(scene);
+    return nullptr;
+}
+
+GameScene::GameScene(LevelConfigCache* levelCache, LevelArenaPool* levelArenaPool)
+    : _gameView(nullptr)
+    , _levelCache(levelCache)
+    , _levelArenaPool(levelArenaPool)
+    , _levelId(0)
+    , _nextScene(nullptr)
+    , _nextLevelStage(NextLevelStage::IDLE)
+    , _celebrationTime(0.0f)
+{
+}
+
+GameScene::~GameScene()
+{
+    CC_SAFE_RELEASE(_nextScene);
 }
 
 bool GameScene::init()
@@ -21,9 +64,40 @@ bool GameScene::init()
         return false;
     }
     
-    _gameView = nullptr;
-    _gameController = nullptr;
+    if (!initGameObjects(false))
+    {
+        return false;
+    }
+    
+    // 优先从切后台时保存的快照恢复对局
+    if (_gameController->restoreSnapshot(GameSnapshotService::getDefaultSnapshotPath(), _levelCache))
+    {
+        CCLOG("GameScene: Resumed game from snapshot");
+        // 录像与快照一同保存，恢复后继续录制；关卡ID来自快照，录像缺失时也能衔接下一关
+        _gameController->restoreReplay(ReplayService::getDefaultReplayPath());
+        _levelId = _gameController->getReplay().getLevelId();
+        return true;
+    }
+    
+    // 加载关卡配置并启动游戏
+    const int levelId = 1;  // 加载第1关
+    if (!startLevel(levelId))
+    {
+        // 加载失败，使用测试数据
+        CCLOG("GameScene: Failed to load level config, using test data");
+        if (!_gameController->startGame())
+        {
+            CCLOG("GameScene: Failed to start game");
+            return false;
+        }
+    }
     
+    CCLOG("GameScene: Initialized successfully");
+    return true;
+}
+
+bool GameScene::initGameObjects(bool isIncrementalBuild)
+{
     // 创建游戏视图
     _gameView = GameView::create();
     if (!_gameView)
@@ -34,41 +108,163 @@ bool GameScene::init()
     
     // 设置视图位置
     _gameView->setPosition(Vec2::ZERO);
+    _gameView->setIncrementalBuild(isIncrementalBuild);
     this->addChild(_gameView, 0);
     
     // 创建游戏控制器
     _gameController = std::make_unique<GameController>();
-    if (!_gameController->init(_gameView))
+    if (!_gameController->init(_gameView, _levelArenaPool))
     {
         CCLOG("GameScene: Failed to init GameController");
         return false;
     }
     
-    // 加载关卡配置并启动游戏
-    LevelConfig levelConfig;
-    std::string levelPath = LevelConfigLoader::getLevelConfigPath(1);  // 加载第1关
+    _gameController->setLevelClearedCallback([this]() {
+        this->onLevelCleared();
+    });
+    _gameController->setLevelReopenedCallback([this]() {
+        this->cancelNextLevel();
+    });
+    return true;
+}
+
+bool GameScene::startLevel(int levelId)
+{
+    // 缓存中的配置已预编译，各局模型共享其遮挡数据
+    std::shared_ptr<const CachedLevel> level = _levelCache->getLevel(levelId);
+    if (!level)
+    {
+        return false;
+    }
     
-    if (LevelConfigLoader::loadFromFile(levelPath, levelConfig))
+    // 使用JSON配置启动游戏
+    if (!_gameController->startGame(*level->config))
     {
-        // 使用JSON配置启动游戏
-        if (!_gameController->startGame(levelConfig))
-        {
-            CCLOG("GameScene: Failed to start game with level config");
-            return false;
-        }
-        CCLOG("GameScene: Game started with level config: %s", levelPath.c_str());
+        CCLOG("GameScene: Failed to start game with level config");
+        return false;
     }
-    else
+    
+    _levelId = levelId;
+    CCLOG("GameScene: Game started with level %d (cache hits %llu, misses %llu)", levelId,
+          static_cast<unsigned long long>(_levelCache->getHitCount()),
+          static_cast<unsigned long long>(_levelCache->getMissCount()));
+    return true;
+}
+
+bool GameScene::prepareLevel(int levelId)
+{
+    TRACE_SCOPE("scene", "GameScene::prepareLevel");
+    return startLevel(levelId);
+}
+
+bool GameScene::buildStep(float budgetSeconds)
+{
+    TRACE_SCOPE("scene", "GameScene::buildStep");
+    return !_gameView || _gameView->buildStep(budgetSeconds);
+}
+
+bool GameScene::saveGameSnapshot()
+{
+    if (!_gameController)
     {
-        // 加载失败，使用测试数据
-        CCLOG("GameScene: Failed to load level config, using test data");
-        if (!_gameController->startGame())
-        {
-            CCLOG("GameScene: Failed to start game");
-            return false;
-        }
+        return false;
     }
     
-    CCLOG("GameScene: Initialized successfully");
+    if (!_gameController->saveSnapshot(GameSnapshotService::getDefaultSnapshotPath()))
+    {
+        return false;
+    }
+    
+    // 录像保存失败不影响续玩
+    _gameController->saveReplay(ReplayService::getDefaultReplayPath());
     return true;
 }
+
+// ========== 下一关 ==========
+
+void GameScene::onLevelCleared()
+{
+    // 每次检查到胜利局面都会通知，只处理第一次
+    if (_nextLevelStage != NextLevelStage::IDLE)
+    {
+        return;
+    }
+    
+    int nextLevelId = _levelId + 1;
+    if (_levelId <= 0 || !FileUtils::getInstance()->isFileExist(LevelConfigLoader::getLevelConfigPath(nextLevelId)))
+    {
+        CCLOG("GameScene: No next level after level %d", _levelId);
+        _nextLevelStage = NextLevelStage::FINISHED;
+        return;
+    }
+    
+    // 胜利展示期间逐帧构建，每帧只做一步，卡牌视图受时间预算限制
+    _celebrationTime = 0.0f;
+    _nextLevelStage = NextLevelStage::CREATE_SCENE;
+    this->schedule(CC_SCHEDULE_SELECTOR(GameScene::updateNextLevel));
+}
+
+void GameScene::updateNextLevel(float dt)
+{
+    TRACE_SCOPE("scene", "GameScene::updateNextLevel");
+    _celebrationTime += dt;
+    
+    switch (_nextLevelStage)
+    {
+        case NextLevelStage::CREATE_SCENE:
+            _nextScene = GameScene::createForPrebuild(_levelCache, _levelArenaPool);
+            CC_SAFE_RETAIN(_nextScene);
+            _nextLevelStage = NextLevelStage::LOAD_LEVEL;
+            if (!_nextScene)
+            {
+                CCLOG("GameScene: Failed to create next level scene");
+                finishNextLevel();
+            }
+            break;
+            
+        case NextLevelStage::LOAD_LEVEL:
+            _nextLevelStage = NextLevelStage::BUILD_VIEWS;
+            if (!_nextScene->prepareLevel(_levelId + 1))
+            {
+                CCLOG("GameScene: Failed to prepare level %d", _levelId + 1);
+                finishNextLevel();
+            }
+            break;
+            
+        case NextLevelStage::BUILD_VIEWS:
+            if (_nextScene->buildStep(GameConstants::kViewBuildFrameBudget))
+            {
+                _nextLevelStage = NextLevelStage::READY;
+            }
+            break;
+            
+        case NextLevelStage::READY:
+            if (_celebrationTime >= GameConstants::kWinCelebrationTime)
+            {
+                // 场景已完整构建，切换时只播放过渡
+                Director::getInstance()->replaceScene(
+                    TransitionFade::create(GameConstants::kLevelTransitionTime, _nextScene));
+                finishNextLevel();
+            }
+            break;
+            
+        default:
+            break;
+    }
+}
+
+void GameScene::finishNextLevel()
+{
+    this->unschedule(CC_SCHEDULE_SELECTOR(GameScene::updateNextLevel));
+    CC_SAFE_RELEASE_NULL(_nextScene);
+    _nextLevelStage = NextLevelStage::FINISHED;
+}
+
+void GameScene::cancelNextLevel()
+{
+    // 已切换场景时过渡期间不响应输入，不会走到这里；构建中的场景释放后由其控制器归还关卡内存
+    this->unschedule(CC_SCHEDULE_SELECTOR(GameScene::updateNextLevel));
+    CC_SAFE_RELEASE_NULL(_nextScene);
+    _nextLevelStage = NextLevelStage::IDLE;
+    _celebrationTime = 0.0f;
+}
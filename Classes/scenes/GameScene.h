@@ -5,7 +5,8 @@
  * 作为游戏的入口场景，负责：
  * - 创建并初始化GameView
  * - 创建并初始化GameController
- * - 启动游戏
+ * - 从关卡缓存取得关卡并启动游戏
+ * - 过关后在胜利展示期间分帧构建下一关的场景，构建完成后切换
  */
 
 #ifndef __GAME_SCENE_H__
@@ -14,6 +15,7 @@
 #include "cocos2d.h"
 #include "views/GameView.h"
 #include "controllers/GameController.h"
+#include "managers/LevelConfigCache.h"
 #include <memory>
 
 /**
@@ -27,22 +29,120 @@ class GameScene : public cocos2d::Scene
 public:
     /**
      * @brief 创建场景
+     * @param levelCache 关卡缓存（生命周期须长于场景）
+     * @param levelArenaPool 关卡内存池（生命周期须长于场景）
      * @return 场景实例
      */
-    static cocos2d::Scene* createScene();
+    static cocos2d::Scene* createScene(LevelConfigCache* levelCache, LevelArenaPool* levelArenaPool);
     
     /**
-     * @brief 初始化
+     * @brief 创建并初始化场景
+     * @param levelCache 关卡缓存（生命周期须长于场景）
+     * @param levelArenaPool 关卡内存池（生命周期须长于场景）
+     * @return 场景实例，失败返回nullptr
+     */
+    static GameScene* create(LevelConfigCache* levelCache, LevelArenaPool* levelArenaPool);
+    
+    /**
+     * @brief 创建用于预先构建的场景：只创建视图和控制器，关卡由prepareLevel加载
+     * @param levelCache 关卡缓存（生命周期须长于场景）
+     * @param levelArenaPool 关卡内存池（生命周期须长于场景）
+     * @return 场景实例，卡牌视图须由buildStep逐帧构建
+     */
+    static GameScene* createForPrebuild(LevelConfigCache* levelCache, LevelArenaPool* levelArenaPool);
+    
+    /**
+     * @brief 构造函数
+     * @param levelCache 关卡缓存
+     * @param levelArenaPool 关卡内存池
+     */
+    GameScene(LevelConfigCache* levelCache, LevelArenaPool* levelArenaPool);
+    virtual ~GameScene();
+    
+    /**
+     * @brief 初始化（恢复快照中的对局，没有快照时开始第1关）
      * @return 初始化成功返回true
      */
     virtual bool init() override;
     
-    // 实现静态create方法
-    CREATE_FUNC(GameScene);
+    /**
+     * @brief 加载并开始关卡（预先构建的场景使用，卡牌视图之后由buildStep创建）
+     * @param levelId 关卡ID
+     * @return 成功返回true
+     */
+    bool prepareLevel(int levelId);
+    
+    /**
+     * @brief 在时间预算内继续构建卡牌视图
+     * @param budgetSeconds 本帧最多占用的时间（秒）
+     * @return 全部构建完成返回true
+     */
+    bool buildStep(float budgetSeconds);
+    
+    /**
+     * @brief 保存当前对局快照（切后台时调用）
+     * @return 保存成功返回true
+     */
+    bool saveGameSnapshot();
+
+private:
+    /**
+     * @brief 下一关场景的构建阶段，每帧推进一步
+     */
+    enum class NextLevelStage
+    {
+        IDLE,           ///< 未开始
+        CREATE_SCENE,   ///< 创建场景、视图和控制器
+        LOAD_LEVEL,     ///< 加载关卡配置并生成模型
+        BUILD_VIEWS,    ///< 分帧创建卡牌视图
+        READY,          ///< 构建完成，等待胜利展示结束
+        FINISHED        ///< 已切换或无法构建（最后一关、加载失败）
+    };
+    
+    /**
+     * @brief 创建视图和控制器
+     * @param isIncrementalBuild 是否分帧构建卡牌视图
+     * @return 成功返回true
+     */
+    bool initGameObjects(bool isIncrementalBuild);
+    
+    /**
+     * @brief 从关卡缓存取得关卡并开始游戏
+     * @param levelId 关卡ID
+     * @return 成功返回true
+     */
+    bool startLevel(int levelId);
+    
+    /**
+     * @brief 过关：开始在后台构建下一关的场景
+     */
+    void onLevelCleared();
+    
+    /**
+     * @brief 每帧推进下一关的构建，完成且胜利展示结束后切换场景
+     * @param dt 帧间隔
+     */
+    void updateNextLevel(float dt);
+    
+    /**
+     * @brief 停止构建并释放下一关的场景
+     */
+    void finishNextLevel();
+    
+    /**
+     * @brief 过关后重玩或撤销：取消下一关的构建，回到未开始状态，再次过关时重新构建
+     */
+    void cancelNextLevel();
 
 private:
     GameView* _gameView;                            // 游戏视图
     std::unique_ptr<GameController> _gameController; // 游戏控制器
+    LevelConfigCache* _levelCache;                  // 关卡缓存（不持有）
+    LevelArenaPool* _levelArenaPool;                // 关卡内存池（不持有）
+    int _levelId;                                   // 当前关卡ID，未知（测试数据、无录像的快照）为0
+    GameScene* _nextScene;                          // 构建中的下一关场景（持有引用）
+    NextLevelStage _nextLevelStage;                 // 下一关的构建阶段
+    float _celebrationTime;                         // 过关后已展示的时长（秒）
 };
 
 #endif // __GAME_SCENE_H__
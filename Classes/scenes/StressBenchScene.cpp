@@ -0,0 +1,254 @@
+/**
+ * @file StressBenchScene.cpp
+ * @brief 大牌面基准场景实现
+ */
+
+#include "scenes/StressBenchScene.h"
+#include "configs/CardTypes.h"
+#include "services/GameModelGenerator.h"
+#include "services/StressLayoutGenerator.h"
+#include <algorithm>
+#include <random>
+#include <sstream>
+
+USING_NS_CC;
+
+namespace
+{
+    /// 布局的重叠密度（每张牌平均重叠数）
+    const float kOverlapDensity = 2.0f;
+    
+    /// 构建后跳过的预热帧数
+    const int kWarmupFrames = 10;
+    
+    /// 每个规模测量的帧数
+    const int kMeasureFrames = 120;
+    
+    /// 每个规模注入的点击次数
+    const int kTapCount = 64;
+    
+    using Clock = std::chrono::steady_clock;
+    
+    double elapsedMs(Clock::time_point begin)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+    }
+}
+
+Scene* StressBenchScene::createScene()
+{
+    return StressBenchScene::create();
+}
+
+bool StressBenchScene::init()
+{
+    if (!Scene::init())
+    {
+        return false;
+    }
+    
+    _sizes = { 100, 300, 1000, 3000, 10000 };
+    _stepIndex = 0;
+    _phase = Phase::BUILD;
+    _frameIndex = 0;
+    _frameTotalMs = 0.0;
+    
+    _playFieldView = PlayFieldView::create();
+    if (!_playFieldView)
+    {
+        CCLOG("StressBenchScene: Failed to create PlayFieldView");
+        return false;
+    }
+    _playFieldView->setPosition(Vec2(0, GameConstants::kStackAreaHeight));
+    this->addChild(_playFieldView, 0);
+    
+    _statusLabel = Label::createWithSystemFont("", "Arial", 28);
+    _statusLabel->setAnchorPoint(Vec2(0, 1));
+    _statusLabel->setPosition(Vec2(20, GameConstants::kStackAreaHeight - 20));
+    this->addChild(_statusLabel, 1);
+    
+    // 尽量不受垂直同步限制，帧间隔更能反映实际开销
+    Director::getInstance()->setAnimationInterval(1.0f / 240);
+    this->scheduleUpdate();
+    return true;
+}
+
+void StressBenchScene::update(float dt)
+{
+    switch (_phase)
+    {
+        case Phase::BUILD:
+        {
+            if (!buildStep())
+            {
+                _phase = Phase::DONE;
+                return;
+            }
+            _phase = Phase::FRAMES;
+            _frameIndex = -kWarmupFrames;
+            _frameTotalMs = 0.0;
+            _current.worstFrameMs = 0.0;
+            _lastFrameTime = Clock::now();
+            break;
+        }
+        
+        case Phase::FRAMES:
+        {
+            // 相邻两次update的间隔包含上一帧的绘制
+            Clock::time_point now = Clock::now();
+            double frameMs = std::chrono::duration<double, std::milli>(now - _lastFrameTime).count();
+            _lastFrameTime = now;
+            if (_frameIndex >= 0)
+            {
+                _frameTotalMs += frameMs;
+                _current.worstFrameMs = std::max(_current.worstFrameMs, frameMs);
+            }
+            _frameIndex++;
+            if (_frameIndex >= kMeasureFrames)
+            {
+                finishStep();
+            }
+            break;
+        }
+        
+        case Phase::DONE:
+            break;
+    }
+}
+
+bool StressBenchScene::buildStep()
+{
+    StressLayoutParams params;
+    params.seed = static_cast<uint32_t>(_stepIndex + 1);
+    params.playfieldCardCount = _sizes[_stepIndex];
+    params.overlapDensity = kOverlapDensity;
+    
+    LevelConfig levelConfig;
+    if (!StressLayoutGenerator::generate(params, levelConfig))
+    {
+        CCLOG("StressBenchScene: Failed to generate layout with %d cards", params.playfieldCardCount);
+        return false;
+    }
+    
+    _current = StepResult();
+    _current.cardCount = params.playfieldCardCount;
+    
+    // 模型构建（按位置检测遮挡）
+    Clock::time_point begin = Clock::now();
+    if (!GameModelGenerator::generate(levelConfig, _gameModel))
+    {
+        return false;
+    }
+    _current.buildModelMs = elapsedMs(begin);
+    
+    // 视图构建
+    begin = Clock::now();
+    _playFieldView->initCards(&_gameModel);
+    _current.buildViewMs = elapsedMs(begin);
+    
+    // 整个布局缩放到主牌区内
+    Rect bounds = StressLayoutGenerator::computeLayoutBounds(levelConfig);
+    float scale = std::min(1.0f, std::min(GameConstants::kPlayFieldWidth / bounds.size.width,
+                                          GameConstants::kPlayFieldHeight / bounds.size.height));
+    _playFieldView->setScale(scale);
+    _playFieldView->setPosition(Vec2(-bounds.origin.x * scale,
+                                     GameConstants::kStackAreaHeight - bounds.origin.y * scale));
+    
+    // 可点击状态更新：先模型，再逐张刷新视图（与控制器走牌后相同）
+    begin = Clock::now();
+    GameModelGenerator::updatePlayfieldClickable(_gameModel);
+    _current.clickableModelMs = elapsedMs(begin);
+    
+    begin = Clock::now();
+    for (const auto& card : _gameModel.getPlayfieldCards())
+    {
+        _playFieldView->updateCardView(card);
+    }
+    _current.clickableViewMs = elapsedMs(begin);
+    
+    // 触摸分发：点在随机卡牌中心，首次分发会先给全部监听器排序
+    const auto& cards = _gameModel.getPlayfieldCards();
+    std::mt19937 rng(params.seed);
+    begin = Clock::now();
+    injectTap(_playFieldView->convertToWorldSpace(cards.getCard(rng() % cards.slotCount()).getPosition()));
+    _current.firstTouchUs = elapsedMs(begin) * 1000.0;
+    
+    begin = Clock::now();
+    for (int i = 0; i < kTapCount; i++)
+    {
+        injectTap(_playFieldView->convertToWorldSpace(cards.getCard(rng() % cards.slotCount()).getPosition()));
+    }
+    _current.touchUs = elapsedMs(begin) * 1000.0 / kTapCount;
+    
+    _statusLabel->setString(StringUtils::format("Measuring %d cards...", _current.cardCount));
+    return true;
+}
+
+void StressBenchScene::injectTap(const Vec2& worldPos)
+{
+    // 与平台层相同，从GLView入口注入：屏幕坐标以左上角为原点，按视口缩放
+    GLView* glView = Director::getInstance()->getOpenGLView();
+    if (!glView)
+    {
+        return;
+    }
+    Vec2 uiPos = Director::getInstance()->convertToUI(worldPos);
+    const Rect& viewPort = glView->getViewPortRect();
+    intptr_t touchId = 0;
+    float x = uiPos.x * glView->getScaleX() + viewPort.origin.x;
+    float y = uiPos.y * glView->getScaleY() + viewPort.origin.y;
+    glView->handleTouchesBegin(1, &touchId, &x, &y);
+    glView->handleTouchesEnd(1, &touchId, &x, &y);
+}
+
+void StressBenchScene::finishStep()
+{
+    _current.averageFrameMs = _frameTotalMs / kMeasureFrames;
+    _results.push_back(_current);
+    CCLOG("StressBenchScene: %d cards, model %.2f ms, view %.2f ms, clickable %.2f+%.2f ms, "
+          "touch %.1f us (first %.1f us), frame %.2f ms (worst %.2f ms)",
+          _current.cardCount, _current.buildModelMs, _current.buildViewMs,
+          _current.clickableModelMs, _current.clickableViewMs,
+          _current.touchUs, _current.firstTouchUs, _current.averageFrameMs, _current.worstFrameMs);
+    
+    _stepIndex++;
+    if (_stepIndex < _sizes.size())
+    {
+        _phase = Phase::BUILD;
+        return;
+    }
+    
+    _phase = Phase::DONE;
+    writeResults();
+    
+    std::ostringstream summary;
+    summary << "cards  view ms  touch us  frame ms\n";
+    for (const auto& result : _results)
+    {
+        summary << StringUtils::format("%5d  %7.1f  %8.1f  %8.2f\n", result.cardCount,
+                                       result.buildViewMs, result.touchUs, result.averageFrameMs);
+    }
+    _statusLabel->setString(summary.str());
+}
+
+void StressBenchScene::writeResults() const
+{
+    std::ostringstream csv;
+    csv << "cards,build_model_ms,build_view_ms,clickable_model_ms,clickable_view_ms,"
+           "first_touch_us,touch_us,avg_frame_ms,worst_frame_ms\n";
+    for (const auto& result : _results)
+    {
+        csv << result.cardCount << ',' << result.buildModelMs << ',' << result.buildViewMs << ','
+            << result.clickableModelMs << ',' << result.clickableViewMs << ','
+            << result.firstTouchUs << ',' << result.touchUs << ','
+            << result.averageFrameMs << ',' << result.worstFrameMs << '\n';
+    }
+    
+    std::string path = FileUtils::getInstance()->getWritablePath() + "stress_bench.csv";
+    if (!FileUtils::getInstance()->writeStringToFile(csv.str(), path))
+    {
+        CCLOG("StressBenchScene: Failed to write %s", path.c_str());
+        return;
+    }
+    CCLOG("StressBenchScene: Results written to %s", path.c_str());
+}
@@ -0,0 +1,118 @@
+/**
+ * @file StressBenchScene.h
+ * @brief 大牌面基准场景
+ * 
+ * 依次用100到10000张牌的压力布局构建主牌区，测量真实引擎下的：
+ * - 模型构建与PlayFieldView构建耗时
+ * - 可点击状态更新（模型+视图）耗时
+ * - 经GLView入口注入触摸时的分发耗时（首次含监听器排序）
+ * - 稳定后的帧间隔
+ * 结果输出到日志并写入可写目录下的stress_bench.csv。
+ * 只在以PLAYINGCARDS_STRESS_BENCH=1编译时由AppDelegate启动，无界面的对应工具为bench_stress。
+ */
+
+#ifndef __STRESS_BENCH_SCENE_H__
+#define __STRESS_BENCH_SCENE_H__
+
+#ifndef PLAYINGCARDS_STRESS_BENCH
+#define PLAYINGCARDS_STRESS_BENCH 0
+#endif
+
+#include "cocos2d.h"
+#include "models/GameModel.h"
+#include "views/PlayFieldView.h"
+#include <chrono>
+#include <vector>
+
+/**
+ * @brief 大牌面基准场景类
+ * 
+ * 每个规模先在一帧内完成构建和单次测量，再空跑若干帧测帧间隔，然后进入下一个规模。
+ */
+class StressBenchScene : public cocos2d::Scene
+{
+public:
+    /**
+     * @brief 创建场景
+     * @return 场景实例
+     */
+    static cocos2d::Scene* createScene();
+    
+    /**
+     * @brief 初始化
+     * @return 初始化成功返回true
+     */
+    virtual bool init() override;
+    
+    /**
+     * @brief 每帧推进测量流程
+     * @param dt 帧间隔
+     */
+    virtual void update(float dt) override;
+    
+    // 实现静态create方法
+    CREATE_FUNC(StressBenchScene);
+
+private:
+    /**
+     * @brief 单个规模的测量结果
+     */
+    struct StepResult
+    {
+        int cardCount;
+        double buildModelMs;        ///< 模型构建
+        double buildViewMs;         ///< 主牌区视图构建
+        double clickableModelMs;    ///< 模型可点击状态更新
+        double clickableViewMs;     ///< 全部卡牌视图刷新
+        double firstTouchUs;        ///< 构建后首次触摸（含监听器排序）
+        double touchUs;             ///< 之后每次触摸的平均分发耗时
+        double averageFrameMs;      ///< 平均帧间隔
+        double worstFrameMs;        ///< 最长帧间隔
+    };
+    
+    /**
+     * @brief 构建当前规模的布局，并完成不依赖帧的测量
+     * @return 构建成功返回true
+     */
+    bool buildStep();
+    
+    /**
+     * @brief 经GLView注入一次点击（按下+抬起）
+     * @param worldPos 点击位置（世界坐标）
+     */
+    void injectTap(const cocos2d::Vec2& worldPos);
+    
+    /**
+     * @brief 当前规模测量完毕，记录结果并进入下一个规模
+     */
+    void finishStep();
+    
+    /**
+     * @brief 把全部结果写入CSV文件
+     */
+    void writeResults() const;
+
+private:
+    enum class Phase
+    {
+        BUILD,      ///< 下一帧构建
+        FRAMES,     ///< 测量帧间隔
+        DONE        ///< 全部完成
+    };
+    
+    std::vector<int> _sizes;                    ///< 待测的主牌区牌数
+    size_t _stepIndex;                          ///< 当前规模下标
+    Phase _phase;                               ///< 当前阶段
+    
+    GameModel _gameModel;                       ///< 当前布局的模型
+    PlayFieldView* _playFieldView;              ///< 主牌区视图
+    cocos2d::Label* _statusLabel;               ///< 进度与结果显示
+    
+    StepResult _current;                        ///< 当前规模的结果
+    std::vector<StepResult> _results;           ///< 已完成的结果
+    int _frameIndex;                            ///< 帧计数，负数为预热帧
+    double _frameTotalMs;                       ///< 累计帧间隔
+    std::chrono::steady_clock::time_point _lastFrameTime; ///< 上一帧时刻
+};
+
+#endif // __STRESS_BENCH_SCENE_H__
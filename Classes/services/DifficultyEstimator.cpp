@@ -0,0 +1,300 @@
+/**
+ * @file DifficultyEstimator.cpp
+ * @brief 关卡难度评估服务实现
+ */
+
+#include "services/DifficultyEstimator.h"
+#include "services/GameModelGenerator.h"
+#include "services/GameRules.h"
+#include "services/LevelCompiler.h"
+#include "utils/DeterministicRandom.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /// 95%置信度对应的正态分位数
+    const double kZ95 = 1.959963984540054;
+    
+    /// 单局步数上限（无回退时步数不会超过卡牌总数，仅作保护）
+    const int kMaxPlayoutMoves = 100000;
+    
+    /**
+     * @brief 统计移走某张牌后会被解除遮挡的卡牌数量
+     * @param gameModel 游戏模型
+     * @param cardId 被移走的卡牌ID
+     */
+    int countUncoveredBy(const GameModel& gameModel, int cardId)
+    {
+        // 已关联预编译数据时只看该牌遮挡的卡牌：遮挡者只剩它一张的即会被解除遮挡
+        const auto& compiled = gameModel.getCompiledPlayfield();
+        if (compiled)
+        {
+            int count = 0;
+            for (int covered : (*compiled)[cardId].covers)
+            {
+                if (gameModel.getBlockerCount(covered) == 1 && gameModel.hasPlayfieldCard(covered))
+                {
+                    count++;
+                }
+            }
+            return count;
+        }
+        
+        // 未编译时两两比较坐标，只读取坐标和标志位列
+        const PlayfieldCardArray& cards = gameModel.getPlayfieldCards();
+        const size_t slot = static_cast<size_t>(cards.findSlot(cardId));
+        const int16_t* xs = cards.getXs().data();
+        const int16_t* ys = cards.getYs().data();
+        auto covers = [xs, ys](size_t upper, size_t lower) {
+            return GameModelGenerator::isCoveringAt(xs[upper], ys[upper], xs[lower], ys[lower]);
+        };
+        
+        int count = 0;
+        for (size_t lower = 0; lower < cards.slotCount(); lower++)
+        {
+            if (!cards.isOccupied(lower) || cards.isClickable(lower) || !covers(slot, lower))
+            {
+                continue;
+            }
+            
+            // 除了该牌之外没有其他遮挡者
+            bool stillCovered = false;
+            for (size_t other = 0; other < cards.slotCount(); other++)
+            {
+                if (other != slot && other != lower && cards.isOccupied(other) && covers(other, lower))
+                {
+                    stillCovered = true;
+                    break;
+                }
+            }
+            count += stillCovered ? 0 : 1;
+        }
+        return count;
+    }
+    
+    /**
+     * @brief 单线程累计的统计量（整数求和，合并后与顺序无关）
+     */
+    struct PartialStats
+    {
+        int samples = 0;
+        int wins = 0;
+        int64_t moveSum = 0;
+        int64_t moveSquareSum = 0;
+        int64_t clearedSum = 0;
+    };
+}
+
+template <typename Rule>
+PlayoutResult DifficultyEstimator::runPlayout(const GameModel& initialModel, PlayoutPolicy policy,
+                                              uint32_t seed, uint32_t streamId)
+{
+    GameModel gameModel = initialModel;
+    DeterministicRandom rng = DeterministicRandom::forStream(seed, streamId);
+    size_t initialCount = initialModel.getPlayfieldCardCount();
+    
+    // 合法操作缓冲区按上限一次分配，之后每步不再分配
+    std::vector<GameMove> moves(GameRules::getMaxMoveCount(initialModel));
+    AppliedMove applied;
+    
+    PlayoutResult result;
+    result.isWin = false;
+    result.moveCount = 0;
+    
+    while (result.moveCount < kMaxPlayoutMoves)
+    {
+        if (GameRules::isWin(gameModel))
+        {
+            result.isWin = true;
+            break;
+        }
+        
+        size_t moveCount = GameRules::generateMoves<Rule>(gameModel, moves.data(), moves.size());
+        if (moveCount == 0)
+        {
+            break;
+        }
+        
+        // 翻牌总在最后，前面都是主牌区的牌
+        int drawIndex = moves[moveCount - 1].type == CardOperationType::RESERVE_TO_STACK
+            ? static_cast<int>(moveCount) - 1
+            : -1;
+        int candidateCount = drawIndex >= 0 ? drawIndex : static_cast<int>(moveCount);
+        int choice = drawIndex;
+        switch (policy)
+        {
+            case PlayoutPolicy::RANDOM:
+            {
+                choice = rng.nextBelow(static_cast<int>(moveCount));
+                break;
+            }
+            
+            case PlayoutPolicy::GREEDY:
+            {
+                if (candidateCount > 0)
+                {
+                    choice = rng.nextBelow(candidateCount);
+                }
+                break;
+            }
+            
+            case PlayoutPolicy::UNCOVER:
+            {
+                // 解除遮挡最多的牌优先，并列时随机
+                int bestScore = -1;
+                int tieCount = 0;
+                for (int i = 0; i < candidateCount; i++)
+                {
+                    int score = countUncoveredBy(gameModel, moves[i].cardId);
+                    if (score > bestScore)
+                    {
+                        bestScore = score;
+                        choice = i;
+                        tieCount = 1;
+                    }
+                    else if (score == bestScore && rng.nextBelow(++tieCount) == 0)
+                    {
+                        choice = i;
+                    }
+                }
+                break;
+            }
+        }
+        
+        GameRules::applyMove<Rule>(gameModel, moves[choice], applied);
+        result.moveCount++;
+    }
+    
+    result.clearedCount = static_cast<int>(initialCount - gameModel.getPlayfieldCardCount());
+    return result;
+}
+
+bool DifficultyEstimator::estimate(const LevelConfig& levelConfig,
+                                   const DifficultyParams& params,
+                                   DifficultyEstimate& outEstimate)
+{
+    // 只在这里按规则分派一次
+    return MatchRules::dispatch(params.rule, [&](auto rule) {
+        return estimateWithRule<decltype(rule)>(levelConfig, params, outEstimate);
+    });
+}
+
+template <typename Rule>
+bool DifficultyEstimator::estimateWithRule(const LevelConfig& levelConfig,
+                                           const DifficultyParams& params,
+                                           DifficultyEstimate& outEstimate)
+{
+    outEstimate = DifficultyEstimate();
+    if (params.sampleCount <= 0)
+    {
+        return false;
+    }
+    
+    // 未编译的关卡先编译一次，模拟中每步的可点击状态增量更新，不再逐步全量扫描
+    const LevelConfig* playoutConfig = &levelConfig;
+    LevelConfig compiledConfig;
+    if (!levelConfig.isCompiled())
+    {
+        compiledConfig = levelConfig;
+        if (!LevelCompiler::compile(compiledConfig))
+        {
+            return false;
+        }
+        playoutConfig = &compiledConfig;
+    }
+    
+    GameModel initialModel;
+    if (!GameModelGenerator::generate(*playoutConfig, initialModel))
+    {
+        return false;
+    }
+    
+    int threadCount = params.threadCount > 0
+        ? params.threadCount
+        : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    threadCount = std::min(threadCount, params.sampleCount);
+    
+    // 按样本下标交错分配给各线程，每个线程只写自己的统计量
+    std::vector<PartialStats> partials(threadCount);
+    auto worker = [&](int threadIndex) {
+        PartialStats& stats = partials[threadIndex];
+        for (int i = threadIndex; i < params.sampleCount; i += threadCount)
+        {
+            // 每个样本使用以样本下标编号的独立随机数流
+            PlayoutResult playout = runPlayout<Rule>(initialModel, params.policy, params.seed, static_cast<uint32_t>(i));
+            stats.samples++;
+            stats.wins += playout.isWin ? 1 : 0;
+            stats.moveSum += playout.moveCount;
+            stats.moveSquareSum += static_cast<int64_t>(playout.moveCount) * playout.moveCount;
+            stats.clearedSum += playout.clearedCount;
+        }
+    };
+    
+    std::vector<std::thread> threads;
+    for (int t = 1; t < threadCount; t++)
+    {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    
+    PartialStats total;
+    for (const auto& stats : partials)
+    {
+        total.samples += stats.samples;
+        total.wins += stats.wins;
+        total.moveSum += stats.moveSum;
+        total.moveSquareSum += stats.moveSquareSum;
+        total.clearedSum += stats.clearedSum;
+    }
+    
+    double n = total.samples;
+    double p = total.wins / n;
+    
+    // Wilson得分区间：样本少或胜率接近0/1时比正态近似可靠
+    double z2 = kZ95 * kZ95;
+    double denominator = 1.0 + z2 / n;
+    double center = (p + z2 / (2.0 * n)) / denominator;
+    double margin = kZ95 * std::sqrt(p * (1.0 - p) / n + z2 / (4.0 * n * n)) / denominator;
+    
+    double meanMoves = total.moveSum / n;
+    double variance = n > 1 ? (total.moveSquareSum - n * meanMoves * meanMoves) / (n - 1) : 0.0;
+    
+    outEstimate.sampleCount = total.samples;
+    outEstimate.winCount = total.wins;
+    outEstimate.winRate = p;
+    outEstimate.winRateLow = std::max(0.0, center - margin);
+    outEstimate.winRateHigh = std::min(1.0, center + margin);
+    outEstimate.averageMoves = meanMoves;
+    outEstimate.averageMovesMargin = kZ95 * std::sqrt(std::max(variance, 0.0) / n);
+    outEstimate.averageClearedRatio = initialModel.getPlayfieldCardCount() > 0
+        ? total.clearedSum / (n * initialModel.getPlayfieldCardCount())
+        : 1.0;
+    return true;
+}
+
+const char* DifficultyEstimator::getPolicyName(PlayoutPolicy policy)
+{
+    switch (policy)
+    {
+        case PlayoutPolicy::RANDOM:  return "random";
+        case PlayoutPolicy::GREEDY:  return "greedy";
+        case PlayoutPolicy::UNCOVER: return "uncover";
+        default: return "unknown";
+    }
+}
+
+// ========== 显式实例化 ==========
+
+#define DIFFICULTY_ESTIMATOR_INSTANTIATE(Rule) \
+    template PlayoutResult DifficultyEstimator::runPlayout<Rule>(const GameModel&, PlayoutPolicy, uint32_t, uint32_t);
+
+PLAYINGCARDS_FOR_EACH_MATCH_RULE(DIFFICULTY_ESTIMATOR_INSTANTIATE)
+
+#undef DIFFICULTY_ESTIMATOR_INSTANTIATE
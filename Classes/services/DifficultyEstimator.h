@@ -0,0 +1,144 @@
+/**
+ * @file DifficultyEstimator.h
+ * @brief 关卡难度评估服务
+ * 
+ * 用大量随机对局（蒙特卡洛模拟）估计关卡的胜率和平均步数，
+ * 多线程并行执行，并给出95%置信区间。
+ */
+
+#ifndef __DIFFICULTY_ESTIMATOR_H__
+#define __DIFFICULTY_ESTIMATOR_H__
+
+#include "configs/LevelConfig.h"
+#include "models/GameModel.h"
+#include "utils/MatchRules.h"
+#include <cstdint>
+
+/**
+ * @brief 模拟对局的出牌策略
+ */
+enum class PlayoutPolicy
+{
+    RANDOM = 0,     ///< 在所有合法操作（含翻牌）中均匀随机
+    GREEDY,         ///< 有可匹配的牌就随机出一张，没有才翻牌（接近普通玩家）
+    UNCOVER         ///< 同GREEDY，但优先出能解除遮挡最多的牌
+};
+
+/**
+ * @brief 难度评估参数
+ */
+struct DifficultyParams
+{
+    PlayoutPolicy policy;           ///< 出牌策略
+    MatchRules::RuleType rule;      ///< 匹配规则
+    int sampleCount;                ///< 模拟对局数量
+    uint32_t seed;                  ///< 随机种子，结果与线程数无关
+    int threadCount;                ///< 线程数，0表示使用全部核心
+    
+    DifficultyParams()
+        : policy(PlayoutPolicy::GREEDY)
+        , rule(MatchRules::RuleType::ADJACENT_RANK)
+        , sampleCount(2000)
+        , seed(1)
+        , threadCount(0)
+    {
+    }
+};
+
+/**
+ * @brief 难度评估结果
+ */
+struct DifficultyEstimate
+{
+    int sampleCount;            ///< 实际模拟的对局数量
+    int winCount;               ///< 获胜局数
+    double winRate;             ///< 胜率
+    double winRateLow;          ///< 胜率95%置信区间下限（Wilson区间）
+    double winRateHigh;         ///< 胜率95%置信区间上限
+    double averageMoves;        ///< 平均步数（出牌和翻牌都计一步）
+    double averageMovesMargin;  ///< 平均步数95%置信区间半宽
+    double averageClearedRatio; ///< 平均消除的主牌区比例
+    
+    DifficultyEstimate()
+        : sampleCount(0)
+        , winCount(0)
+        , winRate(0.0)
+        , winRateLow(0.0)
+        , winRateHigh(0.0)
+        , averageMoves(0.0)
+        , averageMovesMargin(0.0)
+        , averageClearedRatio(0.0)
+    {
+    }
+};
+
+/**
+ * @brief 单局模拟结果
+ */
+struct PlayoutResult
+{
+    bool isWin;             ///< 是否获胜
+    int moveCount;          ///< 步数
+    int clearedCount;       ///< 消除的主牌区卡牌数量
+};
+
+/**
+ * @brief 关卡难度评估服务类
+ * 
+ * 模拟对局直接使用GameRules，与游戏内规则一致。
+ * 匹配规则只在estimate入口分派一次，模拟对局按规则实例化，内层循环没有规则分支。
+ * 第i局的随机序列只由种子和i决定，因此结果不受线程数和调度顺序影响。
+ * 符合services层的设计规范：无状态、可静态调用。
+ */
+class DifficultyEstimator
+{
+public:
+    /**
+     * @brief 评估关卡难度
+     * @param levelConfig 关卡配置
+     * @param params 评估参数
+     * @param outEstimate 输出的评估结果
+     * @return 关卡有效且参数合法返回true
+     * 
+     * 未编译的关卡在模拟前编译一份副本，各线程共享其遮挡数据。
+     */
+    static bool estimate(const LevelConfig& levelConfig,
+                         const DifficultyParams& params,
+                         DifficultyEstimate& outEstimate);
+    
+    /**
+     * @brief 从指定局面模拟一局直到获胜或无路可走
+     * @tparam Rule 匹配规则
+     * @param initialModel 初始局面
+     * @param policy 出牌策略
+     * @param seed 随机种子
+     * @param streamId 随机数流编号（如样本下标），同一种子下不同编号的对局互不相关
+     * @return 单局结果
+     */
+    template <typename Rule = MatchRules::Default>
+    static PlayoutResult runPlayout(const GameModel& initialModel, PlayoutPolicy policy,
+                                    uint32_t seed, uint32_t streamId);
+    
+    /**
+     * @brief 获取策略名称
+     * @param policy 出牌策略
+     * @return 名称字符串
+     */
+    static const char* getPolicyName(PlayoutPolicy policy);
+
+private:
+    /**
+     * @brief 私有构造函数，禁止实例化
+     */
+    DifficultyEstimator() = delete;
+    
+    /**
+     * @brief 按指定匹配规则评估关卡难度（estimate分派后调用）
+     */
+    template <typename Rule>
+    static bool estimateWithRule(const LevelConfig& levelConfig,
+                                 const DifficultyParams& params,
+                                 DifficultyEstimate& outEstimate);
+};
+
+#endif // __DIFFICULTY_ESTIMATOR_H__
@@ -4,12 +4,18 @@
  */
 
 #include "services/GameModelGenerator.h"
+#include "services/LevelCompiler.h"
+#include "utils/DeterministicRandom.h"
+#include "utils/TraceProfiler.h"
 #include "cocos2d.h"
+#include <cstdlib>
+#include <vector>
 
 USING_NS_CC;
 
 bool GameModelGenerator::generate(const LevelConfig& levelConfig, GameModel& outGameModel)
 {
+    TRACE_SCOPE("model", "GameModelGenerator::generate");
     if (!levelConfig.isValid())
     {
         CCLOG("GameModelGenerator: Invalid level config");
@@ -18,8 +24,11 @@ bool GameModelGenerator::generate(const LevelConfig& levelConfig, GameModel& out
     
     outGameModel.clear();
     
-    // 生成主牌区卡牌
+    // 按关卡的牌数一次性预留空间，逐张加入时不再扩容（使用关卡内存池时扩容会浪费旧空间）
     const auto& playfieldConfigs = levelConfig.getPlayfieldCards();
+    outGameModel.reserve(playfieldConfigs.size(), levelConfig.getStackCards().size());
+    
+    // 生成主牌区卡牌
     for (const auto& config : playfieldConfigs)
     {
         int cardId = outGameModel.getNextCardId();
@@ -29,8 +38,11 @@ bool GameModelGenerator::generate(const LevelConfig& levelConfig, GameModel& out
         outGameModel.addPlayfieldCard(card);
     }
     
-    // 更新可点击状态（基于遮挡检测）
-    updatePlayfieldClickable(outGameModel);
+    // 更新可点击状态：已编译的关卡直接使用预计算的遮挡关系，否则按位置检测
+    if (!levelConfig.isCompiled() || !outGameModel.setCompiledPlayfield(levelConfig.getCompiledPlayfield()))
+    {
+        updatePlayfieldClickable(outGameModel);
+    }
     
     // 生成备用牌堆卡牌
     const auto& stackConfigs = levelConfig.getStackCards();
@@ -40,8 +52,26 @@ bool GameModelGenerator::generate(const LevelConfig& levelConfig, GameModel& out
         return false;
     }
     
+    // 发牌顺序：默认按配置顺序；有发牌种子时整副牌按(种子, 关卡ID)的随机数流洗乱，
+    // 两者都取自关卡文件（加载器要求带种子的文件写明LevelId），与加载它的工具或缓存无关
+    std::vector<int> dealOrder;
+    if (levelConfig.getDealSeed() != 0)
+    {
+        dealOrder.resize(stackConfigs.size());
+        for (size_t i = 0; i < dealOrder.size(); i++)
+        {
+            dealOrder[i] = static_cast<int>(i);
+        }
+        DeterministicRandom rng = DeterministicRandom::forStream(levelConfig.getDealSeed(),
+                                                                 static_cast<uint32_t>(levelConfig.getLevelId()));
+        rng.shuffle(dealOrder.begin(), dealOrder.end());
+    }
+    auto dealtConfig = [&stackConfigs, &dealOrder](size_t index) -> const CardConfigData& {
+        return stackConfigs[dealOrder.empty() ? index : dealOrder[index]];
+    };
+    
     // 第一张牌作为初始顶部牌
-    const auto& firstStackConfig = stackConfigs[0];
+    const auto& firstStackConfig = dealtConfig(0);
     int topCardId = outGameModel.getNextCardId();
     CardModel topCard = createCardModel(firstStackConfig, topCardId, CardAreaType::STACK);
     topCard.setFaceUp(true);
@@ -52,15 +82,65 @@ bool GameModelGenerator::generate(const LevelConfig& levelConfig, GameModel& out
     for (size_t i = 1; i < stackConfigs.size(); i++)
     {
         int cardId = outGameModel.getNextCardId();
-        CardModel card = createCardModel(stackConfigs[i], cardId, CardAreaType::RESERVE);
+        CardModel card = createCardModel(dealtConfig(i), cardId, CardAreaType::RESERVE);
         card.setFaceUp(false);      // 备用牌背面朝上
         card.setClickable(false);
         outGameModel.addReserveCard(card);
     }
     
-    CCLOG("GameModelGenerator: Generated %zu playfield cards, 1 top card, %zu reserve cards",
-          outGameModel.getPlayfieldCardCount(), outGameModel.getReserveCardCount());
+    // 工具中每次回放、每局模拟都会调用，成功时不输出日志
+    return true;
+}
+
+bool GameModelGenerator::attachCompiledLevel(const LevelConfig& levelConfig, GameModel& gameModel)
+{
+    if (!levelConfig.isCompiled())
+    {
+        return false;
+    }
     
+    // 主牌区卡牌ID即关卡配置中的下标，剩余的每张牌须与配置一致
+    const auto& playfieldConfigs = levelConfig.getPlayfieldCards();
+    std::vector<CardModel> cards(playfieldConfigs.size());
+    std::vector<bool> isPresent(playfieldConfigs.size(), false);
+    for (const auto& card : gameModel.getPlayfieldCards())
+    {
+        int cardId = card.getCardId();
+        if (cardId < 0 || cardId >= static_cast<int>(playfieldConfigs.size()) || isPresent[cardId])
+        {
+            return false;
+        }
+        const CardConfigData& config = playfieldConfigs[cardId];
+        CardModel expected = createCardModel(config, cardId, CardAreaType::PLAYFIELD);
+        if (card.getFace() != expected.getFace() || card.getSuit() != expected.getSuit()
+            || card.getX() != expected.getX() || card.getY() != expected.getY())
+        {
+            return false;
+        }
+        cards[cardId] = card;
+        isPresent[cardId] = true;
+    }
+    
+    // 已消除的卡牌按配置补回，关联后再移除，槽位与卡牌ID一一对应
+    gameModel.clearPlayfield();
+    gameModel.reserve(playfieldConfigs.size(), gameModel.getReserveCardCount());
+    for (size_t cardId = 0; cardId < cards.size(); cardId++)
+    {
+        if (!isPresent[cardId])
+        {
+            cards[cardId] = createCardModel(playfieldConfigs[cardId], static_cast<int>(cardId), CardAreaType::PLAYFIELD);
+            cards[cardId].setFaceUp(true);
+        }
+        gameModel.addPlayfieldCard(cards[cardId]);
+    }
+    gameModel.setCompiledPlayfield(levelConfig.getCompiledPlayfield());
+    for (size_t cardId = 0; cardId < cards.size(); cardId++)
+    {
+        if (!isPresent[cardId])
+        {
+            gameModel.removePlayfieldCard(static_cast<int>(cardId));
+        }
+    }
     return true;
 }
 
@@ -146,8 +226,11 @@ bool GameModelGenerator::generateTestModel(GameModel& outGameModel)
         outGameModel.addReserveCard(card);
     }
     
-    // 更新可点击状态
-    updatePlayfieldClickable(outGameModel);
+    // 测试数据没有关卡配置，开局时编译一次，之后的规则操作按遮挡关系增量更新
+    if (!LevelCompiler::compileModel(outGameModel))
+    {
+        updatePlayfieldClickable(outGameModel);
+    }
     
     CCLOG("GameModelGenerator: Generated test model");
     return true;
@@ -165,64 +248,59 @@ CardModel GameModelGenerator::createCardModel(const CardConfigData& configData,
 
 bool GameModelGenerator::isCardOverlapping(const CardModel& card1, const CardModel& card2)
 {
-    // 获取卡牌尺寸
-    float cardWidth = GameConstants::kCardWidth;
-    float cardHeight = GameConstants::kCardHeight;
-    
-    // 获取两张卡牌的位置
-    Vec2 pos1 = card1.getPosition();
-    Vec2 pos2 = card2.getPosition();
-    
-    // 计算卡牌边界（位置是中心点）
-    float left1 = pos1.x - cardWidth / 2;
-    float right1 = pos1.x + cardWidth / 2;
-    float bottom1 = pos1.y - cardHeight / 2;
-    float top1 = pos1.y + cardHeight / 2;
-    
-    float left2 = pos2.x - cardWidth / 2;
-    float right2 = pos2.x + cardWidth / 2;
-    float bottom2 = pos2.y - cardHeight / 2;
-    float top2 = pos2.y + cardHeight / 2;
-    
-    // 检查是否有重叠（水平和垂直方向都有交集）
-    bool overlapX = (left1 < right2) && (right1 > left2);
-    bool overlapY = (bottom1 < top2) && (top1 > bottom2);
-    
-    return overlapX && overlapY;
+    // 位置是中心点，中心距离在两个方向上都小于牌的宽高即有交集
+    // 坐标为定点整数，比较是精确的，各平台结果一致
+    const int cardWidth = static_cast<int>(GameConstants::kCardWidth);
+    const int cardHeight = static_cast<int>(GameConstants::kCardHeight);
+    
+    int dx = card1.getX() - card2.getX();
+    int dy = card1.getY() - card2.getY();
+    return std::abs(dx) < cardWidth && std::abs(dy) < cardHeight;
 }
 
 void GameModelGenerator::updatePlayfieldClickable(GameModel& gameModel)
 {
-    auto& cards = gameModel.getPlayfieldCardsMutable();
+    TRACE_SCOPE("model", "GameModelGenerator::updatePlayfieldClickable");
+    // 关联了预编译数据的模型在添加、移除卡牌时已增量更新
+    if (gameModel.hasCompiledPlayfield())
+    {
+        return;
+    }
+    
+    // 只读取坐标和标志位列，判定与isCoveringAt相同，展开写成无分支形式
+    const PlayfieldCardArray& cards = gameModel.getPlayfieldCards();
+    const int16_t* xs = cards.getXs().data();
+    const int16_t* ys = cards.getYs().data();
+    const uint8_t* flags = cards.getFlags().data();
+    const int count = static_cast<int>(cards.slotCount());
+    const int cardWidth = static_cast<int>(GameConstants::kCardWidth);
+    const int cardHeight = static_cast<int>(GameConstants::kCardHeight);
     
-    // 遍历每张卡牌，检查是否被其他卡牌遮挡
-    for (auto& card : cards)
+    for (int i = 0; i < count; i++)
     {
-        bool isBlocked = false;
+        if (!cards.isOccupied(i))
+        {
+            continue;
+        }
+        const int x = xs[i];
+        const int y = ys[i];
         
-        // 检查是否被其他卡牌遮挡
-        // 在游戏中，y坐标较小的卡牌在上面（靠近玩家）
-        for (const auto& otherCard : cards)
+        // 内层不提前退出，循环体无分支，便于编译器向量化（自身因y不小于自身而不计入，空槽位不计入）
+        int blockerCount = 0;
+        for (int j = 0; j < count; j++)
         {
-            if (card.getCardId() == otherCard.getCardId())
-            {
-                continue;  // 跳过自己
-            }
-            
-            // 如果另一张卡牌的y坐标更小（在上面）且与当前卡牌重叠
-            if (otherCard.getPosition().y < card.getPosition().y)
-            {
-                if (isCardOverlapping(card, otherCard))
-                {
-                    isBlocked = true;
-                    break;
-                }
-            }
+            int dx = xs[j] - x;
+            int dy = ys[j] - y;
+            int occupied = (flags[j] & PlayfieldCardArray::kFlagOccupied) != 0;
+            blockerCount += occupied & (dy < 0) & (dx < cardWidth) & (dx > -cardWidth) & (dy > -cardHeight);
         }
         
-        // 设置可点击状态：未被遮挡的卡牌可以点击
-        card.setClickable(!isBlocked);
+        // 设置可点击状态：未被遮挡的卡牌可以点击（经由模型维护点数统计）
+        gameModel.setPlayfieldCardClickable(i, blockerCount == 0);
     }
-    
-    CCLOG("GameModelGenerator: Updated clickable state for %zu cards", cards.size());
+}
+
+bool GameModelGenerator::isCardCovering(const CardModel& upper, const CardModel& lower)
+{
+    return isCoveringAt(upper.getX(), upper.getY(), lower.getX(), lower.getY());
 }
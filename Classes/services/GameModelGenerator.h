@@ -27,12 +27,28 @@ public:
      * @param levelConfig 关卡配置
      * @param outGameModel 输出的游戏模型
      * @return 生成成功返回true
+     * 
+     * 关卡带发牌种子时，备用牌堆（含初始顶部牌）按种子和关卡ID洗乱后再发牌，
+     * 相同的种子和关卡ID在任何平台、任何线程中得到相同的牌序，两者都由关卡文件写明。
+     * 已编译的关卡生成的模型关联预编译数据；未编译的关卡只计算初始可点击状态，
+     * 交给GameRules前须先编译关卡或调用LevelCompiler::compileModel。
      */
     static bool generate(const LevelConfig& levelConfig, GameModel& outGameModel);
     
+    /**
+     * @brief 把读档得到的模型重新关联到关卡的预编译遮挡数据
+     * @param levelConfig 已预编译的关卡配置
+     * @param gameModel 游戏模型（主牌区为该关卡消除部分卡牌后的局面）
+     * @return 关联成功返回true；关卡未编译或卡牌与关卡不符时返回false，模型保持不变
+     * 
+     * 读档后槽位紧凑排列，与卡牌ID不再对应。这里按卡牌ID重排主牌区：先放入关卡的全部卡牌并关联，
+     * 再移除已消除的卡牌，之后的移动和撤销都按遮挡关系增量更新可点击状态。
+     */
+    static bool attachCompiledLevel(const LevelConfig& levelConfig, GameModel& gameModel);
+    
     /**
      * @brief 生成测试用的游戏模型
-     * @param outGameModel 输出的游戏模型
+     * @param outGameModel 输出的游戏模型（已关联预编译数据）
      * @return 生成成功返回true
      */
     static bool generateTestModel(GameModel& outGameModel);
@@ -67,9 +83,38 @@ public:
      * @brief 更新主牌区卡牌的可点击状态
      * @param gameModel 游戏模型
      * 
-     * 检查每张卡牌是否被其他卡牌遮挡，更新其可点击状态
+     * 检查每张卡牌是否被其他卡牌遮挡，更新其可点击状态。
+     * 已关联预编译数据的模型由GameModel自行维护，直接返回。
+     * 每次操作后都会调用（含无界面的回放和模拟），不输出日志。
      */
     static void updatePlayfieldClickable(GameModel& gameModel);
+    
+    /**
+     * @brief 判断一张卡牌是否遮挡另一张卡牌
+     * @param upper 可能在上层的卡牌
+     * @param lower 可能被遮挡的卡牌
+     * @return upper遮挡lower返回true
+     * 
+     * y坐标较小的卡牌在上面（靠近玩家），上层且重叠即为遮挡
+     */
+    static bool isCardCovering(const CardModel& upper, const CardModel& lower);
+    
+    /**
+     * @brief 按坐标判断遮挡（与isCardCovering相同，供按列扫描的循环使用）
+     * @param upperX 上层卡牌中心x
+     * @param upperY 上层卡牌中心y
+     * @param lowerX 下层卡牌中心x
+     * @param lowerY 下层卡牌中心y
+     * @return 上层卡牌遮挡下层卡牌返回true
+     */
+    static bool isCoveringAt(int upperX, int upperY, int lowerX, int lowerY)
+    {
+        const int cardWidth = static_cast<int>(GameConstants::kCardWidth);
+        const int cardHeight = static_cast<int>(GameConstants::kCardHeight);
+        int dx = upperX - lowerX;
+        int dy = upperY - lowerY;
+        return dy < 0 && dy > -cardHeight && dx < cardWidth && dx > -cardWidth;
+    }
 };
 
 #endif // __GAME_MODEL_GENERATOR_H__
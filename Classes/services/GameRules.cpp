@@ -0,0 +1,146 @@
+/**
+ * @file GameRules.cpp
+ * @brief 游戏规则服务实现
+ */
+
+#include "services/GameRules.h"
+#include "services/GameModelGenerator.h"
+
+GameRuleResult GameRules::checkPlayfieldCard(const GameModel& gameModel, int cardId, int& outSlot)
+{
+    // 只读取该卡牌的标志位列
+    const PlayfieldCardArray& cards = gameModel.getPlayfieldCards();
+    outSlot = cards.findSlot(cardId);
+    if (outSlot < 0)
+    {
+        return GameRuleResult::CARD_NOT_FOUND;
+    }
+    
+    // 被遮挡的卡牌不可点击
+    if (!cards.isClickable(outSlot))
+    {
+        return GameRuleResult::CARD_BLOCKED;
+    }
+    
+    return GameRuleResult::OK;
+}
+
+void GameRules::movePlayfieldToStack(GameModel& gameModel, UndoManager* undoManager, int cardId)
+{
+    CardModel movedCard;
+    gameModel.getPlayfieldCardById(cardId, movedCard);
+    
+    // 记录撤销操作（目标位置记为手牌区顶部牌的模型坐标，视图坐标由控制器自行计算）
+    if (undoManager)
+    {
+        const CardModel& previousTopCard = gameModel.getStackTopCard();
+        undoManager->recordPlayfieldToStack(movedCard, previousTopCard,
+                                            movedCard.getPosition(), previousTopCard.getPosition());
+    }
+    
+    // 从主牌区移除并成为新的顶部牌
+    gameModel.removePlayfieldCard(cardId);
+    movedCard.setArea(CardAreaType::STACK);
+    gameModel.setStackTopCard(movedCard);
+    
+    // 移除后下方的卡牌可能不再被遮挡：预编译模型在移除时已增量更新，此调用直接返回，
+    // 未关联预编译数据的模型才重新检测全部卡牌（见GameRules.h）
+    GameModelGenerator::updatePlayfieldClickable(gameModel);
+}
+
+GameRuleResult GameRules::checkReserveToStack(const GameModel& gameModel)
+{
+    if (gameModel.isReserveEmpty())
+    {
+        return GameRuleResult::RESERVE_EMPTY;
+    }
+    return GameRuleResult::OK;
+}
+
+GameRuleResult GameRules::applyReserveToStack(GameModel& gameModel, UndoManager* undoManager)
+{
+    CardModel drawnCard;
+    if (!gameModel.drawReserveCard(drawnCard))
+    {
+        return GameRuleResult::RESERVE_EMPTY;
+    }
+    
+    // 记录撤销操作
+    if (undoManager)
+    {
+        undoManager->recordReserveToStack(drawnCard, gameModel.getStackTopCard());
+    }
+    
+    drawnCard.setArea(CardAreaType::STACK);
+    drawnCard.setFaceUp(true);
+    gameModel.setStackTopCard(drawnCard);
+    return GameRuleResult::OK;
+}
+
+GameRuleResult GameRules::applyUndo(GameModel& gameModel, UndoManager& undoManager)
+{
+    if (!undoManager.undo())
+    {
+        return GameRuleResult::NOTHING_TO_UNDO;
+    }
+    
+    // 恢复到主牌区的卡牌会重新遮挡下方的卡牌（预编译模型在恢复时已增量更新，同上）
+    GameModelGenerator::updatePlayfieldClickable(gameModel);
+    return GameRuleResult::OK;
+}
+
+void GameRules::unapplyMove(GameModel& gameModel, const AppliedMove& applied)
+{
+    switch (applied.move.type)
+    {
+        case CardOperationType::PLAYFIELD_TO_STACK:
+            // 卡牌回到原槽位，恢复后重新遮挡下方的卡牌（预编译模型在添加时已增量更新，同上）
+            gameModel.addPlayfieldCard(applied.movedCard);
+            gameModel.setStackTopCard(applied.previousTopCard);
+            GameModelGenerator::updatePlayfieldClickable(gameModel);
+            break;
+            
+        case CardOperationType::RESERVE_TO_STACK:
+            // 备用牌堆出栈后容量不变，放回时不分配
+            gameModel.pushReserveCard(applied.movedCard);
+            gameModel.setStackTopCard(applied.previousTopCard);
+            break;
+            
+        default:
+            break;
+    }
+}
+
+bool GameRules::isWin(const GameModel& gameModel)
+{
+    return gameModel.getPlayfieldCardCount() == 0;
+}
+
+GameRuleResult GameRules::applyReserveToStack(const GameState& state, GameState& outState)
+{
+    if (state.isReserveEmpty())
+    {
+        return GameRuleResult::RESERVE_EMPTY;
+    }
+    outState = state.withReserveCardToStack();
+    return GameRuleResult::OK;
+}
+
+bool GameRules::isWin(const GameState& state)
+{
+    return state.getPlayfieldCardCount() == 0;
+}
+
+const char* GameRules::getResultDescription(GameRuleResult result)
+{
+    switch (result)
+    {
+        case GameRuleResult::OK:              return "ok";
+        case GameRuleResult::CARD_NOT_FOUND:  return "card not in playfield";
+        case GameRuleResult::CARD_BLOCKED:    return "card is blocked by other cards";
+        case GameRuleResult::CARD_NOT_MATCH:  return "card cannot match with top card";
+        case GameRuleResult::RESERVE_EMPTY:   return "reserve is empty";
+        case GameRuleResult::NOTHING_TO_UNDO: return "nothing to undo";
+        default: return "unknown";
+    }
+}
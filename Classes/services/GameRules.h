@@ -0,0 +1,498 @@
+/**
+ * @file GameRules.h
+ * @brief 游戏规则服务
+ * 
+ * 集中定义玩家操作的合法性判断和状态变更，
+ * GameController与无界面的回放、校验工具共用同一套规则。
+ * 与匹配有关的接口以匹配规则为模板参数（默认MatchRules::Default），
+ * 每种规则单独实例化，判定只需查编译期匹配表。
+ * 
+ * 提示、模拟对局等无界面的调用方通过合法操作生成接口搜索：
+ * 合法操作写入调用方提供的定长缓冲区，操作在模型上原地执行和撤销，
+ * 整个循环不分配内存、不输出日志。
+ * 
+ * 修改模型的接口要求模型已关联预编译的主牌区数据（GameModel::hasCompiledPlayfield），
+ * 每步只按遮挡关系增量更新可点击状态，详见GameRules类说明。
+ */
+
+#ifndef __GAME_RULES_H__
+#define __GAME_RULES_H__
+
+#include "models/GameModel.h"
+#include "models/GameState.h"
+#include "managers/UndoManager.h"
+#include "utils/MatchRules.h"
+
+/**
+ * @brief 规则判定结果枚举
+ */
+enum class GameRuleResult
+{
+    OK = 0,             ///< 操作合法
+    CARD_NOT_FOUND,     ///< 卡牌不在主牌区
+    CARD_BLOCKED,       ///< 卡牌被遮挡，不可点击
+    CARD_NOT_MATCH,     ///< 卡牌与手牌区顶部牌不匹配
+    RESERVE_EMPTY,      ///< 备用牌堆已空
+    NOTHING_TO_UNDO     ///< 没有可回退的操作
+};
+
+/**
+ * @brief 一个合法操作
+ */
+struct GameMove
+{
+    CardOperationType type;     ///< 操作类型
+    int cardId;                 ///< 移动的主牌区卡牌ID，翻牌时为-1
+    
+    GameMove()
+        : type(CardOperationType::NONE)
+        , cardId(-1)
+    {
+    }
+    
+    GameMove(CardOperationType operationType, int id)
+        : type(operationType)
+        , cardId(id)
+    {
+    }
+};
+
+/**
+ * @brief 已执行操作的撤销数据，由applyMove写入、unapplyMove读取
+ * 
+ * 只含定长字段，可以放在调用方的栈或数组中，多层搜索时每层一条。
+ */
+struct AppliedMove
+{
+    GameMove move;              ///< 执行的操作
+    CardModel movedCard;        ///< 移动的卡牌（执行前的状态）
+    CardModel previousTopCard;  ///< 执行前的手牌区顶部牌
+};
+
+/**
+ * @brief 游戏规则服务类
+ * 
+ * 只操作GameModel和UndoManager，不涉及视图和动画。
+ * 每次操作后立即更新主牌区的可点击状态。
+ * 
+ * 传入applyPlayfieldToStack、applyUndo、applyMove、unapplyMove的模型须已关联预编译数据，
+ * 由调用方在进入操作循环前取得一次：
+ * - 由已编译的关卡配置生成（GameModelGenerator::generate，LevelConfigCache中的关卡均已编译）
+ * - 读档后由GameModelGenerator::attachCompiledLevel重新关联
+ * - 没有关卡配置的模型（测试数据、合成局面）在开局时调用LevelCompiler::compileModel
+ * 未关联时每步退回按位置重新检测全部卡牌（O(n²)），只保留给读档找不到关卡等兜底情况和基准对比。
+ * 模板接口定义在头文件末尾。
+ * 符合services层的设计规范：无状态、可静态调用。
+ */
+class GameRules
+{
+public:
+    /**
+     * @brief 判断主牌区卡牌能否移动到手牌区
+     * @tparam Rule 匹配规则
+     * @param gameModel 游戏模型
+     * @param cardId 卡牌ID
+     * @return 判定结果
+     */
+    template <typename Rule = MatchRules::Default>
+    static GameRuleResult checkPlayfieldToStack(const GameModel& gameModel, int cardId);
+    
+    /**
+     * @brief 执行主牌区到手牌区的移动
+     * @tparam Rule 匹配规则
+     * @param gameModel 游戏模型
+     * @param undoManager 撤销管理器，为nullptr时不记录撤销
+     * @param cardId 卡牌ID
+     * @return 判定结果，非OK时模型不变
+     */
+    template <typename Rule = MatchRules::Default>
+    static GameRuleResult applyPlayfieldToStack(GameModel& gameModel, UndoManager* undoManager, int cardId);
+    
+    /**
+     * @brief 判断能否从备用牌堆翻牌
+     * @param gameModel 游戏模型
+     * @return 判定结果
+     */
+    static GameRuleResult checkReserveToStack(const GameModel& gameModel);
+    
+    /**
+     * @brief 执行备用牌堆翻牌
+     * @param gameModel 游戏模型
+     * @param undoManager 撤销管理器，为nullptr时不记录撤销
+     * @return 判定结果，非OK时模型不变
+     */
+    static GameRuleResult applyReserveToStack(GameModel& gameModel, UndoManager* undoManager);
+    
+    /**
+     * @brief 执行回退
+     * @param gameModel 游戏模型（须与undoManager初始化时的模型相同）
+     * @param undoManager 撤销管理器
+     * @return 判定结果
+     */
+    static GameRuleResult applyUndo(GameModel& gameModel, UndoManager& undoManager);
+    
+    /**
+     * @brief 是否已获胜（主牌区全部消除）
+     * @param gameModel 游戏模型
+     * @return 获胜返回true
+     */
+    static bool isWin(const GameModel& gameModel);
+    
+    /**
+     * @brief 主牌区是否有可以移动到手牌区的卡牌
+     * @tparam Rule 匹配规则
+     * @param gameModel 游戏模型
+     * @return 有合法移动返回true
+     * 
+     * 模型维护的可点击匹配下标集合与匹配表的一行按位与，O(1)
+     */
+    template <typename Rule = MatchRules::Default>
+    static bool hasPlayfieldMove(const GameModel& gameModel);
+    
+    /**
+     * @brief 是否已无任何合法操作（未获胜且无法移动、备用牌堆已空）
+     * @tparam Rule 匹配规则
+     * @param gameModel 游戏模型
+     * @return 无操作可做返回true
+     */
+    template <typename Rule = MatchRules::Default>
+    static bool isDeadEnd(const GameModel& gameModel);
+    
+    // ========== 合法操作生成 ==========
+    
+    /**
+     * @brief 合法操作数量的上限（主牌区剩余卡牌数加一次翻牌），用于确定缓冲区大小
+     * @param gameModel 游戏模型
+     * @return 上限
+     */
+    static size_t getMaxMoveCount(const GameModel& gameModel) { return gameModel.getPlayfieldCardCount() + 1; }
+    
+    /**
+     * @brief 列出所有合法操作
+     * @tparam Rule 匹配规则
+     * @param gameModel 游戏模型
+     * @param outMoves 输出缓冲区
+     * @param capacity 缓冲区容量，超出的操作不写入
+     * @return 合法操作总数（大于capacity说明缓冲区不足）
+     * 
+     * 顺序固定：主牌区的牌按槽位顺序在前，翻牌在最后。
+     * 可点击统计中没有可匹配的牌时跳过逐张检查。
+     */
+    template <typename Rule = MatchRules::Default>
+    static size_t generateMoves(const GameModel& gameModel, GameMove* outMoves, size_t capacity);
+    
+    /**
+     * @brief 在模型上原地执行操作（不记录撤销管理器，不输出日志）
+     * @tparam Rule 匹配规则
+     * @param gameModel 游戏模型
+     * @param move 操作
+     * @param outApplied 输出的撤销数据，非OK时不修改
+     * @return 判定结果，非OK时模型不变
+     */
+    template <typename Rule = MatchRules::Default>
+    static GameRuleResult applyMove(GameModel& gameModel, const GameMove& move, AppliedMove& outApplied);
+    
+    /**
+     * @brief 撤销applyMove执行的操作，须按执行的相反顺序撤销
+     * @param gameModel 游戏模型
+     * @param applied applyMove输出的撤销数据
+     */
+    static void unapplyMove(GameModel& gameModel, const AppliedMove& applied);
+    
+    // ========== 不可变局面（GameState） ==========
+    
+    /**
+     * @brief 判断局面中的主牌区卡牌能否移动到手牌区
+     * @tparam Rule 匹配规则
+     * @param state 局面
+     * @param cardId 卡牌ID
+     * @return 判定结果
+     */
+    template <typename Rule = MatchRules::Default>
+    static GameRuleResult checkPlayfieldToStack(const GameState& state, int cardId);
+    
+    /**
+     * @brief 主牌区到手牌区的移动，得到新局面
+     * @tparam Rule 匹配规则
+     * @param state 当前局面（不变）
+     * @param cardId 卡牌ID
+     * @param outState 输出的新局面，非OK时不修改
+     * @return 判定结果
+     */
+    template <typename Rule = MatchRules::Default>
+    static GameRuleResult applyPlayfieldToStack(const GameState& state, int cardId, GameState& outState);
+    
+    /**
+     * @brief 备用牌堆翻牌，得到新局面
+     * @param state 当前局面（不变）
+     * @param outState 输出的新局面，非OK时不修改
+     * @return 判定结果
+     */
+    static GameRuleResult applyReserveToStack(const GameState& state, GameState& outState);
+    
+    /**
+     * @brief 局面是否已获胜
+     * @param state 局面
+     * @return 获胜返回true
+     */
+    static bool isWin(const GameState& state);
+    
+    /**
+     * @brief 局面中主牌区是否有可以移动到手牌区的卡牌
+     * @tparam Rule 匹配规则
+     * @param state 局面
+     * @return 有合法移动返回true
+     * 
+     * 逐张检查剩余卡牌，O(剩余卡牌数×遮挡者数)
+     */
+    template <typename Rule = MatchRules::Default>
+    static bool hasPlayfieldMove(const GameState& state);
+    
+    /**
+     * @brief 局面是否已无任何合法操作
+     * @tparam Rule 匹配规则
+     * @param state 局面
+     * @return 无操作可做返回true
+     */
+    template <typename Rule = MatchRules::Default>
+    static bool isDeadEnd(const GameState& state);
+    
+    /**
+     * @brief 列出局面中的所有合法操作
+     * @tparam Rule 匹配规则
+     * @param state 局面
+     * @param outMoves 输出缓冲区
+     * @param capacity 缓冲区容量，超出的操作不写入
+     * @return 合法操作总数（大于capacity说明缓冲区不足）
+     * 
+     * 顺序与模型版本相同：主牌区的牌按卡牌ID顺序在前，翻牌在最后。
+     * 局面不可变，执行操作即applyPlayfieldToStack/applyReserveToStack得到新局面，撤销即保留旧局面。
+     */
+    template <typename Rule = MatchRules::Default>
+    static size_t generateMoves(const GameState& state, GameMove* outMoves, size_t capacity);
+    
+    /**
+     * @brief 获取判定结果的文字描述
+     * @param result 判定结果
+     * @return 描述字符串
+     */
+    static const char* getResultDescription(GameRuleResult result);
+
+private:
+    /**
+     * @brief 私有构造函数，禁止实例化
+     */
+    GameRules() = delete;
+    
+    /**
+     * @brief 查找主牌区卡牌并检查是否可点击（与匹配规则无关的部分）
+     * @param gameModel 游戏模型
+     * @param cardId 卡牌ID
+     * @param outSlot 输出的槽位
+     * @return 判定结果
+     */
+    static GameRuleResult checkPlayfieldCard(const GameModel& gameModel, int cardId, int& outSlot);
+    
+    /**
+     * @brief 执行已通过判定的主牌区到手牌区移动
+     */
+    static void movePlayfieldToStack(GameModel& gameModel, UndoManager* undoManager, int cardId);
+};
+
+// ========== 模板实现 ==========
+
+template <typename Rule>
+GameRuleResult GameRules::checkPlayfieldToStack(const GameModel& gameModel, int cardId)
+{
+    int slot = -1;
+    GameRuleResult result = checkPlayfieldCard(gameModel, cardId, slot);
+    if (result != GameRuleResult::OK)
+    {
+        return result;
+    }
+    
+    // 必须能与手牌区顶部牌匹配
+    if (!MatchRules::Table<Rule>::matches(gameModel.getPlayfieldCards().getMatchIndex(slot),
+                                          gameModel.getStackTopCard().getMatchIndex()))
+    {
+        return GameRuleResult::CARD_NOT_MATCH;
+    }
+    
+    return GameRuleResult::OK;
+}
+
+template <typename Rule>
+GameRuleResult GameRules::applyPlayfieldToStack(GameModel& gameModel, UndoManager* undoManager, int cardId)
+{
+    GameRuleResult result = checkPlayfieldToStack<Rule>(gameModel, cardId);
+    if (result != GameRuleResult::OK)
+    {
+        return result;
+    }
+    movePlayfieldToStack(gameModel, undoManager, cardId);
+    return GameRuleResult::OK;
+}
+
+template <typename Rule>
+bool GameRules::hasPlayfieldMove(const GameModel& gameModel)
+{
+    return (MatchRules::Table<Rule>::row(gameModel.getStackTopCard().getMatchIndex())
+            & gameModel.getClickableMatchMask()) != 0;
+}
+
+template <typename Rule>
+bool GameRules::isDeadEnd(const GameModel& gameModel)
+{
+    return !isWin(gameModel) && gameModel.isReserveEmpty() && !hasPlayfieldMove<Rule>(gameModel);
+}
+
+template <typename Rule>
+size_t GameRules::generateMoves(const GameModel& gameModel, GameMove* outMoves, size_t capacity)
+{
+    size_t count = 0;
+    auto addMove = [outMoves, capacity, &count](CardOperationType type, int cardId) {
+        if (count < capacity)
+        {
+            outMoves[count] = GameMove(type, cardId);
+        }
+        count++;
+    };
+    
+    if (hasPlayfieldMove<Rule>(gameModel))
+    {
+        // 只扫描匹配下标和标志位列，每张牌一次位测试
+        const PlayfieldCardArray& cards = gameModel.getPlayfieldCards();
+        uint64_t matchRow = MatchRules::Table<Rule>::row(gameModel.getStackTopCard().getMatchIndex());
+        for (size_t slot = 0; slot < cards.slotCount(); slot++)
+        {
+            if (cards.isOccupied(slot) && cards.isClickable(slot) && ((matchRow >> cards.getMatchIndex(slot)) & 1) != 0)
+            {
+                addMove(CardOperationType::PLAYFIELD_TO_STACK, cards.getCardId(slot));
+            }
+        }
+    }
+    if (!gameModel.isReserveEmpty())
+    {
+        addMove(CardOperationType::RESERVE_TO_STACK, -1);
+    }
+    return count;
+}
+
+template <typename Rule>
+GameRuleResult GameRules::applyMove(GameModel& gameModel, const GameMove& move, AppliedMove& outApplied)
+{
+    CardModel previousTopCard = gameModel.getStackTopCard();
+    CardModel movedCard;
+    GameRuleResult result;
+    switch (move.type)
+    {
+        case CardOperationType::PLAYFIELD_TO_STACK:
+            gameModel.getPlayfieldCardById(move.cardId, movedCard);
+            result = applyPlayfieldToStack<Rule>(gameModel, nullptr, move.cardId);
+            break;
+            
+        case CardOperationType::RESERVE_TO_STACK:
+            if (!gameModel.isReserveEmpty())
+            {
+                movedCard = gameModel.getReserveCards().back();
+            }
+            result = applyReserveToStack(gameModel, nullptr);
+            break;
+            
+        default:
+            return GameRuleResult::CARD_NOT_FOUND;
+    }
+    
+    if (result == GameRuleResult::OK)
+    {
+        outApplied.move = move;
+        outApplied.movedCard = movedCard;
+        outApplied.previousTopCard = previousTopCard;
+    }
+    return result;
+}
+
+template <typename Rule>
+GameRuleResult GameRules::checkPlayfieldToStack(const GameState& state, int cardId)
+{
+    if (!state.hasPlayfieldCard(cardId))
+    {
+        return GameRuleResult::CARD_NOT_FOUND;
+    }
+    if (!state.isPlayfieldCardClickable(cardId))
+    {
+        return GameRuleResult::CARD_BLOCKED;
+    }
+    if (!MatchRules::Table<Rule>::matches(state.getLevel().playfieldCards[cardId].getMatchIndex(),
+                                          state.getStackTopCard().getMatchIndex()))
+    {
+        return GameRuleResult::CARD_NOT_MATCH;
+    }
+    return GameRuleResult::OK;
+}
+
+template <typename Rule>
+GameRuleResult GameRules::applyPlayfieldToStack(const GameState& state, int cardId, GameState& outState)
+{
+    GameRuleResult result = checkPlayfieldToStack<Rule>(state, cardId);
+    if (result == GameRuleResult::OK)
+    {
+        outState = state.withPlayfieldCardToStack(cardId);
+    }
+    return result;
+}
+
+template <typename Rule>
+bool GameRules::hasPlayfieldMove(const GameState& state)
+{
+    const PersistentBitset& playfield = state.getPlayfield();
+    const std::vector<CardModel>& cards = state.getLevel().playfieldCards;
+    uint64_t matchRow = MatchRules::Table<Rule>::row(state.getStackTopCard().getMatchIndex());
+    for (size_t cardId = 0; cardId < playfield.size(); cardId++)
+    {
+        if (playfield.test(cardId) && ((matchRow >> cards[cardId].getMatchIndex()) & 1) != 0 &&
+            state.isPlayfieldCardClickable(static_cast<int>(cardId)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename Rule>
+bool GameRules::isDeadEnd(const GameState& state)
+{
+    return !isWin(state) && state.isReserveEmpty() && !hasPlayfieldMove<Rule>(state);
+}
+
+template <typename Rule>
+size_t GameRules::generateMoves(const GameState& state, GameMove* outMoves, size_t capacity)
+{
+    size_t count = 0;
+    const PersistentBitset& playfield = state.getPlayfield();
+    const std::vector<CardModel>& cards = state.getLevel().playfieldCards;
+    uint64_t matchRow = MatchRules::Table<Rule>::row(state.getStackTopCard().getMatchIndex());
+    for (size_t cardId = 0; cardId < playfield.size(); cardId++)
+    {
+        if (playfield.test(cardId) && ((matchRow >> cards[cardId].getMatchIndex()) & 1) != 0 &&
+            state.isPlayfieldCardClickable(static_cast<int>(cardId)))
+        {
+            if (count < capacity)
+            {
+                outMoves[count] = GameMove(CardOperationType::PLAYFIELD_TO_STACK, static_cast<int>(cardId));
+            }
+            count++;
+        }
+    }
+    if (!state.isReserveEmpty())
+    {
+        if (count < capacity)
+        {
+            outMoves[count] = GameMove(CardOperationType::RESERVE_TO_STACK, -1);
+        }
+        count++;
+    }
+    return count;
+}
+
+#endif // __GAME_RULES_H__
@@ -0,0 +1,301 @@
+/**
+ * @file GameSnapshotService.cpp
+ * @brief 游戏存档快照服务实现
+ */
+
+#include "services/GameSnapshotService.h"
+#include "services/GameModelGenerator.h"
+#include "utils/BinaryStream.h"
+#include "cocos2d.h"
+#include <algorithm>
+
+USING_NS_CC;
+
+const uint32_t GameSnapshotService::kMagic;
+const uint16_t GameSnapshotService::kVersion;
+const uint16_t GameSnapshotService::kHeaderSize;
+const uint16_t GameSnapshotService::kBaseHeaderSize;
+
+void GameSnapshotService::writeSnapshot(const GameModel& gameModel,
+                                        const UndoManager& undoManager,
+                                        const SnapshotLevel& level,
+                                        std::vector<uint8_t>& outBuffer)
+{
+    outBuffer.clear();
+    BinaryWriter writer(outBuffer);
+    
+    // 文件头，负载长度和校验值在写完负载后回填
+    writer.append(kBaseHeaderSize);
+    writer.writeI32(level.levelId);
+    writer.writeU32(level.levelHash);
+    gameModel.serializeBinary(writer);
+    undoManager.serializeBinary(writer);
+    
+    uint8_t* header = outBuffer.data();
+    uint32_t payloadSize = static_cast<uint32_t>(outBuffer.size() - kHeaderSize);
+    BinaryUtils::storeU32(header, kMagic);
+    BinaryUtils::storeU16(header + 4, kVersion);
+    BinaryUtils::storeU16(header + 6, kHeaderSize);
+    BinaryUtils::storeU32(header + 8, payloadSize);
+    BinaryUtils::storeU32(header + 12, BinaryUtils::fnv1a(header + kBaseHeaderSize,
+                                                          outBuffer.size() - kBaseHeaderSize));
+}
+
+bool GameSnapshotService::readSnapshot(const uint8_t* data, size_t size,
+                                       GameModel& outGameModel,
+                                       UndoManager& outUndoManager,
+                                       SnapshotLevel& outLevel)
+{
+    if (!data || size < kBaseHeaderSize)
+    {
+        CCLOG("GameSnapshotService: Snapshot too small");
+        return false;
+    }
+    
+    if (BinaryUtils::loadU32(data) != kMagic)
+    {
+        CCLOG("GameSnapshotService: Bad snapshot magic");
+        return false;
+    }
+    
+    // 版本1没有关卡字段，文件头只有共有部分
+    uint16_t version = BinaryUtils::loadU16(data + 4);
+    uint16_t headerSize = BinaryUtils::loadU16(data + 6);
+    uint16_t minHeaderSize = version == 1 ? kBaseHeaderSize : kHeaderSize;
+    if (version < 1 || version > kVersion || headerSize < minHeaderSize || headerSize > size)
+    {
+        CCLOG("GameSnapshotService: Unsupported snapshot version %u", version);
+        return false;
+    }
+    
+    uint32_t payloadSize = BinaryUtils::loadU32(data + 8);
+    if (payloadSize != size - headerSize)
+    {
+        CCLOG("GameSnapshotService: Snapshot size mismatch");
+        return false;
+    }
+    
+    if (BinaryUtils::loadU32(data + 12) != BinaryUtils::fnv1a(data + kBaseHeaderSize, size - kBaseHeaderSize))
+    {
+        CCLOG("GameSnapshotService: Snapshot checksum mismatch");
+        return false;
+    }
+    
+    SnapshotLevel level;
+    if (version >= 2)
+    {
+        level.levelId = static_cast<int32_t>(BinaryUtils::loadU32(data + kBaseHeaderSize));
+        level.levelHash = BinaryUtils::loadU32(data + kBaseHeaderSize + 4);
+    }
+    
+    // 先解码到临时模型，成功后再替换，避免半途失败污染当前状态
+    BinaryReader reader(data + headerSize, payloadSize);
+    GameModel gameModel;
+    if (!gameModel.deserializeBinary(reader))
+    {
+        CCLOG("GameSnapshotService: Failed to decode game model");
+        return false;
+    }
+    
+    // 撤销栈是负载的最后一部分，必须恰好用完剩余数据；先在副本上检查，失败时撤销管理器保持不变
+    BinaryReader undoReader = reader;
+    uint32_t undoCount = 0;
+    if (!undoReader.readU32(undoCount) ||
+        undoReader.remaining() % UndoModel::kBinaryRecordSize != 0 ||
+        undoReader.remaining() / UndoModel::kBinaryRecordSize != undoCount)
+    {
+        CCLOG("GameSnapshotService: Undo stack size does not match payload");
+        return false;
+    }
+    
+    if (!outUndoManager.deserializeBinary(reader))
+    {
+        CCLOG("GameSnapshotService: Failed to decode undo stack");
+        return false;
+    }
+    
+    outGameModel = gameModel;
+    outLevel = level;
+    return true;
+}
+
+bool GameSnapshotService::saveToFile(const std::string& filePath,
+                                     const GameModel& gameModel,
+                                     const UndoManager& undoManager,
+                                     const SnapshotLevel& level)
+{
+    std::vector<uint8_t> buffer;
+    writeSnapshot(gameModel, undoManager, level, buffer);
+    
+    Data data;
+    data.copy(buffer.data(), static_cast<ssize_t>(buffer.size()));
+    
+    std::string tempPath = filePath + ".tmp";
+    auto fileUtils = FileUtils::getInstance();
+    if (!fileUtils->writeDataToFile(data, tempPath))
+    {
+        CCLOG("GameSnapshotService: Failed to write %s", tempPath.c_str());
+        return false;
+    }
+    
+    if (!fileUtils->renameFile(tempPath, filePath))
+    {
+        CCLOG("GameSnapshotService: Failed to replace %s", filePath.c_str());
+        return false;
+    }
+    
+    CCLOG("GameSnapshotService: Saved %zu bytes to %s", buffer.size(), filePath.c_str());
+    return true;
+}
+
+bool GameSnapshotService::loadFromFile(const std::string& filePath,
+                                       GameModel& outGameModel,
+                                       UndoManager& outUndoManager,
+                                       SnapshotLevel& outLevel)
+{
+    auto fileUtils = FileUtils::getInstance();
+    if (!fileUtils->isFileExist(filePath))
+    {
+        return false;
+    }
+    
+    Data data = fileUtils->getDataFromFile(filePath);
+    if (data.isNull())
+    {
+        CCLOG("GameSnapshotService: Failed to read %s", filePath.c_str());
+        return false;
+    }
+    
+    return readSnapshot(data.getBytes(), static_cast<size_t>(data.getSize()),
+                        outGameModel, outUndoManager, outLevel);
+}
+
+std::string GameSnapshotService::getDefaultSnapshotPath()
+{
+    return FileUtils::getInstance()->getWritablePath() + "game_snapshot.bin";
+}
+
+bool GameSnapshotService::captureState(const GameModel& gameModel, GameState& outState)
+{
+    const PlayfieldCardArray& cards = gameModel.getPlayfieldCards();
+    int maxCardId = -1;
+    for (size_t slot = 0; slot < cards.slotCount(); slot++)
+    {
+        if (cards.isOccupied(slot))
+        {
+            if (cards.getCardId(slot) < 0)
+            {
+                CCLOG("GameSnapshotService: Playfield card without id, cannot capture state");
+                return false;
+            }
+            maxCardId = std::max(maxCardId, cards.getCardId(slot));
+        }
+    }
+    
+    auto level = std::make_shared<GameStateLevel>();
+    level->playfieldCards.resize(maxCardId + 1);
+    level->blockers.resize(maxCardId + 1);
+    level->reserveCards.assign(gameModel.getReserveCards().begin(), gameModel.getReserveCards().end());
+    
+    // 只有主牌区完整时还原的模型才能重新关联预编译数据
+    const auto& compiled = gameModel.getCompiledPlayfield();
+    if (compiled && compiled->size() == cards.size())
+    {
+        level->compiledPlayfield = compiled;
+    }
+    
+    // 位集合一次性构造，逐位withBit在超过内联容量时每次都会复制根节点
+    std::vector<int> playfieldIds;
+    playfieldIds.reserve(cards.size());
+    for (size_t slot = 0; slot < cards.slotCount(); slot++)
+    {
+        if (cards.isOccupied(slot))
+        {
+            int cardId = cards.getCardId(slot);
+            level->playfieldCards[cardId] = cards.getCard(slot);
+            playfieldIds.push_back(cardId);
+        }
+    }
+    PersistentBitset playfield(maxCardId + 1, playfieldIds);
+    if (playfield.count() != cards.size())
+    {
+        CCLOG("GameSnapshotService: Duplicate playfield card ids, cannot capture state");
+        return false;
+    }
+    
+    // 预编译数据的下标就是卡牌ID；否则按坐标两两计算
+    const int16_t* xs = cards.getXs().data();
+    const int16_t* ys = cards.getYs().data();
+    for (size_t lower = 0; lower < cards.slotCount(); lower++)
+    {
+        if (!cards.isOccupied(lower))
+        {
+            continue;
+        }
+        int lowerId = cards.getCardId(lower);
+        auto& blockers = level->blockers[lowerId];
+        if (compiled)
+        {
+            for (int blocker : (*compiled)[lowerId].blockers)
+            {
+                if (playfield.test(blocker))
+                {
+                    blockers.push_back(blocker);
+                }
+            }
+            continue;
+        }
+        for (size_t upper = 0; upper < cards.slotCount(); upper++)
+        {
+            if (upper != lower && cards.isOccupied(upper) &&
+                GameModelGenerator::isCoveringAt(xs[upper], ys[upper], xs[lower], ys[lower]))
+            {
+                blockers.push_back(cards.getCardId(upper));
+            }
+        }
+    }
+    
+    outState = GameState(std::move(level), playfield, gameModel.getStackTopCard(),
+                         static_cast<int>(gameModel.getReserveCardCount()));
+    return true;
+}
+
+void GameSnapshotService::restoreState(const GameState& state, GameModel& outGameModel)
+{
+    const GameStateLevel& level = state.getLevel();
+    outGameModel.clear();
+    
+    // 有预编译数据时先放入全部卡牌并关联，再移除已消除的卡牌，由模型增量维护可点击状态
+    if (level.compiledPlayfield)
+    {
+        for (const auto& card : level.playfieldCards)
+        {
+            outGameModel.addPlayfieldCard(card);
+        }
+        outGameModel.setCompiledPlayfield(level.compiledPlayfield);
+        for (size_t cardId = 0; cardId < level.playfieldCards.size(); cardId++)
+        {
+            if (!state.hasPlayfieldCard(static_cast<int>(cardId)))
+            {
+                outGameModel.removePlayfieldCard(static_cast<int>(cardId));
+            }
+        }
+    }
+    else
+    {
+        state.getPlayfield().forEachSetBit([&](size_t cardId) {
+            outGameModel.addPlayfieldCard(level.playfieldCards[cardId]);
+        });
+        const PlayfieldCardArray& cards = outGameModel.getPlayfieldCards();
+        for (size_t slot = 0; slot < cards.slotCount(); slot++)
+        {
+            outGameModel.setPlayfieldCardClickable(slot, state.isPlayfieldCardClickable(cards.getCardId(slot)));
+        }
+    }
+    
+    outGameModel.setStackTopCard(state.getStackTopCard());
+    for (int i = 0; i < state.getReserveCardCount(); i++)
+    {
+        outGameModel.addReserveCard(level.reserveCards[i]);
+    }
+}
@@ -0,0 +1,146 @@
+/**
+ * @file GameSnapshotService.h
+ * @brief 游戏存档快照服务
+ * 
+ * 负责将GameModel与撤销栈保存为带版本号的二进制快照，
+ * 以及从快照恢复。与JSON序列化并存，用于切后台等对耗时敏感的场景。
+ * 另外负责GameModel与内存中的不可变局面GameState之间的转换。
+ */
+
+#ifndef __GAME_SNAPSHOT_SERVICE_H__
+#define __GAME_SNAPSHOT_SERVICE_H__
+
+#include "models/GameModel.h"
+#include "models/GameState.h"
+#include "managers/UndoManager.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 快照所属的关卡（恢复对局后据此衔接下一关、校验录像）
+ */
+struct SnapshotLevel
+{
+    int levelId;            ///< 关卡ID，测试数据或版本1快照为0
+    uint32_t levelHash;     ///< 关卡内容哈希，未知为0
+    
+    SnapshotLevel()
+        : levelId(0)
+        , levelHash(0)
+    {
+    }
+    
+    SnapshotLevel(int id, uint32_t hash)
+        : levelId(id)
+        , levelHash(hash)
+    {
+    }
+};
+
+/**
+ * @brief 游戏存档快照服务类
+ * 
+ * 快照格式（小端序）：
+ * - 文件头24字节：magic(u32) version(u16) headerSize(u16) payloadSize(u32) checksum(u32)
+ *   levelId(i32) levelHash(u32)
+ * - 负载：GameModel二进制记录 + 撤销栈二进制记录，必须恰好用完
+ * 校验值覆盖文件头前16字节之后的全部数据（关卡字段和负载）。
+ * 仍可读取版本1的快照（文件头16字节，没有关卡字段）。
+ * 
+ * 符合services层的设计规范：无状态、可静态调用。
+ */
+class GameSnapshotService
+{
+public:
+    static const uint32_t kMagic = 0x56534350;     ///< "PCSV"
+    static const uint16_t kVersion = 2;            ///< 当前快照版本
+    static const uint16_t kHeaderSize = 24;        ///< 文件头长度
+    static const uint16_t kBaseHeaderSize = 16;    ///< 各版本共有的文件头长度（校验值之前）
+    
+    /**
+     * @brief 将游戏状态写入快照缓冲区
+     * @param gameModel 游戏模型
+     * @param undoManager 撤销管理器
+     * @param level 所属关卡
+     * @param outBuffer 输出缓冲区（原内容会被覆盖）
+     */
+    static void writeSnapshot(const GameModel& gameModel,
+                              const UndoManager& undoManager,
+                              const SnapshotLevel& level,
+                              std::vector<uint8_t>& outBuffer);
+    
+    /**
+     * @brief 从快照缓冲区恢复游戏状态
+     * @param data 快照数据
+     * @param size 数据长度
+     * @param outGameModel 输出的游戏模型
+     * @param outUndoManager 输出的撤销管理器
+     * @param outLevel 输出的所属关卡
+     * @return 成功返回true；校验失败或负载有多余数据时输出对象保持不变
+     */
+    static bool readSnapshot(const uint8_t* data, size_t size,
+                             GameModel& outGameModel,
+                             UndoManager& outUndoManager,
+                             SnapshotLevel& outLevel);
+    
+    /**
+     * @brief 保存快照到文件（先写临时文件再替换，避免中途被杀导致存档损坏）
+     * @param filePath 文件完整路径
+     * @param gameModel 游戏模型
+     * @param undoManager 撤销管理器
+     * @param level 所属关卡
+     * @return 保存成功返回true
+     */
+    static bool saveToFile(const std::string& filePath,
+                           const GameModel& gameModel,
+                           const UndoManager& undoManager,
+                           const SnapshotLevel& level);
+    
+    /**
+     * @brief 从文件加载快照
+     * @param filePath 文件完整路径
+     * @param outGameModel 输出的游戏模型
+     * @param outUndoManager 输出的撤销管理器
+     * @param outLevel 输出的所属关卡
+     * @return 加载成功返回true
+     */
+    static bool loadFromFile(const std::string& filePath,
+                             GameModel& outGameModel,
+                             UndoManager& outUndoManager,
+                             SnapshotLevel& outLevel);
+    
+    /**
+     * @brief 获取默认快照文件路径（可写目录下）
+     * @return 文件完整路径
+     */
+    static std::string getDefaultSnapshotPath();
+    
+    // ========== 内存局面 ==========
+    
+    /**
+     * @brief 由游戏模型创建不可变局面（之后的快照直接复制GameState，O(1)）
+     * @param gameModel 游戏模型
+     * @param outState 输出的局面
+     * @return 成功返回true；主牌区卡牌ID无效或重复时返回false
+     * 
+     * 遮挡关系优先取模型关联的预编译数据，否则按坐标计算（O(n²)，每局只需一次）。
+     * 创建时已不在主牌区的卡牌不会再回到主牌区。
+     */
+    static bool captureState(const GameModel& gameModel, GameState& outState);
+    
+    /**
+     * @brief 把不可变局面还原为游戏模型（供视图或需要GameModel的服务使用）
+     * @param state 有效局面
+     * @param outGameModel 输出的游戏模型（原内容会被清空）
+     */
+    static void restoreState(const GameState& state, GameModel& outGameModel);
+
+private:
+    /**
+     * @brief 私有构造函数，禁止实例化
+     */
+    GameSnapshotService() = delete;
+};
+
+#endif // __GAME_SNAPSHOT_SERVICE_H__
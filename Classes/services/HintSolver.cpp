@@ -0,0 +1,295 @@
+/**
+ * @file HintSolver.cpp
+ * @brief 提示搜索服务实现
+ */
+
+#include "services/HintSolver.h"
+#include "services/GameModelGenerator.h"
+#include "services/GameRules.h"
+#include <algorithm>
+
+namespace
+{
+    /// 搜索支持的最大主牌区卡牌ID（用64位掩码表示剩余卡牌）
+    const int kMaxSearchCardId = 63;
+    
+    /// 每访问多少个局面检查一次时间和取消
+    const size_t kCheckInterval = 256;
+    
+    int countBits(uint64_t mask)
+    {
+        int count = 0;
+        while (mask)
+        {
+            mask &= mask - 1;
+            count++;
+        }
+        return count;
+    }
+    
+    int lowestBit(uint64_t mask)
+    {
+        int index = 0;
+        while ((mask & 1) == 0)
+        {
+            mask >>= 1;
+            index++;
+        }
+        return index;
+    }
+}
+
+HintCache::HintCache()
+    : _levelHash(0)
+    , _hasLevel(false)
+{
+}
+
+void HintCache::bindLevel(uint32_t levelHash)
+{
+    if (!_hasLevel || _levelHash != levelHash)
+    {
+        _values.clear();
+        _levelHash = levelHash;
+        _hasLevel = true;
+    }
+}
+
+void HintCache::clear()
+{
+    _values.clear();
+}
+
+/**
+ * @brief 单次搜索的上下文，按卡牌ID索引的匹配下标和遮挡关系
+ */
+struct HintSolver::SearchContext
+{
+    uint8_t matchIndexes[kMaxSearchCardId + 1];
+    uint64_t blockers[kMaxSearchCardId + 1];    ///< 遮挡该卡牌的卡牌集合
+    std::vector<uint8_t> reserveIndexes;        ///< 备用牌堆匹配下标（末尾先翻）
+    HintCache* cache;
+    std::chrono::steady_clock::time_point deadline;
+    const CancelCheck* isCancelled;
+    size_t visitedStates;
+    bool isAborted;
+};
+
+template <typename Rule>
+HintResult HintSolver::findGreedyMove(const GameModel& gameModel)
+{
+    HintResult result;
+    
+    // 先查可点击统计，确定有可移动的卡牌时才逐张查找
+    if (GameRules::hasPlayfieldMove<Rule>(gameModel))
+    {
+        for (const auto& card : gameModel.getPlayfieldCards())
+        {
+            if (GameRules::checkPlayfieldToStack<Rule>(gameModel, card.getCardId()) == GameRuleResult::OK)
+            {
+                result.action = GameActionType::PLAYFIELD_TO_STACK;
+                result.cardId = card.getCardId();
+                result.clearableCards = 1;
+                return result;
+            }
+        }
+    }
+    
+    if (GameRules::checkReserveToStack(gameModel) == GameRuleResult::OK)
+    {
+        result.action = GameActionType::RESERVE_TO_STACK;
+    }
+    return result;
+}
+
+template <typename Rule>
+HintResult HintSolver::findBestMove(const GameModel& gameModel,
+                                    HintCache& cache,
+                                    std::chrono::steady_clock::time_point deadline,
+                                    const CancelCheck& isCancelled)
+{
+    // 按槽位收集在场卡牌
+    const PlayfieldCardArray& cards = gameModel.getPlayfieldCards();
+    std::vector<size_t> slots;
+    slots.reserve(cards.size());
+    for (size_t slot = 0; slot < cards.slotCount(); slot++)
+    {
+        if (!cards.isOccupied(slot))
+        {
+            continue;
+        }
+        if (cards.getCardId(slot) < 0 || cards.getCardId(slot) > kMaxSearchCardId)
+        {
+            return findGreedyMove<Rule>(gameModel);
+        }
+        slots.push_back(slot);
+    }
+    
+    SearchContext context;
+    context.cache = &cache;
+    context.deadline = deadline;
+    context.isCancelled = &isCancelled;
+    context.visitedStates = 0;
+    context.isAborted = false;
+    
+    // 遮挡关系优先取预编译数据（下标即卡牌ID，已消除的遮挡者在搜索时按掩码排除），否则按坐标列两两计算
+    const auto& compiled = gameModel.getCompiledPlayfield();
+    const int16_t* xs = cards.getXs().data();
+    const int16_t* ys = cards.getYs().data();
+    uint64_t mask = 0;
+    for (size_t i : slots)
+    {
+        int id = cards.getCardId(i);
+        mask |= 1ull << id;
+        context.matchIndexes[id] = static_cast<uint8_t>(cards.getMatchIndex(i));
+        context.blockers[id] = 0;
+        if (compiled)
+        {
+            // 在场卡牌的ID都不超过kMaxSearchCardId，超出的遮挡者必然已消除
+            for (int blocker : (*compiled)[id].blockers)
+            {
+                if (blocker <= kMaxSearchCardId)
+                {
+                    context.blockers[id] |= 1ull << blocker;
+                }
+            }
+            continue;
+        }
+        for (size_t j : slots)
+        {
+            if (GameModelGenerator::isCoveringAt(xs[j], ys[j], xs[i], ys[i]))
+            {
+                context.blockers[id] |= 1ull << cards.getCardId(j);
+            }
+        }
+    }
+    
+    const auto& reserveCards = gameModel.getReserveCards();
+    context.reserveIndexes.reserve(reserveCards.size());
+    for (const auto& card : reserveCards)
+    {
+        context.reserveIndexes.push_back(static_cast<uint8_t>(card.getMatchIndex()));
+    }
+    
+    // 根节点逐个评估合法操作，记录最优者
+    HintResult result;
+    int remaining = countBits(mask);
+    int best = -1;
+    int topIndex = gameModel.getStackTopCard().getMatchIndex();
+    int reserveCount = static_cast<int>(context.reserveIndexes.size());
+    
+    for (uint64_t rest = mask; rest && best < remaining && !context.isAborted; rest &= rest - 1)
+    {
+        int id = lowestBit(rest);
+        if ((context.blockers[id] & mask) != 0 || !MatchRules::Table<Rule>::matches(context.matchIndexes[id], topIndex))
+        {
+            continue;
+        }
+        int value = 1 + search<Rule>(context, mask & ~(1ull << id), context.matchIndexes[id], reserveCount);
+        if (value > best)
+        {
+            best = value;
+            result.action = GameActionType::PLAYFIELD_TO_STACK;
+            result.cardId = id;
+        }
+    }
+    
+    if (best < remaining && reserveCount > 0 && !context.isAborted)
+    {
+        int value = search<Rule>(context, mask, context.reserveIndexes[reserveCount - 1], reserveCount - 1);
+        if (value > best)
+        {
+            best = value;
+            result.action = GameActionType::RESERVE_TO_STACK;
+            result.cardId = -1;
+        }
+    }
+    
+    // 时间耗尽前一步都没评估完时，至少给出一个合法操作
+    if (result.action == GameActionType::NONE)
+    {
+        HintResult greedy = findGreedyMove<Rule>(gameModel);
+        greedy.visitedStates = context.visitedStates;
+        greedy.isComplete = !context.isAborted;
+        return greedy;
+    }
+    
+    result.clearableCards = std::max(best, 0);
+    result.isSolvable = best == remaining;
+    result.isComplete = !context.isAborted;
+    result.visitedStates = context.visitedStates;
+    return result;
+}
+
+template <typename Rule>
+int HintSolver::search(SearchContext& context, uint64_t mask, int topIndex, int reserveCount)
+{
+    int remaining = countBits(mask);
+    if (remaining == 0)
+    {
+        return 0;
+    }
+    
+    HintCache::StateKey key;
+    key.playfieldMask = mask;
+    key.stackAndReserve = (static_cast<uint32_t>(topIndex) << 16) | static_cast<uint32_t>(reserveCount);
+    auto iter = context.cache->_values.find(key);
+    if (iter != context.cache->_values.end())
+    {
+        return iter->second;
+    }
+    
+    if (++context.visitedStates % kCheckInterval == 0)
+    {
+        if (std::chrono::steady_clock::now() >= context.deadline ||
+            (*context.isCancelled && (*context.isCancelled)()))
+        {
+            context.isAborted = true;
+        }
+    }
+    if (context.isAborted)
+    {
+        return 0;
+    }
+    
+    // 能与顶部牌匹配的匹配下标集合，逐张检查时只需一次位测试
+    uint64_t matchRow = MatchRules::Table<Rule>::row(topIndex);
+    int best = 0;
+    for (uint64_t rest = mask; rest && best < remaining; rest &= rest - 1)
+    {
+        int id = lowestBit(rest);
+        if ((context.blockers[id] & mask) != 0 || ((matchRow >> context.matchIndexes[id]) & 1) == 0)
+        {
+            continue;
+        }
+        best = std::max(best, 1 + search<Rule>(context, mask & ~(1ull << id), context.matchIndexes[id], reserveCount));
+    }
+    
+    if (best < remaining && reserveCount > 0)
+    {
+        best = std::max(best, search<Rule>(context, mask, context.reserveIndexes[reserveCount - 1], reserveCount - 1));
+    }
+    
+    // 中止时结果不完整，不能写入缓存
+    if (!context.isAborted)
+    {
+        if (context.cache->_values.size() >= HintCache::kMaxEntries)
+        {
+            context.cache->_values.clear();
+        }
+        context.cache->_values[key] = best;
+    }
+    return best;
+}
+
+// ========== 显式实例化 ==========
+
+#define HINT_SOLVER_INSTANTIATE(Rule) \
+    template HintResult HintSolver::findBestMove<Rule>(const GameModel&, HintCache&, \
+                                                       std::chrono::steady_clock::time_point, \
+                                                       const HintSolver::CancelCheck&); \
+    template HintResult HintSolver::findGreedyMove<Rule>(const GameModel&);
+
+PLAYINGCARDS_FOR_EACH_MATCH_RULE(HINT_SOLVER_INSTANTIATE)
+
+#undef HINT_SOLVER_INSTANTIATE
@@ -0,0 +1,160 @@
+/**
+ * @file HintSolver.h
+ * @brief 提示搜索服务
+ * 
+ * 在限定时间内搜索当前局面的最佳下一步操作，
+ * 目标是让主牌区最终消除的卡牌数量最多。
+ */
+
+#ifndef __HINT_SOLVER_H__
+#define __HINT_SOLVER_H__
+
+#include "models/GameModel.h"
+#include "configs/CardTypes.h"
+#include "utils/MatchRules.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+/**
+ * @brief 提示搜索结果
+ */
+struct HintResult
+{
+    GameActionType action;      ///< 建议的操作，无可用操作时为NONE
+    int cardId;                 ///< 建议点击的主牌区卡牌ID（仅PLAYFIELD_TO_STACK有效）
+    int clearableCards;         ///< 按建议走下去至少还能消除的主牌区卡牌数量
+    bool isSolvable;            ///< 是否找到能清空主牌区的走法
+    bool isComplete;            ///< 搜索是否在时限内完成（结果为最优）
+    size_t visitedStates;       ///< 本次搜索访问的局面数量
+    
+    HintResult()
+        : action(GameActionType::NONE)
+        , cardId(-1)
+        , clearableCards(0)
+        , isSolvable(false)
+        , isComplete(false)
+        , visitedStates(0)
+    {
+    }
+};
+
+/**
+ * @brief 提示搜索缓存
+ * 
+ * 以局面为键记录已完整搜索过的局面还能消除的卡牌数量。
+ * 同一关卡内的局面可以复用，因此连续提示时大部分局面直接命中缓存。
+ * 由调用方持有，只能在一个线程中使用，且只能用于一种匹配规则。
+ */
+class HintCache
+{
+public:
+    /// 缓存条目上限，超过后整体清空
+    static const size_t kMaxEntries = 1 << 20;
+    
+    HintCache();
+    
+    /**
+     * @brief 切换到指定关卡，关卡不同时清空缓存
+     * @param levelHash 关卡内容哈希
+     */
+    void bindLevel(uint32_t levelHash);
+    
+    /**
+     * @brief 清空缓存
+     */
+    void clear();
+    
+    /**
+     * @brief 获取缓存条目数量
+     * @return 条目数量
+     */
+    size_t size() const { return _values.size(); }
+
+private:
+    friend class HintSolver;
+    
+    /**
+     * @brief 局面键：剩余主牌区卡牌集合、顶部牌匹配下标、备用牌堆剩余数量
+     */
+    struct StateKey
+    {
+        uint64_t playfieldMask;
+        uint32_t stackAndReserve;
+        
+        bool operator==(const StateKey& other) const
+        {
+            return playfieldMask == other.playfieldMask && stackAndReserve == other.stackAndReserve;
+        }
+    };
+    
+    struct StateKeyHash
+    {
+        size_t operator()(const StateKey& key) const
+        {
+            uint64_t hash = key.playfieldMask * 0x9E3779B97F4A7C15ull;
+            hash ^= (hash >> 29) ^ (static_cast<uint64_t>(key.stackAndReserve) * 0xBF58476D1CE4E5B9ull);
+            return static_cast<size_t>(hash ^ (hash >> 32));
+        }
+    };
+    
+    uint32_t _levelHash;                                        ///< 当前绑定的关卡哈希
+    bool _hasLevel;                                             ///< 是否已绑定关卡
+    std::unordered_map<StateKey, int, StateKeyHash> _values;    ///< 局面到可消除数量的映射
+};
+
+/**
+ * @brief 提示搜索服务类
+ * 
+ * 深度优先搜索所有合法操作序列，按时间预算随时中止并返回当前最优操作。
+ * 主牌区卡牌ID超出搜索支持范围（64张）时退化为贪心提示。
+ * 以匹配规则为模板参数，各规则的实例在HintSolver.cpp中显式实例化。
+ * 符合services层的设计规范：无状态、可静态调用。
+ */
+class HintSolver
+{
+public:
+    /// 取消检查函数，返回true时立即结束搜索
+    using CancelCheck = std::function<bool()>;
+    
+    /**
+     * @brief 搜索当前局面的最佳下一步
+     * @tparam Rule 匹配规则
+     * @param gameModel 游戏模型（通常为快照副本）
+     * @param cache 搜索缓存（须已绑定当前关卡）
+     * @param deadline 搜索截止时间
+     * @param isCancelled 取消检查函数，可为空
+     * @return 搜索结果
+     */
+    template <typename Rule = MatchRules::Default>
+    static HintResult findBestMove(const GameModel& gameModel,
+                                   HintCache& cache,
+                                   std::chrono::steady_clock::time_point deadline,
+                                   const CancelCheck& isCancelled = nullptr);
+    
+    /**
+     * @brief 贪心提示：任一可匹配的主牌区卡牌，否则翻牌
+     * @tparam Rule 匹配规则
+     * @param gameModel 游戏模型
+     * @return 搜索结果
+     */
+    template <typename Rule = MatchRules::Default>
+    static HintResult findGreedyMove(const GameModel& gameModel);
+
+private:
+    /**
+     * @brief 私有构造函数，禁止实例化
+     */
+    HintSolver() = delete;
+    
+    struct SearchContext;
+    
+    /**
+     * @brief 递归搜索，返回从该局面出发还能消除的最多卡牌数量
+     */
+    template <typename Rule>
+    static int search(SearchContext& context, uint64_t mask, int topIndex, int reserveCount);
+};
+
+#endif // __HINT_SOLVER_H__
@@ -0,0 +1,152 @@
+/**
+ * @file LevelCompiler.cpp
+ * @brief 关卡编译服务实现
+ */
+
+#include "services/LevelCompiler.h"
+#include "services/GameModelGenerator.h"
+#include <algorithm>
+#include <memory>
+
+namespace
+{
+    /**
+     * @brief 按卡牌位置计算遮挡关系和初始可点击状态（卡牌下标即卡牌ID），绘制顺序由调用方填写
+     */
+    void computeCoverage(const std::vector<CardModel>& cards, CompiledPlayfield& outCompiled)
+    {
+        // 与运行时使用同一套遮挡判定
+        int cardCount = static_cast<int>(cards.size());
+        outCompiled.assign(cardCount, CompiledCardData());
+        for (int lower = 0; lower < cardCount; lower++)
+        {
+            for (int upper = 0; upper < cardCount; upper++)
+            {
+                if (upper != lower && GameModelGenerator::isCardCovering(cards[upper], cards[lower]))
+                {
+                    outCompiled[lower].blockers.push_back(upper);
+                    outCompiled[upper].covers.push_back(lower);
+                }
+            }
+        }
+        for (auto& card : outCompiled)
+        {
+            card.isClickable = card.blockers.empty();
+        }
+    }
+}
+
+void LevelCompiler::computeCompiledPlayfield(const LevelConfig& levelConfig, CompiledPlayfield& outCompiled)
+{
+    const auto& configs = levelConfig.getPlayfieldCards();
+    int cardCount = static_cast<int>(configs.size());
+    
+    std::vector<CardModel> cards;
+    cards.reserve(cardCount);
+    for (int i = 0; i < cardCount; i++)
+    {
+        CardModel card(i, configs[i].suit, configs[i].face);
+        card.setPosition(configs[i].position);
+        cards.push_back(card);
+    }
+    computeCoverage(cards, outCompiled);
+    
+    std::vector<int> drawOrder(cardCount);
+    for (int i = 0; i < cardCount; i++)
+    {
+        drawOrder[i] = i;
+    }
+    std::stable_sort(drawOrder.begin(), drawOrder.end(), [&configs](int a, int b) {
+        return configs[a].position.y > configs[b].position.y;
+    });
+    
+    for (int rank = 0; rank < cardCount; rank++)
+    {
+        outCompiled[drawOrder[rank]].zOrder = rank;
+    }
+}
+
+bool LevelCompiler::compile(LevelConfig& levelConfig)
+{
+    // 先去掉旧数据，避免过期的预编译数据导致校验失败
+    levelConfig.setCompiledPlayfield(nullptr);
+    if (!levelConfig.isValid())
+    {
+        return false;
+    }
+    
+    auto compiled = std::make_shared<CompiledPlayfield>();
+    computeCompiledPlayfield(levelConfig, *compiled);
+    levelConfig.setCompiledPlayfield(compiled);
+    return true;
+}
+
+bool LevelCompiler::compileModel(GameModel& gameModel)
+{
+    if (gameModel.hasCompiledPlayfield())
+    {
+        return true;
+    }
+    
+    // 与GameModel::setCompiledPlayfield的要求相同：没有空槽位且槽位即卡牌ID
+    const PlayfieldCardArray& playfield = gameModel.getPlayfieldCards();
+    if (playfield.slotCount() != playfield.size())
+    {
+        return false;
+    }
+    std::vector<CardModel> cards(playfield.begin(), playfield.end());
+    int cardCount = static_cast<int>(cards.size());
+    for (int i = 0; i < cardCount; i++)
+    {
+        if (cards[i].getCardId() != i)
+        {
+            return false;
+        }
+    }
+    
+    auto compiled = std::make_shared<CompiledPlayfield>();
+    computeCoverage(cards, *compiled);
+    
+    // 绘制顺序与关卡编译相同：y从大到小，相同时按卡牌ID
+    std::vector<int> drawOrder(cardCount);
+    for (int i = 0; i < cardCount; i++)
+    {
+        drawOrder[i] = i;
+    }
+    std::stable_sort(drawOrder.begin(), drawOrder.end(), [&cards](int a, int b) {
+        return cards[a].getY() > cards[b].getY();
+    });
+    for (int rank = 0; rank < cardCount; rank++)
+    {
+        (*compiled)[drawOrder[rank]].zOrder = rank;
+    }
+    return gameModel.setCompiledPlayfield(compiled);
+}
+
+bool LevelCompiler::isUpToDate(const LevelConfig& levelConfig)
+{
+    if (!levelConfig.isCompiled())
+    {
+        return false;
+    }
+    
+    CompiledPlayfield expected;
+    computeCompiledPlayfield(levelConfig, expected);
+    const CompiledPlayfield& actual = *levelConfig.getCompiledPlayfield();
+    if (actual.size() != expected.size())
+    {
+        return false;
+    }
+    
+    for (size_t i = 0; i < actual.size(); i++)
+    {
+        if (actual[i].zOrder != expected[i].zOrder ||
+            actual[i].isClickable != expected[i].isClickable ||
+            actual[i].blockers != expected[i].blockers ||
+            actual[i].covers != expected[i].covers)
+        {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file LevelCompiler.h
+ * @brief 关卡编译服务
+ * 
+ * 离线把手工编辑的关卡中由位置决定的信息（遮挡关系、绘制顺序、初始可点击状态）
+ * 预先算好写入关卡文件，运行时加载关卡不再做几何计算，
+ * 也不会因不同设备的浮点差异导致布局表现不一致。
+ */
+
+#ifndef __LEVEL_COMPILER_H__
+#define __LEVEL_COMPILER_H__
+
+#include "configs/LevelConfig.h"
+#include "models/GameModel.h"
+
+/**
+ * @brief 关卡编译服务类
+ * 
+ * 遮挡判定与GameModelGenerator::isCardCovering一致。
+ * 符合services层的设计规范：无状态、可静态调用。
+ */
+class LevelCompiler
+{
+public:
+    /**
+     * @brief 根据主牌区卡牌位置计算预编译数据
+     * @param levelConfig 关卡配置
+     * @param outCompiled 输出的预编译数据
+     * 
+     * 绘制顺序按y坐标从大到小（越靠下越后绘制），相同时按配置顺序，
+     * 保证遮挡者总是画在被遮挡者之上。
+     */
+    static void computeCompiledPlayfield(const LevelConfig& levelConfig, CompiledPlayfield& outCompiled);
+    
+    /**
+     * @brief 编译关卡，把预编译数据附加到配置上
+     * @param levelConfig 关卡配置
+     * @return 配置有效返回true
+     */
+    static bool compile(LevelConfig& levelConfig);
+    
+    /**
+     * @brief 按模型自身的主牌区计算预编译数据并关联到模型（没有关卡配置的模型，如测试数据、合成局面）
+     * @param gameModel 游戏模型，主牌区卡牌ID须依次为0..n-1（与GameModel::setCompiledPlayfield的要求相同）
+     * @return 已关联或关联成功返回true；主牌区不完整时返回false，模型不变
+     * 
+     * 计算一次O(n²)，之后规则接口的每步操作都按遮挡关系增量更新。
+     */
+    static bool compileModel(GameModel& gameModel);
+    
+    /**
+     * @brief 检查关卡的预编译数据是否与当前布局一致
+     * @param levelConfig 关卡配置
+     * @return 已编译且数据与重新计算的结果相同返回true
+     */
+    static bool isUpToDate(const LevelConfig& levelConfig);
+
+private:
+    /**
+     * @brief 私有构造函数，禁止实例化
+     */
+    LevelCompiler() = delete;
+};
+
+#endif // __LEVEL_COMPILER_H__
@@ -0,0 +1,260 @@
+/**
+ * @file LevelGenerator.cpp
+ * @brief 程序化关卡生成服务实现
+ */
+
+#include "services/LevelGenerator.h"
+#include "services/GameModelGenerator.h"
+#include "services/ReplayService.h"
+#include "utils/DeterministicRandom.h"
+#include "utils/MatchRules.h"
+#include <algorithm>
+#include <vector>
+
+USING_NS_CC;
+
+namespace
+{
+    /// 每行最多的叠数
+    const int kPilesPerRow = 5;
+    
+    /// 同一叠内相邻两层的纵向偏移
+    const float kLayerOffsetY = 50.0f;
+    
+    /// 叠与叠之间的水平间距
+    const float kPileSpacingX = 200.0f;
+    
+    /// 每叠位置的最大水平抖动
+    const int kJitterX = 20;
+    
+    CardFaceType randomFace(DeterministicRandom& rng)
+    {
+        return static_cast<CardFaceType>(rng.nextBelow(static_cast<int>(CardFaceType::COUNT)));
+    }
+    
+    CardSuitType randomSuit(DeterministicRandom& rng)
+    {
+        return static_cast<CardSuitType>(rng.nextBelow(static_cast<int>(CardSuitType::COUNT)));
+    }
+    
+    /**
+     * @brief 两个点数在默认规则下是否无论花色都能匹配（花色在输出时才随机分配）
+     */
+    bool matchesForAllSuits(int face1, int face2)
+    {
+        const int suitCount = static_cast<int>(CardSuitType::COUNT);
+        for (int suit1 = 0; suit1 < suitCount; suit1++)
+        {
+            for (int suit2 = 0; suit2 < suitCount; suit2++)
+            {
+                int index1 = MatchRules::toIndex(static_cast<CardSuitType>(suit1), static_cast<CardFaceType>(face1));
+                int index2 = MatchRules::toIndex(static_cast<CardSuitType>(suit2), static_cast<CardFaceType>(face2));
+                if (!MatchRules::Table<MatchRules::Default>::matches(index1, index2))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+    
+    /**
+     * @brief 按默认规则的匹配表随机取一个能与指定点数匹配的点数
+     * @return 匹配的点数，没有候选时为NONE
+     */
+    CardFaceType randomMatchingFace(DeterministicRandom& rng, CardFaceType face)
+    {
+        // 候选按点数差从小到大排列，默认规则下依次为+1和-1（A和K相连）
+        const int faceCount = static_cast<int>(CardFaceType::COUNT);
+        int candidates[static_cast<int>(CardFaceType::COUNT)];
+        int candidateCount = 0;
+        for (int step = 1; step < faceCount; step++)
+        {
+            int candidate = (static_cast<int>(face) + step) % faceCount;
+            if (matchesForAllSuits(static_cast<int>(face), candidate))
+            {
+                candidates[candidateCount++] = candidate;
+            }
+        }
+        if (candidateCount == 0)
+        {
+            return CardFaceType::NONE;
+        }
+        return static_cast<CardFaceType>(candidates[rng.nextBelow(candidateCount)]);
+    }
+    
+    /**
+     * @brief 生成分叠布局，返回的位置按y从大到小排列（先画的在下层）
+     */
+    void buildLayout(DeterministicRandom& rng, int cardCount, int depth, std::vector<Vec2>& outPositions)
+    {
+        int pileCount = (cardCount + depth - 1) / depth;
+        int rowCount = (pileCount + kPilesPerRow - 1) / kPilesPerRow;
+        
+        // 行高按叠高计算，放不下时压缩行距（压缩后叠与叠之间也会产生遮挡，但仍可通关）
+        float pileHeight = GameConstants::kCardHeight + (depth - 1) * kLayerOffsetY;
+        float rowHeight = pileHeight + 40.0f;
+        float usableHeight = GameConstants::kPlayFieldHeight - GameConstants::kCardHeight;
+        if (rowCount > 1 && rowHeight * (rowCount - 1) + pileHeight > usableHeight)
+        {
+            rowHeight = (usableHeight - pileHeight) / (rowCount - 1);
+        }
+        float topY = GameConstants::kPlayFieldHeight - GameConstants::kCardHeight / 2 - 40.0f;
+        
+        outPositions.clear();
+        int placed = 0;
+        for (int pile = 0; pile < pileCount; pile++)
+        {
+            int row = pile / kPilesPerRow;
+            int column = pile % kPilesPerRow;
+            int pilesInRow = std::min(kPilesPerRow, pileCount - row * kPilesPerRow);
+            float rowWidth = (pilesInRow - 1) * kPileSpacingX;
+            float x = (GameConstants::kPlayFieldWidth - rowWidth) / 2 + column * kPileSpacingX
+                + static_cast<float>(rng.nextBelow(2 * kJitterX + 1) - kJitterX);
+            float y = topY - row * rowHeight;
+            
+            for (int layer = 0; layer < depth && placed < cardCount; layer++, placed++)
+            {
+                outPositions.push_back(Vec2(x, std::max(y - layer * kLayerOffsetY, GameConstants::kCardHeight / 2)));
+            }
+        }
+        
+        std::stable_sort(outPositions.begin(), outPositions.end(), [](const Vec2& a, const Vec2& b) {
+            return a.y > b.y;
+        });
+    }
+}
+
+bool LevelGenerator::generate(const LevelGeneratorParams& params,
+                              LevelConfig& outConfig,
+                              ReplayModel* outSolution)
+{
+    int cardCount = params.playfieldCardCount;
+    int depth = params.overlapDepth;
+    int reserveCount = params.reserveCardCount;
+    if (cardCount < 1 || cardCount > kMaxPlayfieldCards ||
+        depth < 1 || depth > kMaxOverlapDepth || reserveCount < 0)
+    {
+        CCLOG("LevelGenerator: Invalid params (cards %d, depth %d, reserve %d)", cardCount, depth, reserveCount);
+        return false;
+    }
+    
+    DeterministicRandom rng(params.seed);
+    
+    // 1. 布局与遮挡关系（卡牌下标即生成后的卡牌ID）
+    std::vector<Vec2> positions;
+    buildLayout(rng, cardCount, depth, positions);
+    
+    std::vector<CardModel> cards(cardCount);
+    for (int i = 0; i < cardCount; i++)
+    {
+        cards[i].setPosition(positions[i]);
+    }
+    
+    std::vector<int> coverCount(cardCount, 0);          // 仍在场上的遮挡者数量
+    std::vector<std::vector<int>> covers(cardCount);    // 该卡牌遮挡的卡牌
+    for (int upper = 0; upper < cardCount; upper++)
+    {
+        for (int lower = 0; lower < cardCount; lower++)
+        {
+            if (upper != lower && GameModelGenerator::isCardCovering(cards[upper], cards[lower]))
+            {
+                covers[upper].push_back(lower);
+                coverCount[lower]++;
+            }
+        }
+    }
+    
+    // 2. 随机消除顺序：每次从未被遮挡的卡牌中随机选一张
+    std::vector<int> available;
+    for (int i = 0; i < cardCount; i++)
+    {
+        if (coverCount[i] == 0)
+        {
+            available.push_back(i);
+        }
+    }
+    
+    std::vector<int> removalOrder;
+    removalOrder.reserve(cardCount);
+    while (!available.empty())
+    {
+        int pick = rng.nextBelow(static_cast<int>(available.size()));
+        int card = available[pick];
+        available[pick] = available.back();
+        available.pop_back();
+        removalOrder.push_back(card);
+        
+        for (int lower : covers[card])
+        {
+            if (--coverCount[lower] == 0)
+            {
+                available.push_back(lower);
+            }
+        }
+    }
+    
+    // 3. 沿消除顺序分配点数，穿插翻牌；翻出的牌为新的顶部牌
+    std::vector<CardFaceType> faces(cardCount, CardFaceType::NONE);
+    std::vector<CardFaceType> drawnFaces;
+    ReplayModel solution;
+    CardFaceType topFace = randomFace(rng);
+    CardFaceType initialTopFace = topFace;
+    
+    for (int i = 0; i < cardCount; i++)
+    {
+        int removalsLeft = cardCount - i;
+        int drawsLeft = reserveCount - static_cast<int>(drawnFaces.size());
+        if (drawsLeft > 0 && rng.nextBelow(removalsLeft + drawsLeft) < drawsLeft)
+        {
+            topFace = randomFace(rng);
+            drawnFaces.push_back(topFace);
+            solution.addAction(ReplayAction(GameActionType::RESERVE_TO_STACK, -1));
+        }
+        
+        int card = removalOrder[i];
+        faces[card] = randomMatchingFace(rng, topFace);
+        if (faces[card] == CardFaceType::NONE)
+        {
+            CCLOG("LevelGenerator: Default match rule has no face matching %d", static_cast<int>(topFace));
+            return false;
+        }
+        topFace = faces[card];
+        solution.addAction(ReplayAction(GameActionType::PLAYFIELD_TO_STACK, card));
+    }
+    
+    // 4. 输出配置：备用牌堆从末尾翻起，未用到的牌放在前面
+    int levelId = outConfig.getLevelId();
+    outConfig.clear();
+    outConfig.setLevelId(levelId);
+    for (int i = 0; i < cardCount; i++)
+    {
+        outConfig.addPlayfieldCard(CardConfigData(faces[i], randomSuit(rng), positions[i]));
+    }
+    
+    outConfig.addStackCard(CardConfigData(initialTopFace, randomSuit(rng), Vec2::ZERO));
+    int unusedCount = reserveCount - static_cast<int>(drawnFaces.size());
+    for (int i = 0; i < unusedCount; i++)
+    {
+        outConfig.addStackCard(CardConfigData(randomFace(rng), randomSuit(rng), Vec2::ZERO));
+    }
+    for (auto iter = drawnFaces.rbegin(); iter != drawnFaces.rend(); ++iter)
+    {
+        outConfig.addStackCard(CardConfigData(*iter, randomSuit(rng), Vec2::ZERO));
+    }
+    
+    if (outSolution)
+    {
+        // 重放一遍得到终局状态，使录像可直接通过ReplayService::verify校验
+        solution.setLevel(levelId, outConfig.computeContentHash());
+        ReplayResult result;
+        if (!ReplayService::play(outConfig, solution, result))
+        {
+            CCLOG("LevelGenerator: Planned solution is not playable");
+            return false;
+        }
+        solution.setClaimedResult(result.isWin, result.finalStateHash);
+        *outSolution = solution;
+    }
+    return true;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file LevelGenerator.h
+ * @brief 程序化关卡生成服务
+ * 
+ * 按随机种子生成主牌区布局和备用牌堆，输出LevelConfig。
+ * 生成时先规划一条完整的通关路线，再按路线为每张牌分配点数，
+ * 因此生成的每个关卡都保证可以通关。
+ * 
+ * 路线按默认匹配规则（MatchRules::Default，与GameRules、ReplayService一致）规划，
+ * 只保证在默认规则下可以通关；用其他规则评估（如DifficultyEstimator::estimateWithRule）时不保证可解。
+ */
+
+#ifndef __LEVEL_GENERATOR_H__
+#define __LEVEL_GENERATOR_H__
+
+#include "configs/LevelConfig.h"
+#include "models/ReplayModel.h"
+#include <cstdint>
+
+/**
+ * @brief 关卡生成参数
+ */
+struct LevelGeneratorParams
+{
+    uint32_t seed;              ///< 随机种子，相同参数和种子生成相同关卡
+    int playfieldCardCount;     ///< 主牌区卡牌数量
+    int overlapDepth;           ///< 每叠卡牌的层数（1表示互不遮挡）
+    int reserveCardCount;       ///< 备用牌堆数量（不含初始顶部牌）
+    
+    LevelGeneratorParams()
+        : seed(1)
+        , playfieldCardCount(12)
+        , overlapDepth(2)
+        , reserveCardCount(8)
+    {
+    }
+};
+
+/**
+ * @brief 程序化关卡生成服务类
+ * 
+ * 生成步骤：
+ * 1. 按层数把卡牌排成若干叠，计算遮挡关系
+ * 2. 随机选取一个满足遮挡顺序的消除顺序，并穿插备用牌翻牌
+ * 3. 沿该顺序为每张牌分配按默认规则能与当时顶部牌匹配的点数
+ * 符合services层的设计规范：无状态、可静态调用。
+ */
+class LevelGenerator
+{
+public:
+    /// 主牌区卡牌数量上限（录像中卡牌ID的可表示范围内）
+    static const int kMaxPlayfieldCards = 256;
+    
+    /// 每叠卡牌的最大层数
+    static const int kMaxOverlapDepth = 8;
+    
+    /**
+     * @brief 生成关卡
+     * @param params 生成参数
+     * @param outConfig 输出的关卡配置（保留原有的关卡ID）
+     * @param outSolution 可选，输出规划的通关录像（可直接用ReplayService校验）
+     * @return 参数有效并生成成功返回true
+     */
+    static bool generate(const LevelGeneratorParams& params,
+                         LevelConfig& outConfig,
+                         ReplayModel* outSolution = nullptr);
+
+private:
+    /**
+     * @brief 私有构造函数，禁止实例化
+     */
+    LevelGenerator() = delete;
+};
+
+#endif // __LEVEL_GENERATOR_H__
@@ -0,0 +1,179 @@
+/**
+ * @file ReplayService.cpp
+ * @brief 录像回放服务实现
+ */
+
+#include "services/ReplayService.h"
+#include "services/GameModelGenerator.h"
+#include "services/LevelCompiler.h"
+#include "managers/UndoManager.h"
+#include "cocos2d.h"
+
+USING_NS_CC;
+
+bool ReplayService::play(const LevelConfig& levelConfig,
+                         const ReplayModel& replay,
+                         ReplayResult& outResult,
+                         GameModel* outFinalModel)
+{
+    outResult = ReplayResult();
+    
+    // 未编译的关卡先编译一份副本，回放中可点击状态增量更新，不再每步全量扫描
+    const LevelConfig* playConfig = &levelConfig;
+    LevelConfig compiledConfig;
+    if (!levelConfig.isCompiled())
+    {
+        compiledConfig = levelConfig;
+        if (!LevelCompiler::compile(compiledConfig))
+        {
+            return false;
+        }
+        playConfig = &compiledConfig;
+    }
+    
+    GameModel gameModel;
+    if (!GameModelGenerator::generate(*playConfig, gameModel))
+    {
+        return false;
+    }
+    
+    UndoManager undoManager;
+    undoManager.init(&gameModel);
+    
+    const auto& actions = replay.getActions();
+    bool isLegal = true;
+    for (size_t i = 0; i < actions.size(); i++)
+    {
+        const ReplayAction& action = actions[i];
+        GameRuleResult result;
+        switch (action.type)
+        {
+            case GameActionType::PLAYFIELD_TO_STACK:
+                result = GameRules::applyPlayfieldToStack(gameModel, &undoManager, action.cardId);
+                break;
+                
+            case GameActionType::RESERVE_TO_STACK:
+                result = GameRules::applyReserveToStack(gameModel, &undoManager);
+                break;
+                
+            case GameActionType::UNDO:
+                result = GameRules::applyUndo(gameModel, undoManager);
+                break;
+                
+            default:
+                result = GameRuleResult::CARD_NOT_FOUND;
+                break;
+        }
+        
+        if (result != GameRuleResult::OK)
+        {
+            isLegal = false;
+            outResult.failedActionIndex = static_cast<int>(i);
+            outResult.failedReason = result;
+            break;
+        }
+        outResult.appliedActionCount++;
+    }
+    
+    outResult.isLegal = isLegal;
+    outResult.isWin = GameRules::isWin(gameModel);
+    outResult.finalStateHash = gameModel.computeStateHash();
+    outResult.remainingPlayfieldCards = gameModel.getPlayfieldCardCount();
+    outResult.remainingReserveCards = gameModel.getReserveCardCount();
+    
+    if (outFinalModel)
+    {
+        *outFinalModel = gameModel;
+    }
+    return isLegal;
+}
+
+ReplayVerdict ReplayService::verify(const LevelConfig& levelConfig,
+                                    const ReplayModel& replay,
+                                    ReplayResult& outResult)
+{
+    outResult = ReplayResult();
+    
+    if (!levelConfig.isValid())
+    {
+        return ReplayVerdict::INVALID_LEVEL;
+    }
+    
+    if (levelConfig.computeContentHash() != replay.getLevelHash())
+    {
+        return ReplayVerdict::LEVEL_MISMATCH;
+    }
+    
+    if (!play(levelConfig, replay, outResult))
+    {
+        return ReplayVerdict::ILLEGAL_ACTION;
+    }
+    
+    if (outResult.isWin != replay.isClaimedWin())
+    {
+        return ReplayVerdict::RESULT_MISMATCH;
+    }
+    
+    if (outResult.finalStateHash != replay.getClaimedStateHash())
+    {
+        return ReplayVerdict::STATE_MISMATCH;
+    }
+    
+    return ReplayVerdict::ACCEPTED;
+}
+
+const char* ReplayService::getVerdictDescription(ReplayVerdict verdict)
+{
+    switch (verdict)
+    {
+        case ReplayVerdict::ACCEPTED:        return "accepted";
+        case ReplayVerdict::INVALID_LEVEL:   return "invalid level config";
+        case ReplayVerdict::LEVEL_MISMATCH:  return "level content hash mismatch";
+        case ReplayVerdict::ILLEGAL_ACTION:  return "illegal action";
+        case ReplayVerdict::RESULT_MISMATCH: return "claimed win/loss does not match";
+        case ReplayVerdict::STATE_MISMATCH:  return "claimed final state does not match";
+        default: return "unknown";
+    }
+}
+
+bool ReplayService::saveToFile(const std::string& filePath, const ReplayModel& replay)
+{
+    std::vector<uint8_t> buffer;
+    if (!replay.serializeBinary(buffer))
+    {
+        CCLOG("ReplayService: Card id out of range, replay not saved");
+        return false;
+    }
+    
+    Data data;
+    data.copy(buffer.data(), static_cast<ssize_t>(buffer.size()));
+    if (!FileUtils::getInstance()->writeDataToFile(data, filePath))
+    {
+        CCLOG("ReplayService: Failed to write %s", filePath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool ReplayService::loadFromFile(const std::string& filePath, ReplayModel& outReplay)
+{
+    auto fileUtils = FileUtils::getInstance();
+    if (!fileUtils->isFileExist(filePath))
+    {
+        return false;
+    }
+    
+    Data data = fileUtils->getDataFromFile(filePath);
+    if (data.isNull())
+    {
+        CCLOG("ReplayService: Failed to read %s", filePath.c_str());
+        return false;
+    }
+    
+    return outReplay.deserializeBinary(data.getBytes(), static_cast<size_t>(data.getSize()));
+}
+
+std::string ReplayService::getDefaultReplayPath()
+{
+    return FileUtils::getInstance()->getWritablePath() + "last_session.replay";
+}
@@ -0,0 +1,129 @@
+/**
+ * @file ReplayService.h
+ * @brief 录像回放服务
+ * 
+ * 负责录像文件的读写，以及在无界面环境下按游戏规则快速重放录像、
+ * 校验操作合法性和终局结果。
+ */
+
+#ifndef __REPLAY_SERVICE_H__
+#define __REPLAY_SERVICE_H__
+
+#include "models/ReplayModel.h"
+#include "models/GameModel.h"
+#include "configs/LevelConfig.h"
+#include "services/GameRules.h"
+#include <string>
+
+/**
+ * @brief 单次回放的结果
+ */
+struct ReplayResult
+{
+    bool isLegal;                   ///< 所有操作是否合法
+    int failedActionIndex;          ///< 第一个非法操作的下标，合法时为-1
+    GameRuleResult failedReason;    ///< 非法原因
+    size_t appliedActionCount;      ///< 成功执行的操作数量
+    bool isWin;                     ///< 终局是否获胜
+    uint32_t finalStateHash;        ///< 终局状态哈希
+    size_t remainingPlayfieldCards; ///< 终局主牌区剩余数量
+    size_t remainingReserveCards;   ///< 终局备用牌堆剩余数量
+    
+    ReplayResult()
+        : isLegal(false)
+        , failedActionIndex(-1)
+        , failedReason(GameRuleResult::OK)
+        , appliedActionCount(0)
+        , isWin(false)
+        , finalStateHash(0)
+        , remainingPlayfieldCards(0)
+        , remainingReserveCards(0)
+    {
+    }
+};
+
+/**
+ * @brief 录像校验结论枚举
+ */
+enum class ReplayVerdict
+{
+    ACCEPTED = 0,       ///< 校验通过
+    INVALID_LEVEL,      ///< 关卡配置无效
+    LEVEL_MISMATCH,     ///< 关卡内容哈希不一致
+    ILLEGAL_ACTION,     ///< 存在非法操作
+    RESULT_MISMATCH,    ///< 声明的胜负与重放结果不一致
+    STATE_MISMATCH      ///< 声明的终局状态与重放结果不一致
+};
+
+/**
+ * @brief 录像回放服务类
+ * 
+ * 回放通过GameRules执行，与GameController使用完全相同的规则。
+ * 符合services层的设计规范：无状态、可静态调用。
+ */
+class ReplayService
+{
+public:
+    /**
+     * @brief 按关卡配置重放录像
+     * @param levelConfig 关卡配置
+     * @param replay 录像
+     * @param outResult 输出的回放结果
+     * @param outFinalModel 可选，输出终局模型
+     * @return 关卡有效且所有操作合法返回true
+     * 
+     * 未编译的关卡每次调用都要先编译一份副本，反复回放同一关卡时应先编译后传入。
+     */
+    static bool play(const LevelConfig& levelConfig,
+                     const ReplayModel& replay,
+                     ReplayResult& outResult,
+                     GameModel* outFinalModel = nullptr);
+    
+    /**
+     * @brief 重放并校验录像声明的结果
+     * @param levelConfig 关卡配置
+     * @param replay 录像
+     * @param outResult 输出的回放结果
+     * @return 校验结论
+     */
+    static ReplayVerdict verify(const LevelConfig& levelConfig,
+                                const ReplayModel& replay,
+                                ReplayResult& outResult);
+    
+    /**
+     * @brief 获取校验结论的文字描述
+     * @param verdict 校验结论
+     * @return 描述字符串
+     */
+    static const char* getVerdictDescription(ReplayVerdict verdict);
+    
+    /**
+     * @brief 保存录像到文件
+     * @param filePath 文件完整路径
+     * @param replay 录像
+     * @return 保存成功返回true
+     */
+    static bool saveToFile(const std::string& filePath, const ReplayModel& replay);
+    
+    /**
+     * @brief 从文件加载录像
+     * @param filePath 文件完整路径
+     * @param outReplay 输出的录像
+     * @return 加载成功返回true
+     */
+    static bool loadFromFile(const std::string& filePath, ReplayModel& outReplay);
+    
+    /**
+     * @brief 获取默认录像文件路径（可写目录下，保存最近一局）
+     * @return 文件完整路径
+     */
+    static std::string getDefaultReplayPath();
+
+private:
+    /**
+     * @brief 私有构造函数，禁止实例化
+     */
+    ReplayService() = delete;
+};
+
+#endif // __REPLAY_SERVICE_H__
@@ -0,0 +1,129 @@
+/**
+ * @file StressLayoutGenerator.cpp
+ * @brief 压力测试布局生成服务实现
+ */
+
+#include "services/StressLayoutGenerator.h"
+#include "models/CardModel.h"
+#include "utils/DeterministicRandom.h"
+#include <algorithm>
+#include <cmath>
+
+USING_NS_CC;
+
+namespace
+{
+    /// 网格布局（无重叠）时相邻卡牌之间的空隙
+    const float kGridGap = 10.0f;
+    
+    /**
+     * @brief 布局范围是否在卡牌模型的坐标范围内，超出时输出日志
+     */
+    bool fitsCoordinateRange(float width, float height)
+    {
+        if (width > CardModel::kMaxCoordinate || height > CardModel::kMaxCoordinate)
+        {
+            CCLOG("StressLayoutGenerator: Layout %.0fx%.0f exceeds coordinate range %d, raise the density",
+                  width, height, CardModel::kMaxCoordinate);
+            return false;
+        }
+        return true;
+    }
+    
+    CardConfigData randomCard(DeterministicRandom& rng, const Vec2& position)
+    {
+        CardFaceType face = static_cast<CardFaceType>(rng.nextBelow(static_cast<int>(CardFaceType::COUNT)));
+        CardSuitType suit = static_cast<CardSuitType>(rng.nextBelow(static_cast<int>(CardSuitType::COUNT)));
+        return CardConfigData(face, suit, position);
+    }
+}
+
+bool StressLayoutGenerator::generate(const StressLayoutParams& params, LevelConfig& outConfig)
+{
+    if (params.playfieldCardCount < 1 || params.playfieldCardCount > kMaxPlayfieldCards
+        || params.overlapDensity < 0.0f || params.reserveCardCount < 0)
+    {
+        CCLOG("StressLayoutGenerator: Invalid params (cards %d, density %.2f, reserve %d)",
+              params.playfieldCardCount, params.overlapDensity, params.reserveCardCount);
+        return false;
+    }
+    
+    DeterministicRandom rng(params.seed);
+    int levelId = outConfig.getLevelId();
+    outConfig.clear();
+    outConfig.setLevelId(levelId);
+    
+    const int cardCount = params.playfieldCardCount;
+    const float cardWidth = GameConstants::kCardWidth;
+    const float cardHeight = GameConstants::kCardHeight;
+    const float aspect = GameConstants::kPlayFieldWidth / GameConstants::kPlayFieldHeight;
+    
+    if (params.overlapDensity <= 0.0f)
+    {
+        // 互不重叠：按主牌区宽高比排成网格
+        float cellWidth = cardWidth + kGridGap;
+        float cellHeight = cardHeight + kGridGap;
+        int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(cardCount * aspect * cellHeight / cellWidth))));
+        int rows = (cardCount + columns - 1) / columns;
+        if (!fitsCoordinateRange(columns * cellWidth, rows * cellHeight))
+        {
+            return false;
+        }
+        for (int i = 0; i < cardCount; i++)
+        {
+            Vec2 position(cellWidth / 2 + (i % columns) * cellWidth,
+                          cellHeight / 2 + (i / columns) * cellHeight);
+            outConfig.addPlayfieldCard(randomCard(rng, position));
+        }
+    }
+    else
+    {
+        // 按期望重叠数反推散布面积，面积不小于一张牌
+        float area = (cardCount - 1) * 4.0f * cardWidth * cardHeight / params.overlapDensity;
+        float spreadWidth = std::max(1.0f, std::sqrt(area * aspect));
+        float spreadHeight = std::max(1.0f, area / spreadWidth);
+        if (!fitsCoordinateRange(cardWidth + spreadWidth, cardHeight + spreadHeight))
+        {
+            return false;
+        }
+        for (int i = 0; i < cardCount; i++)
+        {
+            Vec2 position(cardWidth / 2 + rng.nextBelow(static_cast<int>(spreadWidth) + 1),
+                          cardHeight / 2 + rng.nextBelow(static_cast<int>(spreadHeight) + 1));
+            outConfig.addPlayfieldCard(randomCard(rng, position));
+        }
+    }
+    
+    // 初始顶部牌 + 备用牌堆
+    for (int i = 0; i <= params.reserveCardCount; i++)
+    {
+        outConfig.addStackCard(randomCard(rng, Vec2::ZERO));
+    }
+    
+    return true;
+}
+
+Rect StressLayoutGenerator::computeLayoutBounds(const LevelConfig& levelConfig)
+{
+    const auto& cards = levelConfig.getPlayfieldCards();
+    if (cards.empty())
+    {
+        return Rect::ZERO;
+    }
+    
+    float minX = cards[0].position.x;
+    float maxX = minX;
+    float minY = cards[0].position.y;
+    float maxY = minY;
+    for (const auto& card : cards)
+    {
+        minX = std::min(minX, card.position.x);
+        maxX = std::max(maxX, card.position.x);
+        minY = std::min(minY, card.position.y);
+        maxY = std::max(maxY, card.position.y);
+    }
+    
+    // 位置是卡牌中心，四周各扩半张牌
+    return Rect(minX - GameConstants::kCardWidth / 2, minY - GameConstants::kCardHeight / 2,
+                maxX - minX + GameConstants::kCardWidth, maxY - minY + GameConstants::kCardHeight);
+}
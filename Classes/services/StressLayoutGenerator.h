@@ -0,0 +1,71 @@
+/**
+ * @file StressLayoutGenerator.h
+ * @brief 压力测试布局生成服务
+ * 
+ * 按随机种子生成上百到上万张牌的主牌区布局，用于测量规则、模型和视图在大牌面下的开销。
+ * 只控制牌数和重叠密度，点数花色随机，不保证可以通关（可通关关卡请用LevelGenerator）。
+ */
+
+#ifndef __STRESS_LAYOUT_GENERATOR_H__
+#define __STRESS_LAYOUT_GENERATOR_H__
+
+#include "configs/LevelConfig.h"
+#include <cstdint>
+
+/**
+ * @brief 压力布局参数
+ */
+struct StressLayoutParams
+{
+    uint32_t seed;              ///< 随机种子，相同参数和种子生成相同布局
+    int playfieldCardCount;     ///< 主牌区卡牌数量
+    float overlapDensity;       ///< 每张牌平均与多少张牌重叠，0表示排成互不重叠的网格
+    int reserveCardCount;       ///< 备用牌堆数量（不含初始顶部牌）
+    
+    StressLayoutParams()
+        : seed(1)
+        , playfieldCardCount(1000)
+        , overlapDensity(4.0f)
+        , reserveCardCount(24)
+    {
+    }
+};
+
+/**
+ * @brief 压力测试布局生成服务类
+ * 
+ * 重叠密度大于0时，卡牌中心均匀散布在一个与主牌区同宽高比的矩形内，
+ * 矩形面积按期望重叠数反推：两张牌中心横纵距离都小于牌宽高时重叠，
+ * 因此每张牌平均重叠数约为 (n-1)*4*宽*高/面积（忽略边缘效应，实际略低）。
+ * 布局可能远大于主牌区，显示时需要整体缩放。
+ * 符合services层的设计规范：无状态、可静态调用。
+ */
+class StressLayoutGenerator
+{
+public:
+    /// 主牌区卡牌数量上限
+    static const int kMaxPlayfieldCards = 10000;
+    
+    /**
+     * @brief 生成布局
+     * @param params 生成参数
+     * @param outConfig 输出的关卡配置（保留原有的关卡ID）
+     * @return 参数有效且布局在卡牌坐标范围（CardModel::kMaxCoordinate）内时返回true
+     */
+    static bool generate(const StressLayoutParams& params, LevelConfig& outConfig);
+    
+    /**
+     * @brief 计算布局中所有卡牌覆盖的范围
+     * @param levelConfig 关卡配置
+     * @return 包含所有主牌区卡牌的最小矩形（无牌时为空矩形）
+     */
+    static cocos2d::Rect computeLayoutBounds(const LevelConfig& levelConfig);
+
+private:
+    /**
+     * @brief 私有构造函数，禁止实例化
+     */
+    StressLayoutGenerator() = delete;
+};
+
+#endif // __STRESS_LAYOUT_GENERATOR_H__
@@ -0,0 +1,97 @@
+/**
+ * @file AllocationCounter.cpp
+ * @brief 堆分配计数实现
+ */
+
+#include "utils/AllocationCounter.h"
+#include "cocos2d.h"
+#include <cstdlib>
+#include <new>
+
+USING_NS_CC;
+
+#if PLAYINGCARDS_ENABLE_ALLOC_COUNTER
+
+namespace
+{
+    // 线程局部的普通整数：operator new里不能再分配，也不必为跨线程读取付出原子操作的代价
+    thread_local uint64_t s_allocCount = 0;
+    thread_local uint64_t s_allocBytes = 0;
+    
+    void* countedAlloc(size_t size)
+    {
+        s_allocCount++;
+        s_allocBytes += size;
+        void* ptr = std::malloc(size ? size : 1);
+        if (!ptr)
+        {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+    
+    void* countedAllocNoThrow(size_t size) noexcept
+    {
+        s_allocCount++;
+        s_allocBytes += size;
+        return std::malloc(size ? size : 1);
+    }
+}
+
+// ========== 全局operator new/delete替换 ==========
+
+void* operator new(size_t size) { return countedAlloc(size); }
+void* operator new[](size_t size) { return countedAlloc(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return countedAllocNoThrow(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return countedAllocNoThrow(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+bool AllocationCounter::isEnabled()
+{
+    return true;
+}
+
+uint64_t AllocationCounter::getAllocationCount()
+{
+    return s_allocCount;
+}
+
+uint64_t AllocationCounter::getAllocatedBytes()
+{
+    return s_allocBytes;
+}
+
+#else
+
+bool AllocationCounter::isEnabled()
+{
+    return false;
+}
+
+uint64_t AllocationCounter::getAllocationCount()
+{
+    return 0;
+}
+
+uint64_t AllocationCounter::getAllocatedBytes()
+{
+    return 0;
+}
+
+#endif
+
+AllocationScope::~AllocationScope()
+{
+    uint64_t count = AllocationCounter::getAllocationCount() - _countBefore;
+    if (count > 0)
+    {
+        CCLOG("AllocationScope: %s made %llu allocations (%llu bytes)", _name,
+              static_cast<unsigned long long>(count),
+              static_cast<unsigned long long>(AllocationCounter::getAllocatedBytes() - _bytesBefore));
+    }
+}
@@ -0,0 +1,94 @@
+/**
+ * @file AllocationCounter.h
+ * @brief 堆分配计数
+ * 
+ * 替换全局operator new，按线程统计分配次数和字节数，用于确认走牌等热路径在稳定状态下不分配内存。
+ * 只有定义了PLAYINGCARDS_ENABLE_ALLOC_COUNTER=1时才编译进来（默认跟随PLAYINGCARDS_ENABLE_TRACE，
+ * 即随CMake选项显式开启，游戏构建默认关闭），关闭时计数恒为0，ALLOC_SCOPE展开为空。
+ * 注意只统计经过operator new的分配，引擎内部直接调用malloc/calloc的不在其中；
+ * 调试版的CCLOG输出本身也会分配，看单次操作的数字时以发布版加本开关为准。
+ */
+
+#ifndef __ALLOCATION_COUNTER_H__
+#define __ALLOCATION_COUNTER_H__
+
+#include "utils/TraceProfiler.h"
+#include <cstdint>
+
+#ifndef PLAYINGCARDS_ENABLE_ALLOC_COUNTER
+#define PLAYINGCARDS_ENABLE_ALLOC_COUNTER PLAYINGCARDS_ENABLE_TRACE
+#endif
+
+/**
+ * @brief 堆分配计数器
+ * 
+ * 计数保存在线程局部变量中，读取不加锁，只反映调用线程自己的分配。
+ */
+class AllocationCounter
+{
+public:
+    /**
+     * @brief 是否编译了计数功能
+     * @return 开启返回true
+     */
+    static bool isEnabled();
+    
+    /**
+     * @brief 获取当前线程累计的分配次数
+     * @return 分配次数
+     */
+    static uint64_t getAllocationCount();
+    
+    /**
+     * @brief 获取当前线程累计分配的字节数
+     * @return 字节数
+     */
+    static uint64_t getAllocatedBytes();
+
+private:
+    /**
+     * @brief 私有构造函数，禁止实例化
+     */
+    AllocationCounter() = delete;
+};
+
+/**
+ * @brief 作用域分配统计，析构时输出该作用域内当前线程的分配次数
+ * 
+ * 没有分配时不输出，日志中出现的每一行都是需要关注的分配。
+ */
+class AllocationScope
+{
+public:
+    explicit AllocationScope(const char* name)
+        : _name(name)
+        , _countBefore(AllocationCounter::getAllocationCount())
+        , _bytesBefore(AllocationCounter::getAllocatedBytes())
+    {
+    }
+    
+    ~AllocationScope();
+    
+    /**
+     * @brief 获取作用域开始以来的分配次数
+     * @return 分配次数
+     */
+    uint64_t getAllocationCount() const { return AllocationCounter::getAllocationCount() - _countBefore; }
+    
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+private:
+    const char* _name;      ///< 作用域名，须为静态字符串
+    uint64_t _countBefore;  ///< 开始时的分配次数
+    uint64_t _bytesBefore;  ///< 开始时的分配字节数
+};
+
+#if PLAYINGCARDS_ENABLE_ALLOC_COUNTER
+/// 统计当前作用域的堆分配，name一般为"类名::方法名"
+#define ALLOC_SCOPE(name) AllocationScope TRACE_CONCAT(_allocScope, __LINE__)(name)
+#else
+#define ALLOC_SCOPE(name) ((void)0)
+#endif
+
+#endif // __ALLOCATION_COUNTER_H__
@@ -0,0 +1,214 @@
+/**
+ * @file BinaryStream.h
+ * @brief 二进制读写工具
+ *
+ * 提供定长、小端序的二进制写入器和读取器，
+ * 用于存档快照等需要快速序列化的场景。
+ */
+
+#ifndef __BINARY_STREAM_H__
+#define __BINARY_STREAM_H__
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/**
+ * @brief 二进制工具函数命名空间
+ *
+ * 所有多字节数值统一按小端序存储，与平台字节序无关。
+ */
+namespace BinaryUtils
+{
+    inline void storeU16(uint8_t* out, uint16_t value)
+    {
+        out[0] = static_cast<uint8_t>(value);
+        out[1] = static_cast<uint8_t>(value >> 8);
+    }
+
+    inline void storeU32(uint8_t* out, uint32_t value)
+    {
+        out[0] = static_cast<uint8_t>(value);
+        out[1] = static_cast<uint8_t>(value >> 8);
+        out[2] = static_cast<uint8_t>(value >> 16);
+        out[3] = static_cast<uint8_t>(value >> 24);
+    }
+
+    inline void storeF32(uint8_t* out, float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        storeU32(out, bits);
+    }
+
+    inline uint16_t loadU16(const uint8_t* in)
+    {
+        return static_cast<uint16_t>(in[0] | (in[1] << 8));
+    }
+
+    inline uint32_t loadU32(const uint8_t* in)
+    {
+        return static_cast<uint32_t>(in[0])
+            | (static_cast<uint32_t>(in[1]) << 8)
+            | (static_cast<uint32_t>(in[2]) << 16)
+            | (static_cast<uint32_t>(in[3]) << 24);
+    }
+
+    inline float loadF32(const uint8_t* in)
+    {
+        uint32_t bits = loadU32(in);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    /**
+     * @brief 计算FNV-1a校验值
+     * @param data 数据起始地址
+     * @param size 数据长度
+     * @return 32位校验值
+     */
+    inline uint32_t fnv1a(const uint8_t* data, size_t size)
+    {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= data[i];
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+}
+
+/**
+ * @brief 二进制写入器
+ *
+ * 追加写入到外部提供的字节数组，不持有数据。
+ */
+class BinaryWriter
+{
+public:
+    explicit BinaryWriter(std::vector<uint8_t>& buffer)
+        : _buffer(buffer)
+    {
+    }
+
+    /**
+     * @brief 预留一段定长空间并返回写入地址
+     * @param size 字节数
+     * @return 可直接写入的地址（下次追加前有效）
+     */
+    uint8_t* append(size_t size)
+    {
+        size_t offset = _buffer.size();
+        _buffer.resize(offset + size);
+        return _buffer.data() + offset;
+    }
+
+    void writeU8(uint8_t value) { _buffer.push_back(value); }
+    void writeU16(uint16_t value) { BinaryUtils::storeU16(append(2), value); }
+    void writeU32(uint32_t value) { BinaryUtils::storeU32(append(4), value); }
+    void writeI32(int32_t value) { writeU32(static_cast<uint32_t>(value)); }
+    void writeF32(float value) { BinaryUtils::storeF32(append(4), value); }
+
+    /**
+     * @brief 获取当前已写入的字节数
+     */
+    size_t size() const { return _buffer.size(); }
+
+private:
+    std::vector<uint8_t>& _buffer;
+};
+
+/**
+ * @brief 二进制读取器
+ *
+ * 直接在外部缓冲区上读取，不复制数据。
+ * 越界读取会置失败标记，之后的读取全部返回失败。
+ */
+class BinaryReader
+{
+public:
+    BinaryReader(const uint8_t* data, size_t size)
+        : _data(data)
+        , _size(size)
+        , _offset(0)
+        , _failed(false)
+    {
+    }
+
+    /**
+     * @brief 取出一段定长数据的地址并前移读取位置
+     * @param size 字节数
+     * @return 数据地址，越界返回nullptr
+     */
+    const uint8_t* consume(size_t size)
+    {
+        if (_failed || size > _size - _offset)
+        {
+            _failed = true;
+            return nullptr;
+        }
+        const uint8_t* ptr = _data + _offset;
+        _offset += size;
+        return ptr;
+    }
+
+    bool readU8(uint8_t& out)
+    {
+        const uint8_t* ptr = consume(1);
+        if (!ptr) return false;
+        out = *ptr;
+        return true;
+    }
+
+    bool readU16(uint16_t& out)
+    {
+        const uint8_t* ptr = consume(2);
+        if (!ptr) return false;
+        out = BinaryUtils::loadU16(ptr);
+        return true;
+    }
+
+    bool readU32(uint32_t& out)
+    {
+        const uint8_t* ptr = consume(4);
+        if (!ptr) return false;
+        out = BinaryUtils::loadU32(ptr);
+        return true;
+    }
+
+    bool readI32(int32_t& out)
+    {
+        uint32_t value = 0;
+        if (!readU32(value)) return false;
+        out = static_cast<int32_t>(value);
+        return true;
+    }
+
+    bool readF32(float& out)
+    {
+        const uint8_t* ptr = consume(4);
+        if (!ptr) return false;
+        out = BinaryUtils::loadF32(ptr);
+        return true;
+    }
+
+    /**
+     * @brief 剩余可读字节数
+     */
+    size_t remaining() const { return _size - _offset; }
+
+    /**
+     * @brief 是否发生过越界读取
+     */
+    bool hasFailed() const { return _failed; }
+
+private:
+    const uint8_t* _data;   ///< 数据起始地址
+    size_t _size;           ///< 数据总长度
+    size_t _offset;         ///< 当前读取位置
+    bool _failed;           ///< 失败标记
+};
+
+#endif // __BINARY_STREAM_H__
@@ -9,8 +9,8 @@
 #define __CARD_UTILS_H__
 
 #include <string>
-#include <cstdlib>
 #include "configs/CardTypes.h"
+#include "utils/MatchRules.h"
 
 /**
  * @brief 卡牌工具函数命名空间
@@ -71,36 +71,17 @@ namespace CardUtils
     }
     
     /**
-     * @brief 判断两张牌是否可以匹配（点数差1）
+     * @brief 判断两张牌是否可以匹配（点数差1，A和K首尾相连）
      * @param face1 第一张牌的点数
      * @param face2 第二张牌的点数
      * @return 可以匹配返回true
+     * 
+     * 该规则与花色无关，按同一花色查编译期匹配表。其他规则见MatchRules。
      */
     inline bool canMatch(CardFaceType face1, CardFaceType face2)
     {
-        if (face1 == CardFaceType::NONE || face2 == CardFaceType::NONE)
-        {
-            return false;
-        }
-        
-        int value1 = static_cast<int>(face1);
-        int value2 = static_cast<int>(face2);
-        int diff = std::abs(value1 - value2);
-        
-        // 点数差1可以匹配
-        if (diff == 1)
-        {
-            return true;
-        }
-        
-        // A和K可以匹配（循环匹配）
-        if ((face1 == CardFaceType::ACE && face2 == CardFaceType::KING) ||
-            (face1 == CardFaceType::KING && face2 == CardFaceType::ACE))
-        {
-            return true;
-        }
-        
-        return false;
+        return MatchRules::Table<MatchRules::AdjacentRank>::matches(MatchRules::toIndex(CardSuitType::CLUBS, face1),
+                                                                    MatchRules::toIndex(CardSuitType::CLUBS, face2));
     }
 }
 
@@ -0,0 +1,153 @@
+/**
+ * @file DeterministicRandom.h
+ * @brief 可复现的随机数生成器
+ * 
+ * 关卡生成、发牌洗牌、难度模拟等需要按种子复现结果的地方统一使用本生成器：
+ * - 算法为xoshiro128**，只用32位整数运算，输出序列与平台、编译器、标准库无关
+ *   （标准库的distribution和std::shuffle各家实现不同，不能用于需要复现的场景）
+ * - 种子经splitmix64展开为内部状态，相近的种子也得到互不相关的序列
+ * - forStream按(种子, 流编号)派生独立的随机数流，如每局、每个样本各用一条流，
+ *   结果只取决于种子和编号，与线程数和执行顺序无关
+ * - nextBelow用Lemire的乘法取范围，无取模偏差，通常不需要除法
+ * 没有全局状态，每个生成器只在一个线程中使用。
+ */
+
+#ifndef __DETERMINISTIC_RANDOM_H__
+#define __DETERMINISTIC_RANDOM_H__
+
+#include <cstdint>
+#include <iterator>
+#include <utility>
+
+/**
+ * @brief 可复现的随机数生成器类
+ */
+class DeterministicRandom
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param seed 种子
+     */
+    explicit DeterministicRandom(uint64_t seed = 0)
+    {
+        uint64_t state = seed;
+        for (int i = 0; i < 4; i += 2)
+        {
+            uint64_t value = splitMix64(state);
+            _state[i] = static_cast<uint32_t>(value);
+            _state[i + 1] = static_cast<uint32_t>(value >> 32);
+        }
+        // 全零状态只会输出零，出现概率可以忽略，仍然排除
+        if ((_state[0] | _state[1] | _state[2] | _state[3]) == 0)
+        {
+            _state[0] = 1;
+        }
+    }
+    
+    /**
+     * @brief 派生独立的随机数流
+     * @param seed 种子
+     * @param streamId 流编号（如关卡ID、样本下标）
+     * @return 该流的生成器，相同的种子和编号总是得到相同的序列
+     */
+    static DeterministicRandom forStream(uint64_t seed, uint64_t streamId)
+    {
+        uint64_t streamState = streamId;
+        return DeterministicRandom(seed ^ splitMix64(streamState));
+    }
+    
+    /**
+     * @brief 从当前序列中分出一个子生成器（当前生成器前进两步）
+     * @return 子生成器
+     */
+    DeterministicRandom split()
+    {
+        uint64_t seed = static_cast<uint64_t>(next()) << 32;
+        seed |= next();
+        return DeterministicRandom(seed);
+    }
+    
+    /**
+     * @brief 下一个32位随机数
+     */
+    uint32_t next()
+    {
+        uint32_t result = rotateLeft(_state[1] * 5, 7) * 9;
+        uint32_t shifted = _state[1] << 9;
+        _state[2] ^= _state[0];
+        _state[3] ^= _state[1];
+        _state[1] ^= _state[2];
+        _state[0] ^= _state[3];
+        _state[2] ^= shifted;
+        _state[3] = rotateLeft(_state[3], 11);
+        return result;
+    }
+    
+    /**
+     * @brief 取[0, bound)内均匀分布的随机整数
+     * @param bound 上界，不大于0时返回0
+     * @return 随机整数
+     */
+    int nextBelow(int bound)
+    {
+        if (bound <= 0)
+        {
+            return 0;
+        }
+        
+        // 32位随机数乘以范围，高32位即结果；低32位落入不足一整轮的区间时重取
+        uint32_t range = static_cast<uint32_t>(bound);
+        uint64_t product = static_cast<uint64_t>(next()) * range;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < range)
+        {
+            uint32_t threshold = (0u - range) % range;
+            while (low < threshold)
+            {
+                product = static_cast<uint64_t>(next()) * range;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<int>(product >> 32);
+    }
+    
+    /**
+     * @brief 原地随机打乱（Fisher-Yates），每种排列的概率相同
+     * @param first 起始迭代器（随机访问）
+     * @param last 结束迭代器
+     */
+    template <typename RandomIt>
+    void shuffle(RandomIt first, RandomIt last)
+    {
+        using std::swap;
+        auto count = std::distance(first, last);
+        for (auto i = count - 1; i > 0; i--)
+        {
+            auto j = nextBelow(static_cast<int>(i + 1));
+            swap(first[i], first[j]);
+        }
+    }
+
+private:
+    static uint32_t rotateLeft(uint32_t value, int shift)
+    {
+        return (value << shift) | (value >> (32 - shift));
+    }
+    
+    /**
+     * @brief splitmix64：推进状态并输出一个充分混合的64位值
+     */
+    static uint64_t splitMix64(uint64_t& state)
+    {
+        state += 0x9E3779B97F4A7C15ull;
+        uint64_t value = state;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+    
+    uint32_t _state[4];     ///< xoshiro128**内部状态
+};
+
+#endif // __DETERMINISTIC_RANDOM_H__
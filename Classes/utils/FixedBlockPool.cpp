@@ -0,0 +1,113 @@
+/**
+ * @file FixedBlockPool.cpp
+ * @brief 固定大小内存块池实现
+ */
+
+#include "utils/FixedBlockPool.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+    /// 块的对齐字节数（满足所有基本类型）
+    const size_t kBlockAlignment = alignof(std::max_align_t);
+}
+
+FixedBlockPool::FixedBlockPool(const char* tag, size_t blockSize, size_t blocksPerPage)
+    : _tag(tag)
+    , _blockSize((std::max(blockSize, sizeof(FreeBlock)) + kBlockAlignment - 1) / kBlockAlignment * kBlockAlignment)
+    , _blocksPerPage(std::max<size_t>(blocksPerPage, 1))
+    , _freeList(nullptr)
+    , _liveCount(0)
+    , _peakCount(0)
+    , _fallbackCount(0)
+{
+    getRegistry().push_back(this);
+}
+
+FixedBlockPool::~FixedBlockPool()
+{
+    auto& registry = getRegistry();
+    registry.erase(std::remove(registry.begin(), registry.end(), this), registry.end());
+    for (void* page : _pages)
+    {
+        ::operator delete(page);
+    }
+}
+
+void* FixedBlockPool::allocate(size_t size)
+{
+    if (size > _blockSize)
+    {
+        _fallbackCount++;
+        return ::operator new(size, std::nothrow);
+    }
+    
+    if (!_freeList && !addPage())
+    {
+        return nullptr;
+    }
+    FreeBlock* block = _freeList;
+    _freeList = block->next;
+    _liveCount++;
+    _peakCount = std::max(_peakCount, _liveCount);
+    return block;
+}
+
+void FixedBlockPool::deallocate(void* block, size_t size)
+{
+    if (!block)
+    {
+        return;
+    }
+    if (size > _blockSize)
+    {
+        ::operator delete(block);
+        return;
+    }
+    
+    FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+    freeBlock->next = _freeList;
+    _freeList = freeBlock;
+    _liveCount--;
+}
+
+bool FixedBlockPool::addPage()
+{
+    char* page = static_cast<char*>(::operator new(_blockSize * _blocksPerPage, std::nothrow));
+    if (!page)
+    {
+        return false;
+    }
+    _pages.push_back(page);
+    
+    // 倒序入链，分配时按地址顺序取出
+    for (size_t i = _blocksPerPage; i > 0; i--)
+    {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(page + (i - 1) * _blockSize);
+        block->next = _freeList;
+        _freeList = block;
+    }
+    return true;
+}
+
+std::string FixedBlockPool::getReport()
+{
+    std::string report;
+    char line[160];
+    for (const FixedBlockPool* pool : getRegistry())
+    {
+        std::snprintf(line, sizeof(line), "%-24s block %4zu B  live %5zu  peak %5zu  capacity %5zu  fallback %zu\n",
+                      pool->_tag, pool->_blockSize, pool->_liveCount, pool->_peakCount,
+                      pool->getCapacity(), pool->_fallbackCount);
+        report += line;
+    }
+    return report;
+}
+
+std::vector<FixedBlockPool*>& FixedBlockPool::getRegistry()
+{
+    // 与池一样不析构，进程退出时的清理顺序不影响登记表
+    static std::vector<FixedBlockPool*>* registry = new std::vector<FixedBlockPool*>();
+    return *registry;
+}
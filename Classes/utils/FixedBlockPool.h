@@ -0,0 +1,163 @@
+/**
+ * @file FixedBlockPool.h
+ * @brief 固定大小内存块池
+ * 
+ * 为频繁创建和销毁的同一种对象（卡牌视图、卡牌精灵、移动动作等）提供定长内存块：
+ * - 按页向全局堆申请内存，每页切成若干等长块，空闲块串成单链表
+ * - 分配和释放都是O(1)的链表操作，释放的块留在池中复用，页在程序结束前不归还
+ * 因此反复开局、翻牌不会在全局堆上留下大小不一的碎片，池的统计也直接给出各类对象的数量。
+ * 
+ * 类通过PLAYINGCARDS_USE_BLOCK_POOL接入（替换该类的operator new/delete），
+ * 所有池登记在同一张表中，getReport()输出各池的使用情况。
+ * 只能在一个线程（cocos主线程）中使用。
+ */
+
+#ifndef __FIXED_BLOCK_POOL_H__
+#define __FIXED_BLOCK_POOL_H__
+
+#include <cstddef>
+#include <new>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 固定大小内存块池类
+ */
+class FixedBlockPool
+{
+public:
+    /**
+     * @brief 构造函数，登记到池列表（首次分配时才申请内存）
+     * @param tag 名称，用于统计输出（须为静态字符串）
+     * @param blockSize 块大小（通常为sizeof(T)），会按对齐要求取整
+     * @param blocksPerPage 每页的块数
+     */
+    FixedBlockPool(const char* tag, size_t blockSize, size_t blocksPerPage);
+    
+    /**
+     * @brief 析构函数，从池列表注销并释放全部页
+     */
+    ~FixedBlockPool();
+    
+    FixedBlockPool(const FixedBlockPool&) = delete;
+    FixedBlockPool& operator=(const FixedBlockPool&) = delete;
+    
+    /**
+     * @brief 分配一块内存
+     * @param size 请求的字节数，大于块大小时（如派生类）转交全局堆
+     * @return 内存地址，内存不足时返回nullptr
+     */
+    void* allocate(size_t size);
+    
+    /**
+     * @brief 释放内存
+     * @param block allocate返回的地址，可为nullptr
+     * @param size 与分配时相同的字节数
+     */
+    void deallocate(void* block, size_t size);
+    
+    // ========== 统计 ==========
+    
+    const char* getTag() const { return _tag; }
+    size_t getBlockSize() const { return _blockSize; }
+    
+    /**
+     * @brief 正在使用的块数（即该类对象的存活数量）
+     */
+    size_t getLiveCount() const { return _liveCount; }
+    
+    /**
+     * @brief 历史最大的同时使用块数
+     */
+    size_t getPeakCount() const { return _peakCount; }
+    
+    /**
+     * @brief 已申请的总块数
+     */
+    size_t getCapacity() const { return _pages.size() * _blocksPerPage; }
+    
+    /**
+     * @brief 因大小超出块大小而转交全局堆的分配次数
+     */
+    size_t getFallbackCount() const { return _fallbackCount; }
+    
+    /**
+     * @brief 输出所有池的使用情况，每个池一行
+     * @return 统计文本
+     */
+    static std::string getReport();
+
+private:
+    /**
+     * @brief 空闲块，复用块本身的内存存放链表指针
+     */
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+    
+    /**
+     * @brief 申请一页并把其中的块加入空闲链表
+     * @return 内存不足时返回false
+     */
+    bool addPage();
+    
+    /**
+     * @brief 所有池的登记表
+     */
+    static std::vector<FixedBlockPool*>& getRegistry();
+    
+    const char* _tag;               ///< 名称
+    size_t _blockSize;              ///< 块大小（已对齐）
+    size_t _blocksPerPage;          ///< 每页的块数
+    FreeBlock* _freeList;           ///< 空闲块链表
+    std::vector<void*> _pages;      ///< 已申请的页
+    size_t _liveCount;              ///< 正在使用的块数
+    size_t _peakCount;              ///< 最大同时使用块数
+    size_t _fallbackCount;          ///< 转交全局堆的分配次数
+};
+
+/**
+ * @brief 在类的public部分使用：该类的对象从专属的块池分配
+ * 
+ * 只替换本类的operator new/delete，派生类因大小不同会自动转交全局堆。
+ * 内存不足时普通new抛出std::bad_alloc，new (std::nothrow)返回nullptr（cocos的create惯例）。
+ * 池由PLAYINGCARDS_DEFINE_BLOCK_POOL在.cpp中定义。
+ */
+#define PLAYINGCARDS_USE_BLOCK_POOL(T)                                                  \
+    static FixedBlockPool& getBlockPool();                                              \
+    static void* operator new(size_t size)                                              \
+    {                                                                                   \
+        void* block = getBlockPool().allocate(size);                                    \
+        if (!block)                                                                     \
+        {                                                                               \
+            throw std::bad_alloc();                                                     \
+        }                                                                               \
+        return block;                                                                   \
+    }                                                                                   \
+    static void* operator new(size_t size, const std::nothrow_t&) noexcept              \
+    {                                                                                   \
+        return getBlockPool().allocate(size);                                           \
+    }                                                                                   \
+    static void operator delete(void* block, size_t size)                               \
+    {                                                                                   \
+        getBlockPool().deallocate(block, size);                                         \
+    }                                                                                   \
+    static void operator delete(void* block, const std::nothrow_t&) noexcept            \
+    {                                                                                   \
+        getBlockPool().deallocate(block, sizeof(T));                                    \
+    }
+
+/**
+ * @brief 在.cpp中定义类T的块池
+ * 
+ * 池在首次使用时创建且不析构，进程退出前才释放的对象（如引擎清理时）也能安全归还。
+ */
+#define PLAYINGCARDS_DEFINE_BLOCK_POOL(T, blocksPerPage)                                \
+    FixedBlockPool& T::getBlockPool()                                                   \
+    {                                                                                   \
+        static FixedBlockPool* pool = new FixedBlockPool(#T, sizeof(T), blocksPerPage); \
+        return *pool;                                                                   \
+    }
+
+#endif // __FIXED_BLOCK_POOL_H__
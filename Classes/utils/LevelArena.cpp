@@ -0,0 +1,103 @@
+/**
+ * @file LevelArena.cpp
+ * @brief 关卡内存池实现
+ */
+
+#include "utils/LevelArena.h"
+#include <algorithm>
+
+const size_t LevelArena::kAlignment;
+const size_t LevelArena::kMinOverflowBytes;
+
+namespace
+{
+    /// 一局内预留的溢出块记录数量，超出后记录本身才会分配
+    const size_t kOverflowReserve = 16;
+}
+
+LevelArena::LevelArena()
+    : _buffer(nullptr)
+    , _capacity(0)
+    , _cursor(nullptr)
+    , _end(nullptr)
+    , _usedBytes(0)
+{
+    _overflowBlocks.reserve(kOverflowReserve);
+}
+
+LevelArena::~LevelArena()
+{
+    releaseOverflowBlocks();
+    ::operator delete(_buffer);
+}
+
+void* LevelArena::allocate(size_t bytes)
+{
+    size_t size = alignedSize(std::max<size_t>(bytes, 1));
+    if (static_cast<size_t>(_end - _cursor) < size)
+    {
+        // 当前块放不下：追加溢出块，之后的分配在新块中继续
+        size_t blockSize = std::max(size, std::max(kMinOverflowBytes, _capacity / 2));
+        char* block = static_cast<char*>(::operator new(blockSize));
+        _overflowBlocks.push_back(block);
+        _cursor = block;
+        _end = block + blockSize;
+    }
+    
+    void* result = _cursor;
+    _cursor += size;
+    _usedBytes += size;
+    return result;
+}
+
+void LevelArena::reset(size_t capacity)
+{
+    size_t required = alignedSize(std::max(capacity, _usedBytes));
+    releaseOverflowBlocks();
+    if (required > _capacity)
+    {
+        ::operator delete(_buffer);
+        _buffer = static_cast<char*>(::operator new(required));
+        _capacity = required;
+    }
+    _cursor = _buffer;
+    _end = _buffer + _capacity;
+    _usedBytes = 0;
+}
+
+void LevelArena::releaseOverflowBlocks()
+{
+    for (void* block : _overflowBlocks)
+    {
+        ::operator delete(block);
+    }
+    _overflowBlocks.clear();
+}
+
+LevelArenaPool::LevelArenaPool()
+{
+    // 当前关与预先构建的下一关各用一个
+    _arenas.reserve(2);
+    _freeArenas.reserve(2);
+}
+
+LevelArena* LevelArenaPool::acquire()
+{
+    if (_freeArenas.empty())
+    {
+        _arenas.push_back(std::make_unique<LevelArena>());
+        _freeArenas.reserve(_arenas.size());
+        return _arenas.back().get();
+    }
+    LevelArena* arena = _freeArenas.back();
+    _freeArenas.pop_back();
+    return arena;
+}
+
+void LevelArenaPool::release(LevelArena* arena)
+{
+    if (arena)
+    {
+        _freeArenas.push_back(arena);
+    }
+}
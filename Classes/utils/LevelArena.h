@@ -0,0 +1,208 @@
+/**
+ * @file LevelArena.h
+ * @brief 关卡内存池（单调分配）
+ * 
+ * 一局内的模型、撤销栈、视图索引等容器都从同一块连续内存中顺序分配：
+ * - 开局时按关卡的牌数预留容量，释放单个对象不回收（单调分配）
+ * - 一局结束时整体回收，只移动游标，O(1)
+ * - 主内存块只在需求变大时扩大，之后一直复用，关卡切换不会在全局堆中留下碎片
+ * 容量不够时从全局堆追加溢出块，下次回收时合并为一块更大的主内存块。
+ * 
+ * 只能在一个线程（主线程）中使用。回收前须先让所有容器释放内存（见各容器的setArena），
+ * 容器的复制总是分配在全局堆上，可以安全地交给其他线程。
+ */
+
+#ifndef __LEVEL_ARENA_H__
+#define __LEVEL_ARENA_H__
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief 关卡内存池类
+ */
+class LevelArena
+{
+public:
+    /// 分配的对齐字节数（满足所有基本类型）
+    static const size_t kAlignment = alignof(std::max_align_t);
+    
+    /// 溢出块的最小字节数
+    static const size_t kMinOverflowBytes = 4096;
+    
+    /**
+     * @brief 构造空内存池（首次回收或分配时才申请内存）
+     */
+    LevelArena();
+    
+    /**
+     * @brief 析构函数，释放全部内存块
+     */
+    ~LevelArena();
+    
+    LevelArena(const LevelArena&) = delete;
+    LevelArena& operator=(const LevelArena&) = delete;
+    
+    /**
+     * @brief 按对齐取整后的字节数，用于估算容量
+     * @param bytes 字节数
+     * @return 取整后的字节数
+     */
+    static size_t alignedSize(size_t bytes) { return (bytes + kAlignment - 1) / kAlignment * kAlignment; }
+    
+    /**
+     * @brief 分配内存
+     * @param bytes 字节数
+     * @return 按kAlignment对齐的内存，内存池回收前一直有效
+     */
+    void* allocate(size_t bytes);
+    
+    /**
+     * @brief 回收全部分配，准备下一局
+     * @param capacity 下一局预计使用的字节数
+     * 
+     * 主内存块容量不小于预计值和上一局实际用量时只移动游标；
+     * 否则释放旧块，按两者中的较大值重新申请一块。
+     */
+    void reset(size_t capacity);
+    
+    /**
+     * @brief 本局已分配的字节数（含对齐填充）
+     */
+    size_t getUsedBytes() const { return _usedBytes; }
+    
+    /**
+     * @brief 主内存块的容量
+     */
+    size_t getCapacity() const { return _capacity; }
+    
+    /**
+     * @brief 本局追加的溢出块数量（非零说明开局时的预计容量偏小）
+     */
+    size_t getOverflowBlockCount() const { return _overflowBlocks.size(); }
+
+private:
+    /**
+     * @brief 释放全部溢出块
+     */
+    void releaseOverflowBlocks();
+    
+    char* _buffer;                      ///< 主内存块
+    size_t _capacity;                   ///< 主内存块容量
+    char* _cursor;                      ///< 当前块中下一次分配的位置
+    char* _end;                         ///< 当前块的末尾
+    size_t _usedBytes;                  ///< 本局已分配的字节数
+    std::vector<void*> _overflowBlocks; ///< 本局追加的溢出块（预留了容量，追加时不分配）
+};
+
+/**
+ * @brief 关卡内存池的所有者，由应用持有，各局的控制器从这里借用
+ * 
+ * 控制器随场景创建和销毁，内存池交给比场景活得久的所有者，主内存块才能跨关卡复用。
+ * 下一关在胜利展示期间预先构建时，当前关仍在使用自己的内存池，
+ * 此时借出另一个，稳定状态下两个内存池交替使用，都不再重新申请。
+ * 只能在主线程中使用，借出的内存池须在所有者析构前归还。
+ */
+class LevelArenaPool
+{
+public:
+    LevelArenaPool();
+    
+    LevelArenaPool(const LevelArenaPool&) = delete;
+    LevelArenaPool& operator=(const LevelArenaPool&) = delete;
+    
+    /**
+     * @brief 借出一个未在使用的内存池，都在使用时新建一个
+     * @return 内存池，归还前由调用者独占
+     */
+    LevelArena* acquire();
+    
+    /**
+     * @brief 归还内存池（归还前须让所有容器释放其中的内存），保留主内存块供下次借出
+     * @param arena acquire借出的内存池，nullptr时忽略
+     */
+    void release(LevelArena* arena);
+    
+    /**
+     * @brief 已创建的内存池数量
+     */
+    size_t size() const { return _arenas.size(); }
+
+private:
+    std::vector<std::unique_ptr<LevelArena>> _arenas;   ///< 全部内存池
+    std::vector<LevelArena*> _freeArenas;               ///< 未借出的内存池，后归还的先借出
+};
+
+/**
+ * @brief 从关卡内存池分配的标准库分配器
+ * 
+ * 不关联内存池时使用全局堆，与std::allocator相同。
+ * 复制构造容器时副本使用全局堆；移动赋值和交换时内存池随内容一起转移，
+ * 因此给容器赋值一个新的空容器即可改用另一个内存池并释放原有内存。
+ * @tparam T 元素类型
+ */
+template <typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    
+    ArenaAllocator() noexcept : _arena(nullptr) {}
+    explicit ArenaAllocator(LevelArena* arena) noexcept : _arena(arena) {}
+    
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : _arena(other.getArena()) {}
+    
+    T* allocate(size_t count)
+    {
+        return static_cast<T*>(_arena ? _arena->allocate(count * sizeof(T)) : ::operator new(count * sizeof(T)));
+    }
+    
+    /**
+     * @brief 释放内存：全局堆上的直接释放，内存池中的等整体回收（不访问内存池）
+     */
+    void deallocate(T* pointer, size_t /*count*/) noexcept
+    {
+        if (!_arena)
+        {
+            ::operator delete(pointer);
+        }
+    }
+    
+    /**
+     * @brief 复制构造的容器使用全局堆（副本可能交给其他线程或活得比本局长）
+     */
+    ArenaAllocator select_on_container_copy_construction() const { return ArenaAllocator(); }
+    
+    /**
+     * @brief 关联的内存池，使用全局堆时为nullptr
+     */
+    LevelArena* getArena() const { return _arena; }
+
+private:
+    LevelArena* _arena;     ///< 关联的内存池
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+{
+    return lhs.getArena() == rhs.getArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+{
+    return lhs.getArena() != rhs.getArena();
+}
+
+/// 从关卡内存池分配的vector
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif // __LEVEL_ARENA_H__
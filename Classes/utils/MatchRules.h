@@ -0,0 +1,223 @@
+/**
+ * @file MatchRules.h
+ * @brief 编译期匹配规则
+ * 
+ * 每种匹配规则是一个只含constexpr判定函数的策略类，规则引擎、提示搜索和模拟对局
+ * 以模板参数接收规则，编译期为每种规则生成一张匹配表：
+ * - 卡牌按花色和点数编为0~63的匹配下标（花色占高2位，点数占低4位）
+ * - 表的每一行是一个64位掩码，第j位表示该牌能否与下标为j的牌匹配
+ * 因此内层循环只有一次查表或位测试，不需要运行时分支。
+ * 只在入口处选择规则（MatchRules::dispatch），之后的代码都是按规则实例化的。
+ */
+
+#ifndef __MATCH_RULES_H__
+#define __MATCH_RULES_H__
+
+#include "configs/CardTypes.h"
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief 匹配规则命名空间
+ */
+namespace MatchRules
+{
+    /// 匹配下标数量（4种花色×16，每种花色的后3个下标不使用）
+    const int kIndexCount = 64;
+    
+    /// 无效卡牌（花色或点数为NONE）的匹配下标，与任何牌都不匹配
+    const int kNoneIndex = kIndexCount - 1;
+    
+    /**
+     * @brief 获取卡牌的匹配下标
+     * @param suit 花色
+     * @param face 点数
+     * @return 匹配下标，花色或点数无效时为kNoneIndex
+     */
+    constexpr int toIndex(CardSuitType suit, CardFaceType face)
+    {
+        return (static_cast<int>(suit) < 0 || static_cast<int>(suit) >= static_cast<int>(CardSuitType::COUNT)
+                || static_cast<int>(face) < 0 || static_cast<int>(face) >= static_cast<int>(CardFaceType::COUNT))
+            ? kNoneIndex
+            : (static_cast<int>(suit) << 4) | static_cast<int>(face);
+    }
+    
+    // ========== 规则定义 ==========
+    
+    /**
+     * @brief 点数差1，A和K首尾相连（默认规则）
+     */
+    struct AdjacentRank
+    {
+        static const char* name() { return "adjacent"; }
+        
+        static constexpr bool matches(int /*suit1*/, int face1, int /*suit2*/, int face2)
+        {
+            return (face1 - face2 + 13) % 13 == 1 || (face2 - face1 + 13) % 13 == 1;
+        }
+    };
+    
+    /**
+     * @brief 点数差1，A和K不相连
+     */
+    struct AdjacentRankNoWrap
+    {
+        static const char* name() { return "nowrap"; }
+        
+        static constexpr bool matches(int /*suit1*/, int face1, int /*suit2*/, int face2)
+        {
+            return face1 - face2 == 1 || face2 - face1 == 1;
+        }
+    };
+    
+    /**
+     * @brief 花色相同且点数差1，A和K首尾相连
+     */
+    struct SameSuitAdjacent
+    {
+        static const char* name() { return "suited"; }
+        
+        static constexpr bool matches(int suit1, int face1, int suit2, int face2)
+        {
+            return suit1 == suit2 && AdjacentRank::matches(suit1, face1, suit2, face2);
+        }
+    };
+    
+    /**
+     * @brief 点数差1或2，A和K首尾相连
+     */
+    struct WithinTwo
+    {
+        static const char* name() { return "within2"; }
+        
+        static constexpr bool matches(int /*suit1*/, int face1, int /*suit2*/, int face2)
+        {
+            return face1 != face2 && ((face1 - face2 + 13) % 13 <= 2 || (face2 - face1 + 13) % 13 <= 2);
+        }
+    };
+    
+    /// 游戏默认使用的规则
+    using Default = AdjacentRank;
+    
+    /**
+     * @brief 运行时的规则选择，只在入口处用于分派到对应的实例
+     */
+    enum class RuleType
+    {
+        ADJACENT_RANK = 0,      ///< AdjacentRank
+        ADJACENT_RANK_NO_WRAP,  ///< AdjacentRankNoWrap
+        SAME_SUIT_ADJACENT,     ///< SameSuitAdjacent
+        WITHIN_TWO              ///< WithinTwo
+    };
+    
+    // ========== 匹配表 ==========
+    
+    /**
+     * @brief 匹配表的存储，每个匹配下标一行
+     */
+    struct TableRows
+    {
+        uint64_t rows[kIndexCount];
+    };
+    
+    /**
+     * @brief 编译期按规则生成匹配表
+     */
+    template <typename Rule>
+    constexpr TableRows buildTable()
+    {
+        TableRows table = {};
+        for (int index1 = 0; index1 < kIndexCount; index1++)
+        {
+            for (int index2 = 0; index2 < kIndexCount; index2++)
+            {
+                bool valid = index1 != kNoneIndex && index2 != kNoneIndex
+                    && (index1 & 0x0F) < static_cast<int>(CardFaceType::COUNT)
+                    && (index2 & 0x0F) < static_cast<int>(CardFaceType::COUNT);
+                if (valid && Rule::matches(index1 >> 4, index1 & 0x0F, index2 >> 4, index2 & 0x0F))
+                {
+                    table.rows[index1] |= 1ull << index2;
+                }
+            }
+        }
+        return table;
+    }
+    
+    /**
+     * @brief 按规则实例化的匹配表
+     */
+    template <typename Rule>
+    struct Table
+    {
+        static constexpr TableRows kTable = buildTable<Rule>();
+        
+        /**
+         * @brief 能与指定牌匹配的全部匹配下标
+         * @param index 匹配下标
+         * @return 64位掩码
+         */
+        static uint64_t row(int index) { return kTable.rows[index]; }
+        
+        /**
+         * @brief 两张牌能否匹配
+         * @param index1 第一张牌的匹配下标
+         * @param index2 第二张牌的匹配下标
+         * @return 可以匹配返回true
+         */
+        static bool matches(int index1, int index2) { return ((kTable.rows[index1] >> index2) & 1) != 0; }
+    };
+    
+    template <typename Rule>
+    constexpr TableRows Table<Rule>::kTable;
+    
+    /**
+     * @brief 按运行时选择的规则调用一次函数对象
+     * @param type 规则类型
+     * @param func 以规则类型的实例为参数的函数对象（通常是泛型lambda）
+     * @return 函数对象的返回值
+     */
+    template <typename Func>
+    auto dispatch(RuleType type, Func&& func) -> decltype(func(Default()))
+    {
+        switch (type)
+        {
+            case RuleType::ADJACENT_RANK_NO_WRAP: return func(AdjacentRankNoWrap());
+            case RuleType::SAME_SUIT_ADJACENT:    return func(SameSuitAdjacent());
+            case RuleType::WITHIN_TWO:            return func(WithinTwo());
+            case RuleType::ADJACENT_RANK:
+            default:                              return func(AdjacentRank());
+        }
+    }
+    
+    /**
+     * @brief 按名称查找规则类型
+     * @param name 规则名称（各规则的name()）
+     * @param outType 输出的规则类型
+     * @return 找到返回true
+     */
+    inline bool parseRuleType(const char* name, RuleType& outType)
+    {
+        const RuleType types[] = { RuleType::ADJACENT_RANK, RuleType::ADJACENT_RANK_NO_WRAP,
+                                   RuleType::SAME_SUIT_ADJACENT, RuleType::WITHIN_TWO };
+        for (RuleType type : types)
+        {
+            if (std::strcmp(dispatch(type, [](auto rule) { return decltype(rule)::name(); }), name) == 0)
+            {
+                outType = type;
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+/**
+ * @brief 对每种规则展开宏X，用于在.cpp中显式实例化按规则定义的模板
+ */
+#define PLAYINGCARDS_FOR_EACH_MATCH_RULE(X) \
+    X(MatchRules::AdjacentRank)             \
+    X(MatchRules::AdjacentRankNoWrap)       \
+    X(MatchRules::SameSuitAdjacent)         \
+    X(MatchRules::WithinTwo)
+
+#endif // __MATCH_RULES_H__
@@ -0,0 +1,153 @@
+/**
+ * @file PersistentBitset.cpp
+ * @brief 持久化位集合实现
+ */
+
+#include "utils/PersistentBitset.h"
+#include <algorithm>
+#include <iterator>
+
+const size_t PersistentBitset::kInlineWords;
+const size_t PersistentBitset::kLeafWords;
+
+PersistentBitset::PersistentBitset()
+    : _bitCount(0)
+    , _setCount(0)
+{
+    std::fill(std::begin(_inline), std::end(_inline), 0);
+}
+
+PersistentBitset::PersistentBitset(size_t bitCount)
+    : _bitCount(bitCount)
+    , _setCount(0)
+{
+    std::fill(std::begin(_inline), std::end(_inline), 0);
+    if (getWordCount() <= kInlineWords)
+    {
+        return;
+    }
+    
+    // 全零时所有位置共享同一个叶子
+    auto zeroLeaf = std::make_shared<Leaf>();
+    std::fill(std::begin(zeroLeaf->words), std::end(zeroLeaf->words), 0);
+    auto root = std::make_shared<Root>();
+    root->leaves.assign((getWordCount() + kLeafWords - 1) / kLeafWords, zeroLeaf);
+    _root = std::move(root);
+}
+
+PersistentBitset::PersistentBitset(size_t bitCount, const std::vector<int>& setBits)
+    : _bitCount(bitCount)
+    , _setCount(0)
+{
+    std::fill(std::begin(_inline), std::end(_inline), 0);
+    const size_t wordCount = getWordCount();
+    if (wordCount <= kInlineWords)
+    {
+        for (int bit : setBits)
+        {
+            if (bit >= 0 && static_cast<size_t>(bit) < bitCount)
+            {
+                uint64_t mask = 1ull << (bit & 63);
+                _setCount += (_inline[bit >> 6] & mask) == 0 ? 1 : 0;
+                _inline[bit >> 6] |= mask;
+            }
+        }
+        return;
+    }
+    
+    // 先在临时数组中置位，再按叶子切分，全零的叶子共享同一个
+    std::vector<uint64_t> words(wordCount, 0);
+    for (int bit : setBits)
+    {
+        if (bit >= 0 && static_cast<size_t>(bit) < bitCount)
+        {
+            uint64_t mask = 1ull << (bit & 63);
+            _setCount += (words[bit >> 6] & mask) == 0 ? 1 : 0;
+            words[bit >> 6] |= mask;
+        }
+    }
+    
+    auto root = std::make_shared<Root>();
+    root->leaves.resize((wordCount + kLeafWords - 1) / kLeafWords);
+    std::shared_ptr<const Leaf> zeroLeaf;
+    for (size_t leafIndex = 0; leafIndex < root->leaves.size(); leafIndex++)
+    {
+        auto leaf = std::make_shared<Leaf>();
+        bool isZero = true;
+        for (size_t i = 0; i < kLeafWords; i++)
+        {
+            size_t wordIndex = leafIndex * kLeafWords + i;
+            leaf->words[i] = wordIndex < wordCount ? words[wordIndex] : 0;
+            isZero = isZero && leaf->words[i] == 0;
+        }
+        if (isZero)
+        {
+            if (!zeroLeaf)
+            {
+                zeroLeaf = std::move(leaf);
+            }
+            root->leaves[leafIndex] = zeroLeaf;
+            continue;
+        }
+        root->leaves[leafIndex] = std::move(leaf);
+    }
+    _root = std::move(root);
+}
+
+PersistentBitset PersistentBitset::withBit(size_t bit, bool value) const
+{
+    if (bit >= _bitCount || test(bit) == value)
+    {
+        return *this;
+    }
+    
+    PersistentBitset result(*this);
+    result._setCount = value ? _setCount + 1 : _setCount - 1;
+    uint64_t mask = 1ull << (bit & 63);
+    size_t wordIndex = bit >> 6;
+    if (!_root)
+    {
+        result._inline[wordIndex] ^= mask;
+        return result;
+    }
+    
+    // 路径复制：新的根节点和被修改的叶子，其余叶子共享
+    size_t leafIndex = wordIndex / kLeafWords;
+    auto leaf = std::make_shared<Leaf>(*_root->leaves[leafIndex]);
+    leaf->words[wordIndex % kLeafWords] ^= mask;
+    auto root = std::make_shared<Root>(*_root);
+    root->leaves[leafIndex] = std::move(leaf);
+    result._root = std::move(root);
+    return result;
+}
+
+bool PersistentBitset::operator==(const PersistentBitset& other) const
+{
+    if (_bitCount != other._bitCount || _setCount != other._setCount)
+    {
+        return false;
+    }
+    if (_root && _root == other._root)
+    {
+        return true;
+    }
+    for (size_t i = 0; i < getWordCount(); i++)
+    {
+        if (getWord(i) != other.getWord(i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t PersistentBitset::lowestBit(uint64_t word)
+{
+    size_t index = 0;
+    while ((word & 1) == 0)
+    {
+        word >>= 1;
+        index++;
+    }
+    return index;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file PersistentBitset.h
+ * @brief 持久化（结构共享）位集合
+ * 
+ * 不可变的定长位集合，修改操作返回新版本，旧版本保持不变：
+ * - 不超过kInlineWords个字的位集合直接存放在对象内，复制和修改都不分配内存
+ * - 更大的位集合分成固定大小的叶子节点，由根节点的小数组引用；
+ *   修改时只复制根节点和被修改的叶子，其余叶子在新旧版本间共享
+ * 复制一个版本只增加根节点的引用计数，O(1)。节点创建后只读，可在多个线程间共享。
+ * withBit每次都复制根节点，只用于单步修改；一次置多位时用按位下标列表构造的版本。
+ */
+
+#ifndef __PERSISTENT_BITSET_H__
+#define __PERSISTENT_BITSET_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 持久化位集合类
+ */
+class PersistentBitset
+{
+public:
+    static const size_t kInlineWords = 2;   ///< 内联存储的字数（128位）
+    static const size_t kLeafWords = 8;     ///< 每个叶子节点的字数（512位）
+    
+    /**
+     * @brief 构造空位集合
+     */
+    PersistentBitset();
+    
+    /**
+     * @brief 构造全零的位集合
+     * @param bitCount 位数
+     */
+    explicit PersistentBitset(size_t bitCount);
+    
+    /**
+     * @brief 一次性构造位集合（每个叶子只创建一次）
+     * @param bitCount 位数
+     * @param setBits 置位的位下标，超出范围的忽略，重复的只计一次
+     */
+    PersistentBitset(size_t bitCount, const std::vector<int>& setBits);
+    
+    /**
+     * @brief 位数
+     */
+    size_t size() const { return _bitCount; }
+    
+    /**
+     * @brief 置位的数量，O(1)
+     */
+    size_t count() const { return _setCount; }
+    
+    /**
+     * @brief 读取一位
+     * @param bit 位下标，须小于size()
+     * @return 置位返回true
+     */
+    bool test(size_t bit) const { return ((getWord(bit >> 6) >> (bit & 63)) & 1) != 0; }
+    
+    /**
+     * @brief 返回修改了一位的新版本，当前版本不变
+     * @param bit 位下标，须小于size()
+     * @param value 新值
+     * @return 新版本，值未变化时与当前版本共享全部存储
+     */
+    PersistentBitset withBit(size_t bit, bool value) const;
+    
+    /**
+     * @brief 字数（每字64位）
+     */
+    size_t getWordCount() const { return (_bitCount + 63) / 64; }
+    
+    /**
+     * @brief 读取一个字
+     * @param wordIndex 字下标，须小于getWordCount()
+     * @return 64位字
+     */
+    uint64_t getWord(size_t wordIndex) const
+    {
+        return _root ? _root->leaves[wordIndex / kLeafWords]->words[wordIndex % kLeafWords] : _inline[wordIndex];
+    }
+    
+    /**
+     * @brief 按下标从小到大遍历置位的位
+     * @param func 以位下标为参数的函数对象
+     */
+    template <typename Func>
+    void forEachSetBit(Func&& func) const
+    {
+        for (size_t wordIndex = 0; wordIndex < getWordCount(); wordIndex++)
+        {
+            for (uint64_t word = getWord(wordIndex); word; word &= word - 1)
+            {
+                func(wordIndex * 64 + lowestBit(word));
+            }
+        }
+    }
+    
+    bool operator==(const PersistentBitset& other) const;
+    bool operator!=(const PersistentBitset& other) const { return !(*this == other); }
+
+private:
+    struct Leaf
+    {
+        uint64_t words[kLeafWords];
+    };
+    
+    struct Root
+    {
+        std::vector<std::shared_ptr<const Leaf>> leaves;
+    };
+    
+    static size_t lowestBit(uint64_t word);
+    
+    size_t _bitCount;                       ///< 位数
+    size_t _setCount;                       ///< 置位数量
+    uint64_t _inline[kInlineWords];         ///< 内联存储（位数不超过内联容量时使用）
+    std::shared_ptr<const Root> _root;      ///< 共享的节点（位数超过内联容量时使用）
+};
+
+#endif // __PERSISTENT_BITSET_H__
@@ -0,0 +1,139 @@
+/**
+ * @file TraceProfiler.cpp
+ * @brief 作用域计时与Chrome trace输出实现
+ */
+
+#include "utils/TraceProfiler.h"
+#include "cocos2d.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+USING_NS_CC;
+
+namespace
+{
+    /**
+     * @brief 单个完整事件
+     */
+    struct TraceEvent
+    {
+        const char* name;
+        const char* category;
+        int64_t beginNanos;
+        int64_t durationNanos;
+        uint32_t threadIndex;
+    };
+    
+    std::atomic<bool> s_recording(false);
+    std::mutex s_mutex;
+    std::vector<TraceEvent> s_events;
+    size_t s_droppedCount = 0;
+    const std::chrono::steady_clock::time_point s_epoch = std::chrono::steady_clock::now();
+    std::atomic<uint32_t> s_nextThreadIndex(1);
+    
+    /**
+     * @brief 当前线程的短编号（trace中的tid），首次打点时分配
+     */
+    uint32_t currentThreadIndex()
+    {
+        static thread_local uint32_t threadIndex = s_nextThreadIndex.fetch_add(1);
+        return threadIndex;
+    }
+    
+    void appendEscaped(std::string& out, const char* text)
+    {
+        for (const char* p = text; *p; p++)
+        {
+            if (*p == '"' || *p == '\\')
+            {
+                out += '\\';
+            }
+            out += *p;
+        }
+    }
+}
+
+void TraceProfiler::start()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_events.clear();
+    s_events.reserve(4096);
+    s_droppedCount = 0;
+    s_recording.store(true, std::memory_order_release);
+}
+
+void TraceProfiler::stop()
+{
+    s_recording.store(false, std::memory_order_release);
+}
+
+bool TraceProfiler::isRecording()
+{
+    return s_recording.load(std::memory_order_relaxed);
+}
+
+int64_t TraceProfiler::nowNanos()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - s_epoch).count();
+}
+
+void TraceProfiler::recordComplete(const char* name, const char* category, int64_t beginNanos, int64_t endNanos)
+{
+    TraceEvent event = { name, category, beginNanos, endNanos - beginNanos, currentThreadIndex() };
+    
+    std::lock_guard<std::mutex> lock(s_mutex);
+    if (!s_recording.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    if (s_events.size() >= kMaxEvents)
+    {
+        s_droppedCount++;
+        return;
+    }
+    s_events.push_back(event);
+}
+
+void TraceProfiler::saveToString(std::string& outJson)
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    outJson.clear();
+    outJson.reserve(64 + s_events.size() * 112);
+    outJson += "{\"traceEvents\":[\n";
+    
+    char buffer[96];
+    for (size_t i = 0; i < s_events.size(); i++)
+    {
+        const TraceEvent& event = s_events[i];
+        outJson += i == 0 ? "{\"name\":\"" : ",\n{\"name\":\"";
+        appendEscaped(outJson, event.name);
+        outJson += "\",\"cat\":\"";
+        appendEscaped(outJson, event.category);
+        
+        // Chrome trace的时间单位为微秒，保留到纳秒精度
+        snprintf(buffer, sizeof(buffer), "\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                 event.beginNanos / 1000.0, event.durationNanos / 1000.0, event.threadIndex);
+        outJson += buffer;
+    }
+    
+    snprintf(buffer, sizeof(buffer), "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":%zu}}\n",
+             s_droppedCount);
+    outJson += buffer;
+}
+
+bool TraceProfiler::saveToFile(const std::string& filePath)
+{
+    std::string json;
+    saveToString(json);
+    if (!FileUtils::getInstance()->writeStringToFile(json, filePath))
+    {
+        CCLOG("TraceProfiler: Failed to write %s", filePath.c_str());
+        return false;
+    }
+    CCLOG("TraceProfiler: Saved trace to %s", filePath.c_str());
+    return true;
+}
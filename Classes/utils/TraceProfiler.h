@@ -0,0 +1,123 @@
+/**
+ * @file TraceProfiler.h
+ * @brief 作用域计时与Chrome trace输出
+ * 
+ * 用TRACE_SCOPE在函数或代码块中打点，记录的耗时写成Chrome trace_event格式的JSON，
+ * 可直接在chrome://tracing或Perfetto中按时间线查看。
+ * 只有定义了PLAYINGCARDS_ENABLE_TRACE=1时才编译进来（CMake选项PLAYINGCARDS_ENABLE_TRACE，默认关闭），
+ * 未开启时TRACE_SCOPE展开为空，没有任何开销；调试版同样需要显式开启。
+ */
+
+#ifndef __TRACE_PROFILER_H__
+#define __TRACE_PROFILER_H__
+
+#ifndef PLAYINGCARDS_ENABLE_TRACE
+#define PLAYINGCARDS_ENABLE_TRACE 0
+#endif
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief trace记录器
+ * 
+ * 进程内唯一的事件缓冲区，可在任意线程打点（加锁追加）。
+ * 未开始记录时打点只检查一个原子标志，不读时钟。
+ */
+class TraceProfiler
+{
+public:
+    static const size_t kMaxEvents = 1 << 18;   ///< 缓冲区上限，超出后丢弃新事件
+    
+    /**
+     * @brief 清空缓冲区并开始记录
+     */
+    static void start();
+    
+    /**
+     * @brief 停止记录（已记录的事件保留，可继续保存）
+     */
+    static void stop();
+    
+    /**
+     * @brief 是否正在记录
+     * @return 正在记录返回true
+     */
+    static bool isRecording();
+    
+    /**
+     * @brief 把已记录的事件写为Chrome trace JSON文件
+     * @param filePath 文件完整路径
+     * @return 写入成功返回true
+     */
+    static bool saveToFile(const std::string& filePath);
+    
+    /**
+     * @brief 把已记录的事件写为Chrome trace JSON字符串
+     * @param outJson 输出的JSON
+     */
+    static void saveToString(std::string& outJson);
+    
+    /**
+     * @brief 获取当前时间（相对记录开始时刻）
+     * @return 纳秒
+     */
+    static int64_t nowNanos();
+    
+    /**
+     * @brief 记录一个完整事件（Chrome trace的"X"事件）
+     * @param name 事件名，须为字符串字面量等静态字符串
+     * @param category 分类，须为静态字符串
+     * @param beginNanos 开始时间（nowNanos）
+     * @param endNanos 结束时间（nowNanos）
+     */
+    static void recordComplete(const char* name, const char* category, int64_t beginNanos, int64_t endNanos);
+
+private:
+    /**
+     * @brief 私有构造函数，禁止实例化
+     */
+    TraceProfiler() = delete;
+};
+
+/**
+ * @brief 作用域计时器，构造时记下开始时间，析构时记录完整事件
+ */
+class TraceScope
+{
+public:
+    TraceScope(const char* category, const char* name)
+        : _category(category)
+        , _name(name)
+        , _beginNanos(TraceProfiler::isRecording() ? TraceProfiler::nowNanos() : -1)
+    {
+    }
+    
+    ~TraceScope()
+    {
+        if (_beginNanos >= 0)
+        {
+            TraceProfiler::recordComplete(_name, _category, _beginNanos, TraceProfiler::nowNanos());
+        }
+    }
+    
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* _category;  ///< 分类
+    const char* _name;      ///< 事件名
+    int64_t _beginNanos;    ///< 开始时间，-1表示未在记录
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#if PLAYINGCARDS_ENABLE_TRACE
+/// 为当前作用域打点，category如"controller"、"model"、"view"、"config"
+#define TRACE_SCOPE(category, name) TraceScope TRACE_CONCAT(_traceScope, __LINE__)(category, name)
+#else
+#define TRACE_SCOPE(category, name) ((void)0)
+#endif
+
+#endif // __TRACE_PROFILER_H__
@@ -6,9 +6,158 @@
 #include "views/CardView.h"
 #include "configs/CardTypes.h"
 #include "utils/CardUtils.h"
+#include "utils/TraceProfiler.h"
 
 USING_NS_CC;
 
+// ========== 复用的移动动作 ==========
+
+/**
+ * @brief 从当前位置线性移动到目标位置，结束时通知所属卡牌视图
+ * 
+ * 相当于MoveTo+CallFunc组成的Sequence，但可以重复启动，
+ * 省去每次移动创建三个动作对象和复制一次回调。
+ */
+class CardView::MoveAction : public ActionInterval
+{
+public:
+    PLAYINGCARDS_USE_BLOCK_POOL(MoveAction)
+    
+    static MoveAction* create(CardView* owner)
+    {
+        MoveAction* action = new (std::nothrow) MoveAction();
+        if (action)
+        {
+            action->_owner = owner;
+            action->autorelease();
+        }
+        return action;
+    }
+    
+    /**
+     * @brief 设置时长和目标位置，下一次runAction时生效
+     */
+    void reset(float duration, const Vec2& endPos)
+    {
+        initWithDuration(duration);
+        _endPos = endPos;
+    }
+    
+    virtual void startWithTarget(Node* target) override
+    {
+        ActionInterval::startWithTarget(target);
+        _startPos = target->getPosition();
+    }
+    
+    virtual void update(float time) override
+    {
+        if (_target)
+        {
+            _target->setPosition(_startPos + (_endPos - _startPos) * time);
+        }
+        if (time >= 1.0f)
+        {
+            _owner->onMoveFinished();
+        }
+    }
+    
+    virtual MoveAction* clone() const override
+    {
+        MoveAction* action = create(_owner);
+        if (action)
+        {
+            action->reset(_duration, _endPos);
+        }
+        return action;
+    }
+    
+    virtual MoveAction* reverse() const override
+    {
+        CCASSERT(false, "CardView::MoveAction is not reversible");
+        return nullptr;
+    }
+
+private:
+    MoveAction()
+        : _owner(nullptr)
+    {
+    }
+    
+    CardView* _owner;       ///< 所属卡牌视图（即动作目标，不持有引用）
+    Vec2 _startPos;         ///< 起始位置
+    Vec2 _endPos;           ///< 目标位置
+};
+
+// ========== 卡牌精灵 ==========
+
+/**
+ * @brief 从固定块池分配的精灵
+ * 
+ * 每张卡牌视图有四五个精灵，开局时成批创建、换关时成批释放，
+ * 放进同一个池里既不碎片化全局堆，也能从池的统计看到精灵数量。
+ */
+class CardView::CardSprite : public Sprite
+{
+public:
+    PLAYINGCARDS_USE_BLOCK_POOL(CardSprite)
+    
+    static CardSprite* create(const std::string& filename)
+    {
+        CardSprite* sprite = new (std::nothrow) CardSprite();
+        if (sprite && sprite->initWithFile(filename))
+        {
+            sprite->autorelease();
+            return sprite;
+        }
+        CC_SAFE_DELETE(sprite);
+        return nullptr;
+    }
+    
+    static CardSprite* createWithTexture(Texture2D* texture)
+    {
+        CardSprite* sprite = new (std::nothrow) CardSprite();
+        if (sprite && sprite->initWithTexture(texture))
+        {
+            sprite->autorelease();
+            return sprite;
+        }
+        CC_SAFE_DELETE(sprite);
+        return nullptr;
+    }
+};
+
+// ========== 固定块池 ==========
+
+PLAYINGCARDS_DEFINE_BLOCK_POOL(CardView, 64)
+PLAYINGCARDS_DEFINE_BLOCK_POOL(CardView::MoveAction, 64)
+PLAYINGCARDS_DEFINE_BLOCK_POOL(CardView::CardSprite, 256)
+
+// ========== 纹理缓存 ==========
+
+namespace
+{
+    // 换牌面时直接换纹理：首次按路径加载并持有引用，之后不再拼路径字符串
+    Texture2D* s_numberTextures[2][2][static_cast<int>(CardFaceType::COUNT)] = {};
+    Texture2D* s_suitTextures[static_cast<int>(CardSuitType::COUNT)] = {};
+    
+    Texture2D* loadTexture(const std::string& path)
+    {
+        Texture2D* texture = Director::getInstance()->getTextureCache()->addImage(path);
+        CC_SAFE_RETAIN(texture);
+        return texture;
+    }
+}
+
+CardView::CardView()
+    : _moveAction(nullptr)
+{
+}
+
+CardView::~CardView()
+{
+    CC_SAFE_RELEASE(_moveAction);
+}
+
 CardView* CardView::create(const CardModel& cardModel)
 {
     CardView* view = new (std::nothrow) CardView();
@@ -23,6 +172,7 @@ CardView* CardView::create(const CardModel& cardModel)
 
 bool CardView::init(const CardModel& cardModel)
 {
+    TRACE_SCOPE("view", "CardView::init");
     if (!Node::init())
     {
         return false;
@@ -40,6 +190,7 @@ bool CardView::init(const CardModel& cardModel)
     _suitSprite = nullptr;
     _frontNode = nullptr;
     _backNode = nullptr;
+    _highlightNode = nullptr;
     _touchListener = nullptr;
     
     // 设置卡牌大小
@@ -63,12 +214,13 @@ bool CardView::init(const CardModel& cardModel)
 
 void CardView::createFrontView()
 {
+    TRACE_SCOPE("view", "CardView::createFrontView");
     _frontNode = Node::create();
     _frontNode->setContentSize(this->getContentSize());
     this->addChild(_frontNode, 1);
     
     // 创建卡牌背景
-    _backgroundSprite = Sprite::create(GameConstants::kResPath + "card_general.png");
+    _backgroundSprite = CardSprite::create(GameConstants::kResPath + "card_general.png");
     if (_backgroundSprite)
     {
         _backgroundSprite->setPosition(this->getContentSize() / 2);
@@ -80,12 +232,13 @@ void CardView::createFrontView()
 
 void CardView::createBackView()
 {
+    TRACE_SCOPE("view", "CardView::createBackView");
     _backNode = Node::create();
     _backNode->setContentSize(this->getContentSize());
     this->addChild(_backNode, 0);
     
     // 创建卡牌背面（使用背景图或纯色）
-    auto backSprite = Sprite::create(GameConstants::kResPath + "card_general.png");
+    auto backSprite = CardSprite::create(GameConstants::kResPath + "card_general.png");
     if (backSprite)
     {
         backSprite->setPosition(this->getContentSize() / 2);
@@ -102,54 +255,51 @@ void CardView::updateFrontView()
     }
     
     bool isRed = CardUtils::isRedSuit(_suit);
+    Size size = this->getContentSize();
     
-    // 移除旧的精灵
-    if (_bigNumberSprite)
-    {
-        _bigNumberSprite->removeFromParent();
-        _bigNumberSprite = nullptr;
-    }
-    if (_smallNumberSprite)
-    {
-        _smallNumberSprite->removeFromParent();
-        _smallNumberSprite = nullptr;
-    }
-    if (_suitSprite)
+    // 大号数字（居中显示）
+    _bigNumberSprite = updateFrontSprite(_bigNumberSprite, getNumberTexture(_face, isRed, true),
+                                         Vec2(size.width / 2, size.height / 2));
+    
+    // 小号数字（左上角）
+    _smallNumberSprite = updateFrontSprite(_smallNumberSprite, getNumberTexture(_face, isRed, false),
+                                           Vec2(25, size.height - 30));
+    
+    // 花色（左上角数字下方）
+    bool isNewSuitSprite = !_suitSprite;
+    _suitSprite = updateFrontSprite(_suitSprite, getSuitTexture(_suit), Vec2(25, size.height - 60));
+    if (isNewSuitSprite && _suitSprite)
     {
-        _suitSprite->removeFromParent();
-        _suitSprite = nullptr;
+        _suitSprite->setScale(0.5f);
     }
-    
-    // 创建大号数字（居中显示）
-    std::string bigNumPath = getNumberImagePath(_face, isRed, true);
-    _bigNumberSprite = Sprite::create(bigNumPath);
-    if (_bigNumberSprite)
+}
+
+Sprite* CardView::updateFrontSprite(Sprite* sprite, Texture2D* texture, const Vec2& position)
+{
+    if (!texture)
     {
-        _bigNumberSprite->setPosition(Vec2(
-            this->getContentSize().width / 2,
-            this->getContentSize().height / 2
-        ));
-        _frontNode->addChild(_bigNumberSprite, 1);
+        if (sprite)
+        {
+            sprite->setVisible(false);
+        }
+        return sprite;
     }
     
-    // 创建小号数字（左上角）
-    std::string smallNumPath = getNumberImagePath(_face, isRed, false);
-    _smallNumberSprite = Sprite::create(smallNumPath);
-    if (_smallNumberSprite)
+    if (sprite)
     {
-        _smallNumberSprite->setPosition(Vec2(25, this->getContentSize().height - 30));
-        _frontNode->addChild(_smallNumberSprite, 1);
+        sprite->setTexture(texture);
+        sprite->setTextureRect(Rect(Vec2::ZERO, texture->getContentSize()));
+        sprite->setVisible(true);
+        return sprite;
     }
     
-    // 创建花色（左上角数字下方）
-    std::string suitPath = getSuitImagePath(_suit);
-    _suitSprite = Sprite::create(suitPath);
-    if (_suitSprite)
+    sprite = CardSprite::createWithTexture(texture);
+    if (sprite)
     {
-        _suitSprite->setPosition(Vec2(25, this->getContentSize().height - 60));
-        _suitSprite->setScale(0.5f);
-        _frontNode->addChild(_suitSprite, 1);
+        sprite->setPosition(position);
+        _frontNode->addChild(sprite, 1);
     }
+    return sprite;
 }
 
 void CardView::setupTouchListener()
@@ -159,7 +309,7 @@ void CardView::setupTouchListener()
     
     _touchListener->onTouchBegan = [this](Touch* touch, Event* event) -> bool
     {
-        if (!_isClickable || !_isFaceUp)
+        if (!_isClickable || !_isFaceUp || !this->isVisible())
         {
             return false;
         }
@@ -197,11 +347,16 @@ void CardView::setupTouchListener()
 
 void CardView::updateView(const CardModel& cardModel)
 {
+    // 每次走牌后都会刷新整个主牌区，牌面没变时不碰精灵
+    bool isFaceChanged = cardModel.getSuit() != _suit || cardModel.getFace() != _face;
     _cardId = cardModel.getCardId();
     _suit = cardModel.getSuit();
     _face = cardModel.getFace();
     
-    updateFrontView();
+    if (isFaceChanged)
+    {
+        updateFrontView();
+    }
     setFaceUp(cardModel.isFaceUp());
     setClickable(cardModel.isClickable());
 }
@@ -224,32 +379,108 @@ void CardView::setClickable(bool clickable)
     _isClickable = clickable;
 }
 
+void CardView::setHighlighted(bool highlighted)
+{
+    if (!highlighted)
+    {
+        if (_highlightNode)
+        {
+            _highlightNode->setVisible(false);
+        }
+        return;
+    }
+    
+    if (!_highlightNode)
+    {
+        // 金色边框，向外扩几像素避免被牌面遮住
+        Size size = this->getContentSize();
+        _highlightNode = DrawNode::create();
+        for (int i = 0; i < 4; i++)
+        {
+            float inset = -2.0f - i;
+            _highlightNode->drawRect(Vec2(inset, inset),
+                                     Vec2(size.width - inset, size.height - inset),
+                                     Color4F(1.0f, 0.85f, 0.2f, 1.0f));
+        }
+        this->addChild(_highlightNode, 2);
+    }
+    _highlightNode->setVisible(true);
+}
+
 void CardView::moveTo(const Vec2& targetPos, float duration, 
                       const std::function<void()>& callback)
 {
-    auto moveAction = MoveTo::create(duration, targetPos);
+    if (_moveAction && _moveAction->getTarget())
+    {
+        // 上一次移动尚未结束（或正在其完成回调中），换一个新动作，旧动作由ActionManager释放
+        this->stopAction(_moveAction);
+        CC_SAFE_RELEASE_NULL(_moveAction);
+    }
+    if (!_moveAction)
+    {
+        _moveAction = MoveAction::create(this);
+        CC_SAFE_RETAIN(_moveAction);
+    }
     
-    if (callback)
+    _moveCallback = callback;
+    if (_moveAction)
     {
-        auto sequence = Sequence::create(
-            moveAction,
-            CallFunc::create(callback),
-            nullptr
-        );
-        this->runAction(sequence);
+        _moveAction->reset(duration, targetPos);
+        this->runAction(_moveAction);
     }
-    else
+}
+
+void CardView::onMoveFinished()
+{
+    // 先取出再调用：回调中可能再次移动甚至移除本视图
+    std::function<void()> callback;
+    callback.swap(_moveCallback);
+    if (callback)
     {
-        this->runAction(moveAction);
+        callback();
     }
 }
 
 void CardView::setPositionImmediate(const Vec2& position)
 {
+    // 中止的移动不会再结束，一并丢弃其完成回调
     this->stopAllActions();
+    _moveCallback = nullptr;
     this->setPosition(position);
 }
 
+Texture2D* CardView::getNumberTexture(CardFaceType face, bool isRed, bool isBig) const
+{
+    int faceIndex = static_cast<int>(face);
+    if (faceIndex < 0 || faceIndex >= static_cast<int>(CardFaceType::COUNT))
+    {
+        return nullptr;
+    }
+    
+    Texture2D*& texture = s_numberTextures[isBig ? 1 : 0][isRed ? 1 : 0][faceIndex];
+    if (!texture)
+    {
+        texture = loadTexture(getNumberImagePath(face, isRed, isBig));
+    }
+    return texture;
+}
+
+Texture2D* CardView::getSuitTexture(CardSuitType suit) const
+{
+    int suitIndex = static_cast<int>(suit);
+    if (suitIndex < 0 || suitIndex >= static_cast<int>(CardSuitType::COUNT))
+    {
+        return nullptr;
+    }
+    
+    Texture2D*& texture = s_suitTextures[suitIndex];
+    if (!texture)
+    {
+        texture = loadTexture(getSuitImagePath(suit));
+    }
+    return texture;
+}
+
 std::string CardView::getNumberImagePath(CardFaceType face, bool isRed, bool isBig) const
 {
     std::string colorStr = isRed ? "red" : "black";
@@ -14,6 +14,7 @@
 
 #include "cocos2d.h"
 #include "models/CardModel.h"
+#include "utils/FixedBlockPool.h"
 #include <functional>
 
 /**
@@ -21,6 +22,7 @@
  * 
  * 继承自cocos2d::Node，负责卡牌的渲染和交互。
  * 视图层只负责显示和接收用户输入，不包含业务逻辑。
+ * 卡牌视图、其中的精灵和移动动作都从各自的固定块池分配（见FixedBlockPool）。
  */
 class CardView : public cocos2d::Node
 {
@@ -28,6 +30,18 @@ public:
     // 点击回调函数类型：参数为卡牌ID
     using ClickCallback = std::function<void(int cardId)>;
     
+    /**
+     * @brief 构造函数
+     */
+    CardView();
+    
+    /**
+     * @brief 析构函数，释放复用的移动动作
+     */
+    virtual ~CardView();
+    
+    PLAYINGCARDS_USE_BLOCK_POOL(CardView)
+    
     /**
      * @brief 创建卡牌视图
      * @param cardModel 卡牌数据模型（只读）
@@ -62,6 +76,12 @@ public:
      */
     void setClickable(bool clickable);
     
+    /**
+     * @brief 设置是否高亮显示（用于提示）
+     * @param highlighted true表示高亮
+     */
+    void setHighlighted(bool highlighted);
+    
     // ========== 动画方法 ==========
     
     /**
@@ -69,12 +89,15 @@ public:
      * @param targetPos 目标位置
      * @param duration 动画时长
      * @param callback 动画完成回调
+     * 
+     * 每个卡牌视图复用同一个移动动作，回调存放在成员中，
+     * 捕获内容不超过两个指针的回调整个移动过程不分配内存
      */
     void moveTo(const cocos2d::Vec2& targetPos, float duration, 
                 const std::function<void()>& callback = nullptr);
     
     /**
-     * @brief 立即移动到指定位置（无动画）
+     * @brief 立即移动到指定位置（无动画），中止正在进行的移动且不执行其完成回调
      * @param position 目标位置
      */
     void setPositionImmediate(const cocos2d::Vec2& position);
@@ -108,6 +131,9 @@ public:
     bool isClickable() const { return _isClickable; }
 
 private:
+    class MoveAction;
+    class CardSprite;
+    
     /**
      * @brief 创建卡牌正面显示
      */
@@ -123,6 +149,21 @@ private:
      */
     void updateFrontView();
     
+    /**
+     * @brief 更新正面上的一个精灵：已有精灵直接换纹理，没有时才创建
+     * @param sprite 精灵成员
+     * @param texture 新纹理，为空时隐藏精灵
+     * @param position 创建时的位置
+     * @return 精灵（纹理为空且尚未创建时为nullptr）
+     */
+    cocos2d::Sprite* updateFrontSprite(cocos2d::Sprite* sprite, cocos2d::Texture2D* texture,
+                                       const cocos2d::Vec2& position);
+    
+    /**
+     * @brief 移动动作结束时调用，执行并清除完成回调
+     */
+    void onMoveFinished();
+    
     /**
      * @brief 设置触摸事件
      */
@@ -143,6 +184,22 @@ private:
      * @return 图片路径
      */
     std::string getSuitImagePath(CardSuitType suit) const;
+    
+    /**
+     * @brief 获取卡牌数字纹理（首次使用时加载，之后直接取缓存）
+     * @param face 点数
+     * @param isRed 是否红色
+     * @param isBig 是否大号
+     * @return 纹理，点数无效或加载失败时为nullptr
+     */
+    cocos2d::Texture2D* getNumberTexture(CardFaceType face, bool isRed, bool isBig) const;
+    
+    /**
+     * @brief 获取花色纹理（首次使用时加载，之后直接取缓存）
+     * @param suit 花色
+     * @return 纹理，花色无效或加载失败时为nullptr
+     */
+    cocos2d::Texture2D* getSuitTexture(CardSuitType suit) const;
 
 private:
     int _cardId;                            // 卡牌ID
@@ -157,9 +214,13 @@ private:
     cocos2d::Sprite* _suitSprite;           // 花色精灵
     cocos2d::Node* _frontNode;              // 正面容器
     cocos2d::Node* _backNode;               // 背面容器
+    cocos2d::DrawNode* _highlightNode;      // 提示高亮框（按需创建）
     
     ClickCallback _clickCallback;           // 点击回调
     cocos2d::EventListenerTouchOneByOne* _touchListener; // 触摸监听器
+    
+    MoveAction* _moveAction;                // 复用的移动动作（持有引用）
+    std::function<void()> _moveCallback;    // 当前移动的完成回调
 };
 
 #endif // __CARD_VIEW_H__
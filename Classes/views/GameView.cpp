@@ -34,6 +34,8 @@ bool GameView::init()
     _undoButtonNode = nullptr;
     _undoLabel = nullptr;
     _undoEnabled = false;
+    _messageLabel = nullptr;
+    _isIncrementalBuild = false;
     _closeMenu = nullptr;
     
     // 设置整体大小
@@ -61,9 +63,23 @@ bool GameView::init()
     // 创建回退按钮
     createUndoButton();
     
+    // 创建提示按钮
+    createHintButton();
+    
+    // 创建重玩按钮
+    createRestartButton();
+    
     // 创建关闭按钮
     createCloseButton();
     
+    // 创建状态提示文字（默认隐藏）
+    _messageLabel = Label::createWithSystemFont("", "Arial", 64);
+    _messageLabel->setColor(Color3B::YELLOW);
+    _messageLabel->setPosition(Vec2(GameConstants::kDesignWidth / 2,
+                                    GameConstants::kStackAreaHeight + GameConstants::kPlayFieldHeight / 2));
+    _messageLabel->setVisible(false);
+    this->addChild(_messageLabel, 3);
+    
     return true;
 }
 
@@ -153,17 +169,131 @@ void GameView::createUndoButton()
     _undoLabel = label;
 }
 
-void GameView::initGame(const GameModel* gameModel)
+void GameView::createHintButton()
+{
+    float btnWidth = 120.0f;
+    float btnHeight = 50.0f;
+    Vec2 origin(GameConstants::kDesignWidth - btnWidth * 2 - 40, 20);
+    
+    // 创建按钮背景
+    auto buttonBg = DrawNode::create();
+    buttonBg->drawSolidRect(Vec2(0, 0), Vec2(btnWidth, btnHeight), Color4F(0.3f, 0.5f, 0.3f, 0.8f));
+    buttonBg->drawRect(Vec2(0, 0), Vec2(btnWidth, btnHeight), Color4F(1, 1, 1, 0.5f));
+    buttonBg->setPosition(origin);
+    this->addChild(buttonBg, 2);
+    
+    // 创建按钮文字
+    auto label = Label::createWithSystemFont("Hint", "Arial", 32);
+    label->setColor(Color3B::WHITE);
+    label->setPosition(Vec2(btnWidth / 2, btnHeight / 2));
+    buttonBg->addChild(label);
+    
+    // 创建触摸监听器
+    auto touchListener = EventListenerTouchOneByOne::create();
+    touchListener->setSwallowTouches(true);
+    
+    Rect buttonRect(origin.x, origin.y, btnWidth, btnHeight);
+    
+    touchListener->onTouchBegan = [this, buttonRect, buttonBg](Touch* touch, Event* event) {
+        Vec2 locationInNode = this->convertToNodeSpace(touch->getLocation());
+        if (buttonRect.containsPoint(locationInNode))
+        {
+            buttonBg->setScale(0.95f);
+            return true;
+        }
+        return false;
+    };
+    
+    touchListener->onTouchEnded = [this, buttonRect, buttonBg](Touch* touch, Event* event) {
+        buttonBg->setScale(1.0f);
+        Vec2 locationInNode = this->convertToNodeSpace(touch->getLocation());
+        if (buttonRect.containsPoint(locationInNode))
+        {
+            CCLOG("GameView: Hint button clicked");
+            if (_hintClickCallback)
+            {
+                _hintClickCallback();
+            }
+        }
+    };
+    
+    touchListener->onTouchCancelled = [buttonBg](Touch* touch, Event* event) {
+        buttonBg->setScale(1.0f);
+    };
+    
+    _eventDispatcher->addEventListenerWithSceneGraphPriority(touchListener, this);
+}
+
+void GameView::createRestartButton()
+{
+    float btnWidth = 120.0f;
+    float btnHeight = 50.0f;
+    Vec2 origin(GameConstants::kDesignWidth - btnWidth * 3 - 60, 20);
+    
+    // 创建按钮背景
+    auto buttonBg = DrawNode::create();
+    buttonBg->drawSolidRect(Vec2(0, 0), Vec2(btnWidth, btnHeight), Color4F(0.5f, 0.35f, 0.2f, 0.8f));
+    buttonBg->drawRect(Vec2(0, 0), Vec2(btnWidth, btnHeight), Color4F(1, 1, 1, 0.5f));
+    buttonBg->setPosition(origin);
+    this->addChild(buttonBg, 2);
+    
+    // 创建按钮文字
+    auto label = Label::createWithSystemFont("Retry", "Arial", 32);
+    label->setColor(Color3B::WHITE);
+    label->setPosition(Vec2(btnWidth / 2, btnHeight / 2));
+    buttonBg->addChild(label);
+    
+    // 创建触摸监听器
+    auto touchListener = EventListenerTouchOneByOne::create();
+    touchListener->setSwallowTouches(true);
+    
+    Rect buttonRect(origin.x, origin.y, btnWidth, btnHeight);
+    
+    touchListener->onTouchBegan = [this, buttonRect, buttonBg](Touch* touch, Event* event) {
+        Vec2 locationInNode = this->convertToNodeSpace(touch->getLocation());
+        if (buttonRect.containsPoint(locationInNode))
+        {
+            buttonBg->setScale(0.95f);
+            return true;
+        }
+        return false;
+    };
+    
+    touchListener->onTouchEnded = [this, buttonRect, buttonBg](Touch* touch, Event* event) {
+        buttonBg->setScale(1.0f);
+        Vec2 locationInNode = this->convertToNodeSpace(touch->getLocation());
+        if (buttonRect.containsPoint(locationInNode))
+        {
+            CCLOG("GameView: Retry button clicked");
+            if (_restartClickCallback)
+            {
+                _restartClickCallback();
+            }
+        }
+    };
+    
+    touchListener->onTouchCancelled = [buttonBg](Touch* touch, Event* event) {
+        buttonBg->setScale(1.0f);
+    };
+    
+    _eventDispatcher->addEventListenerWithSceneGraphPriority(touchListener, this);
+}
+
+void GameView::initGame(const GameModel* gameModel, LevelArena* arena)
 {
     if (!gameModel)
     {
         return;
     }
     
-    // 初始化主牌区
-    if (_playFieldView)
+    // 初始化主牌区（分帧构建时只准备，卡牌由buildStep创建）
+    if (_playFieldView && _isIncrementalBuild)
+    {
+        _playFieldView->prepareCards(gameModel, arena);
+    }
+    else if (_playFieldView)
     {
-        _playFieldView->initCards(gameModel);
+        _playFieldView->initCards(gameModel, arena);
     }
     
     // 初始化手牌区
@@ -173,6 +303,38 @@ void GameView::initGame(const GameModel* gameModel)
     }
 }
 
+bool GameView::buildStep(float budgetSeconds)
+{
+    if (_playFieldView && !_playFieldView->buildPendingCards(budgetSeconds))
+    {
+        return false;
+    }
+    
+    // 构建完成后恢复为一次性构建，之后读档等重新初始化时不再需要逐帧驱动
+    _isIncrementalBuild = false;
+    return true;
+}
+
+void GameView::resetGame(const GameModel* gameModel)
+{
+    if (!gameModel)
+    {
+        return;
+    }
+    
+    // 与initGame相同的两个区域，但都在原有视图上恢复
+    if (_playFieldView)
+    {
+        _playFieldView->resetCards(gameModel);
+    }
+    
+    // 手牌区的顶部牌和移动用视图本来就是原地更新的
+    if (_stackView)
+    {
+        _stackView->initStack(gameModel);
+    }
+}
+
 void GameView::updateUndoButtonState(bool canUndo)
 {
     _undoEnabled = canUndo;
@@ -186,6 +348,23 @@ void GameView::updateUndoButtonState(bool canUndo)
     }
 }
 
+void GameView::showMessage(const std::string& text)
+{
+    if (_messageLabel)
+    {
+        _messageLabel->setString(text);
+        _messageLabel->setVisible(true);
+    }
+}
+
+void GameView::hideMessage()
+{
+    if (_messageLabel)
+    {
+        _messageLabel->setVisible(false);
+    }
+}
+
 void GameView::setUndoClickCallback(const UndoClickCallback& callback)
 {
     _undoClickCallback = callback;
@@ -4,7 +4,7 @@
  * 
  * 负责整个游戏界面的组织，包括：
  * - 组合主牌区视图和手牌区视图
- * - 回退按钮
+ * - 回退、提示和重玩按钮
  * - 游戏状态显示
  */
 
@@ -17,6 +17,7 @@
 #include "views/StackView.h"
 #include "models/GameModel.h"
 #include <functional>
+#include <string>
 
 /**
  * @brief 游戏主视图类
@@ -29,6 +30,10 @@ class GameView : public cocos2d::Node
 public:
     /// 回退按钮点击回调类型
     using UndoClickCallback = std::function<void()>;
+    /// 提示按钮点击回调类型
+    using HintClickCallback = std::function<void()>;
+    /// 重玩按钮点击回调类型
+    using RestartClickCallback = std::function<void()>;
     
     /**
      * @brief 创建游戏主视图
@@ -47,8 +52,28 @@ public:
     /**
      * @brief 初始化游戏界面
      * @param gameModel 游戏数据模型（只读）
+     * @param arena 视图索引使用的关卡内存池，nullptr为全局堆
      */
-    void initGame(const GameModel* gameModel);
+    void initGame(const GameModel* gameModel, LevelArena* arena = nullptr);
+    
+    /**
+     * @brief 设置是否分帧构建：开启后initGame只做准备，主牌区卡牌视图由buildStep逐帧创建
+     * @param incremental true表示分帧构建（用于在后台预先构建下一关）
+     */
+    void setIncrementalBuild(bool incremental) { _isIncrementalBuild = incremental; }
+    
+    /**
+     * @brief 在时间预算内继续构建分帧创建的卡牌视图
+     * @param budgetSeconds 本帧最多占用的时间（秒）
+     * @return 全部构建完成返回true，此后自动关闭分帧构建
+     */
+    bool buildStep(float budgetSeconds);
+    
+    /**
+     * @brief 重玩本关：复用现有的卡牌视图原地恢复为开局显示
+     * @param gameModel 开局局面（与initGame时为同一关卡）
+     */
+    void resetGame(const GameModel* gameModel);
     
     // ========== 子视图访问 ==========
     
@@ -72,6 +97,17 @@ public:
      */
     void updateUndoButtonState(bool canUndo);
     
+    /**
+     * @brief 显示居中的状态提示文字（如胜利、无路可走）
+     * @param text 提示文字
+     */
+    void showMessage(const std::string& text);
+    
+    /**
+     * @brief 隐藏状态提示文字
+     */
+    void hideMessage();
+    
     // ========== 回调设置 ==========
     
     /**
@@ -79,6 +115,18 @@ public:
      * @param callback 回调函数
      */
     void setUndoClickCallback(const UndoClickCallback& callback);
+    
+    /**
+     * @brief 设置提示按钮点击回调
+     * @param callback 回调函数
+     */
+    void setHintClickCallback(const HintClickCallback& callback) { _hintClickCallback = callback; }
+    
+    /**
+     * @brief 设置重玩按钮点击回调
+     * @param callback 回调函数
+     */
+    void setRestartClickCallback(const RestartClickCallback& callback) { _restartClickCallback = callback; }
 
 private:
     /**
@@ -86,6 +134,16 @@ private:
      */
     void createUndoButton();
     
+    /**
+     * @brief 创建提示按钮（位于回退按钮左侧）
+     */
+    void createHintButton();
+    
+    /**
+     * @brief 创建重玩按钮（位于提示按钮左侧）
+     */
+    void createRestartButton();
+    
     /**
      * @brief 创建背景
      */
@@ -108,8 +166,12 @@ private:
     cocos2d::Node* _undoButtonNode;          // 回退按钮背景节点
     cocos2d::Label* _undoLabel;              // 回退按钮文字
     bool _undoEnabled;                       // 回退按钮是否启用
+    cocos2d::Label* _messageLabel;           // 状态提示文字
+    bool _isIncrementalBuild;                // 是否分帧构建卡牌视图
     
     UndoClickCallback _undoClickCallback;    // 回退按钮点击回调
+    HintClickCallback _hintClickCallback;    // 提示按钮点击回调
+    RestartClickCallback _restartClickCallback; // 重玩按钮点击回调
     cocos2d::Menu* _closeMenu;                // 关闭按钮菜单
 };
 
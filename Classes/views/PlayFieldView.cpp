@@ -5,6 +5,10 @@
 
 #include "views/PlayFieldView.h"
 #include "configs/CardTypes.h"
+#include "utils/TraceProfiler.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
 
 USING_NS_CC;
 
@@ -27,13 +31,24 @@ bool PlayFieldView::init()
         return false;
     }
     
+    _hintCardId = -1;
+    _pendingModel = nullptr;
+    _pendingSlot = 0;
+    
     // 设置主牌区大小
     this->setContentSize(Size(GameConstants::kPlayFieldWidth, GameConstants::kPlayFieldHeight));
     
     return true;
 }
 
-void PlayFieldView::initCards(const GameModel* gameModel)
+void PlayFieldView::initCards(const GameModel* gameModel, LevelArena* arena)
+{
+    TRACE_SCOPE("view", "PlayFieldView::initCards");
+    prepareCards(gameModel, arena);
+    buildPendingCards(std::numeric_limits<float>::max());
+}
+
+void PlayFieldView::prepareCards(const GameModel* gameModel, LevelArena* arena)
 {
     if (!gameModel)
     {
@@ -42,22 +57,111 @@ void PlayFieldView::initCards(const GameModel* gameModel)
     
     clearAllCards();
     
-    // 为每张主牌区卡牌创建视图
+    // 视图索引按主牌区最大卡牌ID一次分配好，之后的增删都不再分配
     const auto& cards = gameModel->getPlayfieldCards();
-    for (const auto& cardModel : cards)
+    int maxCardId = -1;
+    for (size_t slot = 0; slot < cards.slotCount(); slot++)
+    {
+        maxCardId = std::max(maxCardId, cards.getCardId(slot));
+    }
+    _cardViews = ArenaVector<CardView*>(ArenaAllocator<CardView*>(arena));
+    _cardViews.assign(maxCardId + 1, nullptr);
+    
+    _pendingModel = gameModel;
+    _pendingSlot = 0;
+}
+
+bool PlayFieldView::buildPendingCards(float budgetSeconds)
+{
+    TRACE_SCOPE("view", "PlayFieldView::buildPendingCards");
+    if (!_pendingModel)
+    {
+        return true;
+    }
+    
+    // 按槽位顺序逐张创建，每张之后检查耗时，超出预算留到下一帧
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    const auto& cards = _pendingModel->getPlayfieldCards();
+    while (_pendingSlot < cards.slotCount())
+    {
+        size_t slot = _pendingSlot++;
+        if (!cards.isOccupied(slot))
+        {
+            continue;
+        }
+        
+        CardModel cardModel = cards.getCard(slot);
+        addCard(cardModel, _pendingModel->getPlayfieldZOrder(cardModel.getCardId()));
+        if (std::chrono::duration<float>(Clock::now() - start).count() >= budgetSeconds)
+        {
+            break;
+        }
+    }
+    
+    if (_pendingSlot < cards.slotCount())
+    {
+        return false;
+    }
+    _pendingModel = nullptr;
+    return true;
+}
+
+void PlayFieldView::resetCards(const GameModel* gameModel)
+{
+    TRACE_SCOPE("view", "PlayFieldView::resetCards");
+    if (!gameModel)
+    {
+        return;
+    }
+    
+    clearHint();
+    _moveCallback = nullptr;
+    _pendingModel = nullptr;
+    
+    // 先中止移动并全部隐藏，addCard再把开局局面中的牌原地复用并显示
+    for (CardView* cardView : _cardViews)
+    {
+        if (cardView)
+        {
+            cardView->setPositionImmediate(cardView->getPosition());
+            cardView->setVisible(false);
+        }
+    }
+    for (const auto& cardModel : gameModel->getPlayfieldCards())
     {
-        addCard(cardModel);
+        addCard(cardModel, gameModel->getPlayfieldZOrder(cardModel.getCardId()));
     }
 }
 
-void PlayFieldView::addCard(const CardModel& cardModel)
+void PlayFieldView::addCard(const CardModel& cardModel, int zOrder)
 {
     int cardId = cardModel.getCardId();
+    if (cardId < 0)
+    {
+        CCLOG("PlayFieldView: Card without id cannot be shown");
+        return;
+    }
+    if (cardId >= static_cast<int>(_cardViews.size()))
+    {
+        _cardViews.resize(cardId + 1, nullptr);
+    }
     
     // 检查是否已存在
-    if (_cardViews.find(cardId) != _cardViews.end())
+    CardView* existingView = _cardViews[cardId];
+    if (existingView)
     {
-        CCLOG("PlayFieldView: Card %d already exists", cardId);
+        if (existingView->isVisible())
+        {
+            CCLOG("PlayFieldView: Card %d already exists", cardId);
+            return;
+        }
+        
+        // 复用移走时隐藏的视图
+        existingView->updateView(cardModel);
+        existingView->setPositionImmediate(cardModel.getPosition());
+        existingView->setLocalZOrder(zOrder);
+        existingView->setVisible(true);
         return;
     }
     
@@ -69,33 +173,33 @@ void PlayFieldView::addCard(const CardModel& cardModel)
             this->onCardClicked(id);
         });
         
-        this->addChild(cardView, cardId); // 使用cardId作为zOrder
+        this->addChild(cardView, zOrder);
         _cardViews[cardId] = cardView;
     }
 }
 
 void PlayFieldView::removeCard(int cardId)
 {
-    auto it = _cardViews.find(cardId);
-    if (it != _cardViews.end())
+    CardView* cardView = getCardViewById(cardId);
+    if (cardView)
     {
-        it->second->removeFromParent();
-        _cardViews.erase(it);
+        cardView->removeFromParent();
+        _cardViews[cardId] = nullptr;
     }
 }
 
 CardView* PlayFieldView::getCardViewById(int cardId)
 {
-    auto it = _cardViews.find(cardId);
-    if (it != _cardViews.end())
+    if (cardId < 0 || cardId >= static_cast<int>(_cardViews.size()))
     {
-        return it->second;
+        return nullptr;
     }
-    return nullptr;
+    return _cardViews[cardId];
 }
 
 void PlayFieldView::updateCardView(const CardModel& cardModel)
 {
+    TRACE_SCOPE("view", "PlayFieldView::updateCardView");
     CardView* cardView = getCardViewById(cardModel.getCardId());
     if (cardView)
     {
@@ -103,6 +207,28 @@ void PlayFieldView::updateCardView(const CardModel& cardModel)
     }
 }
 
+void PlayFieldView::showHint(int cardId)
+{
+    clearHint();
+    
+    CardView* cardView = getCardViewById(cardId);
+    if (cardView)
+    {
+        cardView->setHighlighted(true);
+        _hintCardId = cardId;
+    }
+}
+
+void PlayFieldView::clearHint()
+{
+    CardView* cardView = getCardViewById(_hintCardId);
+    if (cardView)
+    {
+        cardView->setHighlighted(false);
+    }
+    _hintCardId = -1;
+}
+
 void PlayFieldView::playMoveAnimation(int cardId, const Vec2& targetPos,
                                       const std::function<void()>& callback)
 {
@@ -112,13 +238,9 @@ void PlayFieldView::playMoveAnimation(int cardId, const Vec2& targetPos,
         // 移动时禁止点击
         cardView->setClickable(false);
         
-        cardView->moveTo(targetPos, GameConstants::kCardMoveTime, [this, cardId, callback]() {
-            // 动画完成后从视图中移除
-            this->removeCard(cardId);
-            if (callback)
-            {
-                callback();
-            }
+        _moveCallback = callback;
+        cardView->moveTo(targetPos, GameConstants::kCardMoveTime, [this, cardView]() {
+            this->onMoveAnimationFinished(cardView);
         });
     }
     else if (callback)
@@ -127,6 +249,20 @@ void PlayFieldView::playMoveAnimation(int cardId, const Vec2& targetPos,
     }
 }
 
+void PlayFieldView::onMoveAnimationFinished(CardView* cardView)
+{
+    // 动画完成后隐藏，回退时addCard直接复用
+    cardView->setVisible(false);
+    
+    // 先取出再调用：回调中可能开始下一个动画
+    std::function<void()> callback;
+    callback.swap(_moveCallback);
+    if (callback)
+    {
+        callback();
+    }
+}
+
 void PlayFieldView::playMoveBackAnimation(int cardId, const Vec2& originalPos,
                                           const std::function<void()>& callback)
 {
@@ -154,14 +290,18 @@ void PlayFieldView::setCardClickCallback(const CardClickCallback& callback)
 
 void PlayFieldView::clearAllCards()
 {
-    for (auto& pair : _cardViews)
+    TRACE_SCOPE("view", "PlayFieldView::clearAllCards");
+    for (CardView* cardView : _cardViews)
     {
-        if (pair.second)
+        if (cardView)
         {
-            pair.second->removeFromParent();
+            cardView->removeFromParent();
         }
     }
-    _cardViews.clear();
+    _cardViews = ArenaVector<CardView*>();
+    _hintCardId = -1;
+    _moveCallback = nullptr;
+    _pendingModel = nullptr;
 }
 
 void PlayFieldView::onCardClicked(int cardId)
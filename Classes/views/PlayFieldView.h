@@ -14,7 +14,7 @@
 #include "cocos2d.h"
 #include "views/CardView.h"
 #include "models/GameModel.h"
-#include <map>
+#include "utils/LevelArena.h"
 #include <functional>
 
 /**
@@ -46,14 +46,44 @@ public:
     /**
      * @brief 初始化卡牌显示
      * @param gameModel 游戏数据模型（只读）
+     * @param arena 卡牌视图索引使用的关卡内存池，nullptr为全局堆
      */
-    void initCards(const GameModel* gameModel);
+    void initCards(const GameModel* gameModel, LevelArena* arena = nullptr);
     
     /**
-     * @brief 添加卡牌视图
+     * @brief 准备分帧创建卡牌视图：清除旧卡牌、分配视图索引，卡牌由buildPendingCards逐步创建
+     * @param gameModel 游戏数据模型（只读，创建完成前须保持不变）
+     * @param arena 卡牌视图索引使用的关卡内存池，nullptr为全局堆
+     */
+    void prepareCards(const GameModel* gameModel, LevelArena* arena = nullptr);
+    
+    /**
+     * @brief 在时间预算内继续创建准备好的卡牌视图（至少创建一张）
+     * @param budgetSeconds 本次最多占用的时间（秒）
+     * @return 全部创建完成（或没有待创建的卡牌）返回true
+     */
+    bool buildPendingCards(float budgetSeconds);
+    
+    /**
+     * @brief 是否还有待创建的卡牌视图
+     */
+    bool hasPendingCards() const { return _pendingModel != nullptr; }
+    
+    /**
+     * @brief 原地恢复为开局显示（重玩本关），不创建也不销毁卡牌视图
+     * @param gameModel 开局局面（与initCards时为同一关卡）
+     * 
+     * 中止所有移动和提示，按局面逐张恢复牌面、位置、绘制顺序和可见性；
+     * 移走的牌视图本来就隐藏保留着，直接复用。
+     */
+    void resetCards(const GameModel* gameModel);
+    
+    /**
+     * @brief 添加卡牌视图（该牌移走时隐藏的视图会被直接复用）
      * @param cardModel 卡牌数据模型
+     * @param zOrder 绘制顺序（GameModel::getPlayfieldZOrder）
      */
-    void addCard(const CardModel& cardModel);
+    void addCard(const CardModel& cardModel, int zOrder);
     
     /**
      * @brief 移除卡牌视图
@@ -74,13 +104,28 @@ public:
      */
     void updateCardView(const CardModel& cardModel);
     
+    // ========== 提示方法 ==========
+    
+    /**
+     * @brief 高亮提示的卡牌（同一时间只高亮一张）
+     * @param cardId 卡牌ID
+     */
+    void showHint(int cardId);
+    
+    /**
+     * @brief 清除提示高亮
+     */
+    void clearHint();
+    
     // ========== 动画方法 ==========
     
     /**
-     * @brief 播放卡牌匹配移动动画
+     * @brief 播放卡牌匹配移动动画，结束后隐藏该牌视图（保留以便回退时复用）
      * @param cardId 要移动的卡牌ID
      * @param targetPos 目标位置
      * @param callback 动画完成回调
+     * 
+     * 同一时间只移动一张牌（控制器在动画期间加锁）
      */
     void playMoveAnimation(int cardId, const cocos2d::Vec2& targetPos,
                           const std::function<void()>& callback = nullptr);
@@ -105,7 +150,7 @@ public:
     // ========== 清理方法 ==========
     
     /**
-     * @brief 清除所有卡牌
+     * @brief 清除所有卡牌并释放视图索引（回收关卡内存池前调用）
      */
     void clearAllCards();
 
@@ -115,10 +160,20 @@ private:
      * @param cardId 被点击的卡牌ID
      */
     void onCardClicked(int cardId);
+    
+    /**
+     * @brief 移动动画结束：隐藏移走的牌，执行完成回调
+     * @param cardView 移走的卡牌视图
+     */
+    void onMoveAnimationFinished(CardView* cardView);
 
 private:
-    std::map<int, CardView*> _cardViews;    // 卡牌ID到视图的映射
+    ArenaVector<CardView*> _cardViews;       // 按卡牌ID索引的视图，没有视图为nullptr
     CardClickCallback _cardClickCallback;    // 卡牌点击回调
+    int _hintCardId;                         // 当前高亮的卡牌ID，无高亮为-1
+    std::function<void()> _moveCallback;     // 当前移动动画的完成回调
+    const GameModel* _pendingModel;          // 分帧创建中的模型，没有待创建的卡牌为nullptr
+    size_t _pendingSlot;                     // 下一张待创建卡牌的槽位
 };
 
 #endif // __PLAYFIELD_VIEW_H__
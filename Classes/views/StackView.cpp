@@ -5,6 +5,8 @@
 
 #include "views/StackView.h"
 #include "configs/CardTypes.h"
+#include "utils/TraceProfiler.h"
+#include <utility>
 
 USING_NS_CC;
 
@@ -28,9 +30,11 @@ bool StackView::init()
     }
     
     _topCardView = nullptr;
+    _transitCardView = nullptr;
     _reserveNode = nullptr;
     _reserveSprite = nullptr;
     _reserveCountLabel = nullptr;
+    _reserveHighlight = nullptr;
     
     // 设置手牌区大小
     this->setContentSize(Size(GameConstants::kStackAreaWidth, GameConstants::kStackAreaHeight));
@@ -51,16 +55,29 @@ bool StackView::init()
 
 void StackView::initStack(const GameModel* gameModel)
 {
+    TRACE_SCOPE("view", "StackView::initStack");
     if (!gameModel)
     {
         return;
     }
     
+    // 丢弃上一局未播完的动画
+    if (_transitCardView)
+    {
+        _transitCardView->stopAllActions();
+        _transitCardView->setVisible(false);
+    }
+    _animationCallback = nullptr;
+    
     // 设置顶部牌
     if (gameModel->hasStackTopCard())
     {
         setTopCard(gameModel->getStackTopCard());
     }
+    else if (_topCardView)
+    {
+        _topCardView->setVisible(false);
+    }
     
     // 更新备用牌堆显示
     updateReserveDisplay(gameModel->getReserveCardCount());
@@ -136,34 +153,44 @@ void StackView::setupReserveTouchListener()
 
 void StackView::setTopCard(const CardModel& cardModel)
 {
-    // 移除旧的顶部牌
-    if (_topCardView)
-    {
-        _topCardView->removeFromParent();
-        _topCardView = nullptr;
-    }
-    
-    // 创建新的顶部牌视图
+    TRACE_SCOPE("view", "StackView::setTopCard");
     CardModel topCard = cardModel;
     topCard.setFaceUp(true);
     topCard.setClickable(true);
     topCard.setPosition(_topCardPos);
     
-    _topCardView = CardView::create(topCard);
+    // 已有顶部牌视图时原地更新，不重建
     if (_topCardView)
     {
-        _topCardView->setClickCallback([this](int cardId) {
+        _topCardView->updateView(topCard);
+        _topCardView->setPositionImmediate(_topCardPos);
+        _topCardView->setLocalZOrder(1);
+        _topCardView->setVisible(true);
+        return;
+    }
+    
+    _topCardView = createCardView(topCard, 1);
+}
+
+CardView* StackView::createCardView(const CardModel& cardModel, int zOrder)
+{
+    CardView* cardView = CardView::create(cardModel);
+    if (cardView)
+    {
+        cardView->setClickCallback([this](int cardId) {
             if (_topCardClickCallback)
             {
                 _topCardClickCallback(cardId);
             }
         });
-        this->addChild(_topCardView, 1);
+        this->addChild(cardView, zOrder);
     }
+    return cardView;
 }
 
 void StackView::updateTopCard(const CardModel& cardModel)
 {
+    TRACE_SCOPE("view", "StackView::updateTopCard");
     if (_topCardView)
     {
         _topCardView->updateView(cardModel);
@@ -179,8 +206,33 @@ Vec2 StackView::getTopCardPosition() const
     return this->convertToWorldSpace(_topCardPos);
 }
 
+void StackView::setReserveHighlighted(bool highlighted)
+{
+    if (!_reserveNode)
+    {
+        return;
+    }
+    
+    if (!_reserveHighlight)
+    {
+        // 备用牌堆精灵以容器原点为中心
+        float halfWidth = GameConstants::kCardWidth / 2 + 2;
+        float halfHeight = GameConstants::kCardHeight / 2 + 2;
+        _reserveHighlight = DrawNode::create();
+        for (int i = 0; i < 4; i++)
+        {
+            _reserveHighlight->drawRect(Vec2(-halfWidth - i, -halfHeight - i),
+                                        Vec2(halfWidth + i, halfHeight + i),
+                                        Color4F(1.0f, 0.85f, 0.2f, 1.0f));
+        }
+        _reserveNode->addChild(_reserveHighlight, 2);
+    }
+    _reserveHighlight->setVisible(highlighted);
+}
+
 void StackView::updateReserveDisplay(size_t remainingCount)
 {
+    TRACE_SCOPE("view", "StackView::updateReserveDisplay");
     if (_reserveCountLabel)
     {
         _reserveCountLabel->setString(std::to_string(remainingCount));
@@ -208,34 +260,54 @@ Vec2 StackView::getReservePosition() const
 void StackView::playDrawAnimation(const CardModel& newTopCard,
                                   const std::function<void()>& callback)
 {
-    // 创建临时卡牌视图在备用牌堆位置
+    // 移动的牌从备用牌堆位置背面出发
     CardModel tempCard = newTopCard;
     tempCard.setFaceUp(false);
+    tempCard.setClickable(false);
     tempCard.setPosition(_reservePos);
     
-    CardView* tempCardView = CardView::create(tempCard);
-    if (tempCardView)
+    if (_transitCardView)
     {
-        this->addChild(tempCardView, 2);
-        
-        // 移动到顶部牌位置
-        tempCardView->moveTo(_topCardPos, GameConstants::kCardMoveTime, 
-            [this, tempCardView, newTopCard, callback]() {
-                // 移除临时视图
-                tempCardView->removeFromParent();
-                // 设置新的顶部牌
-                this->setTopCard(newTopCard);
-                
-                if (callback)
-                {
-                    callback();
-                }
-            });
+        _transitCardView->updateView(tempCard);
+        _transitCardView->setPositionImmediate(_reservePos);
+        _transitCardView->setVisible(true);
     }
-    else if (callback)
+    else
     {
-        callback();
+        _transitCardView = createCardView(tempCard, 2);
+    }
+    
+    if (!_transitCardView)
+    {
+        setTopCard(newTopCard);
+        if (callback)
+        {
+            callback();
+        }
+        return;
     }
+    
+    // 移动到顶部牌位置
+    _animationCallback = callback;
+    _transitCardView->moveTo(_topCardPos, GameConstants::kCardMoveTime, [this]() {
+        this->onDrawAnimationFinished();
+    });
+}
+
+void StackView::onDrawAnimationFinished()
+{
+    // 移动的牌翻到正面，直接接替为顶部牌；原顶部牌视图留作下一次移动使用
+    std::swap(_topCardView, _transitCardView);
+    _topCardView->setFaceUp(true);
+    _topCardView->setClickable(true);
+    _topCardView->setLocalZOrder(1);
+    if (_transitCardView)
+    {
+        _transitCardView->setVisible(false);
+        _transitCardView->setLocalZOrder(2);
+    }
+    
+    finishAnimation();
 }
 
 void StackView::playReplaceAnimation(CardView* incomingCardView,
@@ -257,6 +329,21 @@ void StackView::playReplaceAnimation(CardView* incomingCardView,
 void StackView::playUndoToPlayfieldAnimation(const Vec2& targetWorldPos,
                                              const CardModel& previousTopCard,
                                              const std::function<void()>& callback)
+{
+    // 转换目标位置为本地坐标
+    playUndoAnimation(this->convertToNodeSpace(targetWorldPos), previousTopCard, callback);
+}
+
+void StackView::playUndoToReserveAnimation(const CardModel& previousTopCard,
+                                           const std::function<void()>& callback)
+{
+    // 移动当前牌到备用牌堆位置
+    playUndoAnimation(_reservePos, previousTopCard, callback);
+}
+
+void StackView::playUndoAnimation(const Vec2& targetLocalPos,
+                                  const CardModel& previousTopCard,
+                                  const std::function<void()>& callback)
 {
     if (!_topCardView)
     {
@@ -269,81 +356,45 @@ void StackView::playUndoToPlayfieldAnimation(const Vec2& targetWorldPos,
         return;
     }
     
-    // 转换目标位置为本地坐标
-    Vec2 targetLocalPos = this->convertToNodeSpace(targetWorldPos);
-    
-    // 保存当前顶部牌视图的引用
-    CardView* movingCard = _topCardView;
-    _topCardView = nullptr;  // 清空引用，但不移除节点
+    // 当前顶部牌视图改作移动的牌，空闲的视图接替为顶部牌
+    std::swap(_topCardView, _transitCardView);
+    _transitCardView->setClickable(false);
+    _transitCardView->setLocalZOrder(2);
     
-    // 先创建之前的顶部牌（但不可见）
+    // 先设置之前的顶部牌（动画结束前不显示）
     setTopCard(previousTopCard);
     if (_topCardView)
     {
-        _topCardView->setOpacity(0);  // 初始不可见
+        _topCardView->setVisible(false);
     }
     
-    // 移动当前牌到目标位置
-    movingCard->moveTo(targetLocalPos, GameConstants::kCardMoveTime, 
-        [this, movingCard, callback]() {
-            // 移除移动的卡牌
-            movingCard->removeFromParent();
-            
-            // 显示之前的顶部牌
-            if (_topCardView)
-            {
-                _topCardView->setOpacity(255);
-            }
-            
-            if (callback)
-            {
-                callback();
-            }
-        });
+    _animationCallback = callback;
+    _transitCardView->moveTo(targetLocalPos, GameConstants::kCardMoveTime, [this]() {
+        this->onUndoAnimationFinished();
+    });
 }
 
-void StackView::playUndoToReserveAnimation(const CardModel& previousTopCard,
-                                           const std::function<void()>& callback)
+void StackView::onUndoAnimationFinished()
 {
-    if (!_topCardView)
+    // 隐藏移动的牌，显示之前的顶部牌
+    _transitCardView->setVisible(false);
+    if (_topCardView)
     {
-        // 没有当前顶部牌，直接设置新的顶部牌
-        setTopCard(previousTopCard);
-        if (callback)
-        {
-            callback();
-        }
-        return;
+        _topCardView->setVisible(true);
     }
     
-    // 保存当前顶部牌视图的引用
-    CardView* movingCard = _topCardView;
-    _topCardView = nullptr;  // 清空引用，但不移除节点
-    
-    // 先创建之前的顶部牌（但不可见）
-    setTopCard(previousTopCard);
-    if (_topCardView)
+    finishAnimation();
+}
+
+void StackView::finishAnimation()
+{
+    // 先取出再调用：回调中可能开始下一个动画
+    std::function<void()> callback;
+    callback.swap(_animationCallback);
+    if (callback)
     {
-        _topCardView->setOpacity(0);  // 初始不可见
+        callback();
     }
-    
-    // 移动当前牌到备用牌堆位置
-    movingCard->moveTo(_reservePos, GameConstants::kCardMoveTime, 
-        [this, movingCard, callback]() {
-            // 移除移动的卡牌
-            movingCard->removeFromParent();
-            
-            // 显示之前的顶部牌
-            if (_topCardView)
-            {
-                _topCardView->setOpacity(255);
-            }
-            
-            if (callback)
-            {
-                callback();
-            }
-        });
 }
 
 void StackView::setReserveClickCallback(const ReserveClickCallback& callback)
@@ -21,6 +21,7 @@
  * 
  * 管理手牌区顶部牌和备用牌堆的显示与交互。
  * 视图层只负责显示和接收用户输入，不包含业务逻辑。
+ * 顶部牌和动画中移动的牌各用一个常驻的卡牌视图，翻牌和回退时两者互换角色，不再创建视图。
  */
 class StackView : public cocos2d::Node
 {
@@ -53,7 +54,7 @@ public:
     // ========== 顶部牌操作 ==========
     
     /**
-     * @brief 设置顶部牌
+     * @brief 设置顶部牌（已有顶部牌视图时原地更新）
      * @param cardModel 卡牌数据模型
      */
     void setTopCard(const CardModel& cardModel);
@@ -84,6 +85,12 @@ public:
      */
     void updateReserveDisplay(size_t remainingCount);
     
+    /**
+     * @brief 设置备用牌堆是否高亮（提示翻牌）
+     * @param highlighted true表示高亮
+     */
+    void setReserveHighlighted(bool highlighted);
+    
     /**
      * @brief 获取备用牌堆位置（世界坐标）
      * @return 备用牌堆中心位置
@@ -150,18 +157,54 @@ private:
      * @brief 设置备用牌堆触摸事件
      */
     void setupReserveTouchListener();
+    
+    /**
+     * @brief 创建手牌区使用的卡牌视图
+     * @param cardModel 卡牌数据模型
+     * @param zOrder 绘制顺序
+     * @return 卡牌视图
+     */
+    CardView* createCardView(const CardModel& cardModel, int zOrder);
+    
+    /**
+     * @brief 当前顶部牌移到目标位置，之前的顶部牌在动画结束后显示
+     * @param targetLocalPos 目标位置（本地坐标）
+     * @param previousTopCard 之前的顶部牌数据
+     * @param callback 动画完成回调
+     */
+    void playUndoAnimation(const cocos2d::Vec2& targetLocalPos,
+                           const CardModel& previousTopCard,
+                           const std::function<void()>& callback);
+    
+    /**
+     * @brief 翻牌动画结束：移动的牌成为顶部牌
+     */
+    void onDrawAnimationFinished();
+    
+    /**
+     * @brief 回退动画结束：隐藏移动的牌，显示之前的顶部牌
+     */
+    void onUndoAnimationFinished();
+    
+    /**
+     * @brief 执行并清除动画完成回调
+     */
+    void finishAnimation();
 
 private:
     CardView* _topCardView;                     ///< 顶部牌视图
+    CardView* _transitCardView;                 ///< 动画中移动的卡牌视图，空闲时隐藏
     cocos2d::Node* _reserveNode;                ///< 备用牌堆容器
     cocos2d::Sprite* _reserveSprite;            ///< 备用牌堆背景
     cocos2d::Label* _reserveCountLabel;         ///< 剩余数量标签
+    cocos2d::DrawNode* _reserveHighlight;       ///< 备用牌堆提示高亮框
     
     cocos2d::Vec2 _topCardPos;                  ///< 顶部牌位置
     cocos2d::Vec2 _reservePos;                  ///< 备用牌堆位置
     
     ReserveClickCallback _reserveClickCallback; ///< 备用牌堆点击回调
     TopCardClickCallback _topCardClickCallback; ///< 顶部牌点击回调
+    std::function<void()> _animationCallback;   ///< 当前动画的完成回调（同一时间只播放一个动画）
 };
 
 #endif // __STACK_VIEW_H__
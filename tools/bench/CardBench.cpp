@@ -0,0 +1,808 @@
+/**
+ * @file CardBench.cpp
+ * @brief 卡牌引擎微基准测试
+ * 
+ * 对规则判定、合法操作生成、遮挡计算、模型增删查、撤销、序列化、关卡加载、关卡缓存、洗牌和开局等热点逐项计时，
+ * 报告每次操作的耗时（ns/op）和堆分配次数（allocs/op）。
+ * 合成局面使用固定种子生成，不同提交之间的结果可以直接对比。
+ * 分配次数来自AllocationCounter，需以PLAYINGCARDS_ENABLE_ALLOC_COUNTER=1编译（工具构建默认开启）。
+ * --check-allocs时按分配预算检查走牌等热路径，超出预算返回非零，可作为回归检查。
+ * 用法：bench_cards [--levels 关卡目录] [--filter 子串] [--min-time 秒] [--json 输出文件] [--check-allocs]
+ */
+
+#include "configs/LevelConfigLoader.h"
+#include "managers/GameStatePublisher.h"
+#include "managers/LevelConfigCache.h"
+#include "managers/ReplayRecorder.h"
+#include "managers/UndoManager.h"
+#include "services/GameModelGenerator.h"
+#include "services/GameRules.h"
+#include "services/GameSnapshotService.h"
+#include "services/LevelCompiler.h"
+#include "utils/AllocationCounter.h"
+#include "utils/CardUtils.h"
+#include "utils/DeterministicRandom.h"
+#include "utils/FixedBlockPool.h"
+#include "utils/LevelArena.h"
+#include "utils/MatchRules.h"
+#include "json/document.h"
+#include "json/stringbuffer.h"
+#include "json/writer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ========== 基准框架 ==========
+
+namespace
+{
+    /// 防止被测代码被优化掉
+    volatile int s_sink = 0;
+    
+    /**
+     * @brief 单项结果
+     */
+    struct BenchResult
+    {
+        std::string name;
+        long iterations;
+        double nsPerOp;
+        double allocsPerOp;
+        double bytesPerOp;
+    };
+    
+    /**
+     * @brief 基准运行器：按名称过滤，自动加倍迭代次数直到累计时长足够
+     */
+    class BenchRunner
+    {
+    public:
+        BenchRunner(const std::string& filter, double minSeconds)
+            : _filter(filter)
+            , _minSeconds(minSeconds)
+        {
+        }
+        
+        /**
+         * @brief 测量func单次执行的平均耗时和分配
+         * 
+         * 取三轮中最快的一轮，降低调度噪声；分配数取同一轮的值。
+         */
+        template <typename Func>
+        void run(const std::string& name, Func&& func)
+        {
+            if (!_filter.empty() && name.find(_filter) == std::string::npos)
+            {
+                return;
+            }
+            
+            using Clock = std::chrono::steady_clock;
+            long iterations = 1;
+            for (;;)
+            {
+                auto begin = Clock::now();
+                for (long i = 0; i < iterations; i++)
+                {
+                    func();
+                }
+                double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+                if (seconds >= _minSeconds / 3)
+                {
+                    break;
+                }
+                iterations *= 2;
+            }
+            
+            BenchResult best = { name, iterations, 0.0, 0.0, 0.0 };
+            for (int round = 0; round < 3; round++)
+            {
+                uint64_t allocsBefore = AllocationCounter::getAllocationCount();
+                uint64_t bytesBefore = AllocationCounter::getAllocatedBytes();
+                auto begin = Clock::now();
+                for (long i = 0; i < iterations; i++)
+                {
+                    func();
+                }
+                double ns = std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / iterations;
+                if (round == 0 || ns < best.nsPerOp)
+                {
+                    best.nsPerOp = ns;
+                    best.allocsPerOp = static_cast<double>(AllocationCounter::getAllocationCount() - allocsBefore) / iterations;
+                    best.bytesPerOp = static_cast<double>(AllocationCounter::getAllocatedBytes() - bytesBefore) / iterations;
+                }
+            }
+            
+            std::printf("%-52s %12.1f %10.2f %12.1f %12ld\n", name.c_str(),
+                        best.nsPerOp, best.allocsPerOp, best.bytesPerOp, best.iterations);
+            std::fflush(stdout);
+            _results.push_back(best);
+        }
+        
+        const std::vector<BenchResult>& getResults() const { return _results; }
+    
+    private:
+        std::string _filter;
+        double _minSeconds;
+        std::vector<BenchResult> _results;
+    };
+    
+    bool readFile(const std::string& path, std::string& outContent)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+        std::stringstream stream;
+        stream << file.rdbuf();
+        outContent = stream.str();
+        return true;
+    }
+    
+    /**
+     * @brief 生成固定种子的合成局面：卡牌随机散布在主牌区内，遮挡关系较密
+     */
+    void buildSyntheticModel(int cardCount, uint32_t seed, GameModel& outGameModel)
+    {
+        std::mt19937 rng(seed);
+        outGameModel.clear();
+        for (int i = 0; i < cardCount; i++)
+        {
+            CardModel card(outGameModel.getNextCardId(),
+                           static_cast<CardSuitType>(rng() % 4),
+                           static_cast<CardFaceType>(rng() % 13));
+            card.setPosition(cocos2d::Vec2(100.0f + rng() % 880, 700.0f + rng() % 1100));
+            card.setArea(CardAreaType::PLAYFIELD);
+            card.setFaceUp(true);
+            outGameModel.addPlayfieldCard(card);
+        }
+        
+        CardModel topCard(outGameModel.getNextCardId(), CardSuitType::CLUBS, CardFaceType::SEVEN);
+        topCard.setArea(CardAreaType::STACK);
+        topCard.setFaceUp(true);
+        outGameModel.setStackTopCard(topCard);
+        for (int i = 0; i < 16; i++)
+        {
+            CardModel card(outGameModel.getNextCardId(),
+                           static_cast<CardSuitType>(rng() % 4),
+                           static_cast<CardFaceType>(rng() % 13));
+            card.setArea(CardAreaType::RESERVE);
+            outGameModel.addReserveCard(card);
+        }
+        GameModelGenerator::updatePlayfieldClickable(outGameModel);
+    }
+    
+    void writeJsonReport(const std::string& path, const std::vector<BenchResult>& results)
+    {
+        rapidjson::Document doc;
+        doc.SetObject();
+        auto& allocator = doc.GetAllocator();
+        
+        rapidjson::Value benchArray(rapidjson::kArrayType);
+        for (const auto& result : results)
+        {
+            rapidjson::Value item(rapidjson::kObjectType);
+            item.AddMember("name", rapidjson::Value(result.name.c_str(), allocator), allocator);
+            item.AddMember("ns_per_op", result.nsPerOp, allocator);
+            item.AddMember("allocs_per_op", result.allocsPerOp, allocator);
+            item.AddMember("bytes_per_op", result.bytesPerOp, allocator);
+            item.AddMember("iterations", static_cast<int64_t>(result.iterations), allocator);
+            benchArray.PushBack(item, allocator);
+        }
+        doc.AddMember("benchmarks", benchArray, allocator);
+        
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        doc.Accept(writer);
+        
+        std::ofstream file(path, std::ios::binary);
+        file.write(buffer.GetString(), buffer.GetSize());
+        file << '\n';
+    }
+    
+    /**
+     * @brief 分配预算：名称以prefix开头的基准项每次操作最多允许的分配次数
+     * 
+     * 多个前缀都匹配时使用最长的一个，较具体的条目覆盖通用条目。
+     */
+    struct AllocBudget
+    {
+        const char* prefix;
+        double maxAllocsPerOp;
+    };
+    
+    // 稳定状态下的走牌路径（规则、撤销、录像、遮挡更新、局面发布）、合法操作生成与原地执行撤销、
+    // 使用关卡内存池的开局和重玩、块池替身对象的复用、关卡缓存命中不允许分配。
+    // 超过128张牌时局面位集不再内联，消牌复制根节点和一个叶节点（2次），翻牌和回退不分配，
+    // 按走牌路径中消牌的占比平均后不超过1次
+    const AllocBudget kAllocBudgets[] = {
+        { "Move path (model only)/", 0.0 },
+        { "Move path (model only)/300", 1.0 },
+        { "UndoManager record/undo", 0.0 },
+        { "GameModelGenerator::updatePlayfieldClickable/", 0.0 },
+        { "GameModel::removePlayfieldCard+addPlayfieldCard/", 0.0 },
+        { "GameRules::generateMoves/", 0.0 },
+        { "GameRules::applyMove+unapplyMove/", 0.0 },
+        { "GameController level start (arena)/", 0.0 },
+        { "GameController restart/", 0.0 },
+        { "View-sized object churn (block pool)/", 0.0 },
+        { "DeterministicRandom::shuffle/", 0.0 },
+        { "LevelConfigCache hit/", 0.0 },
+        { "GameState from cached level/", 0.0 },
+    };
+    
+    /**
+     * @brief 检查各基准项是否超出分配预算
+     * @return 全部在预算内返回true
+     */
+    bool checkAllocBudgets(const std::vector<BenchResult>& results)
+    {
+        bool isOk = true;
+        for (const auto& result : results)
+        {
+            const AllocBudget* matched = nullptr;
+            for (const auto& budget : kAllocBudgets)
+            {
+                size_t length = std::strlen(budget.prefix);
+                if (result.name.compare(0, length, budget.prefix) == 0
+                    && (!matched || length > std::strlen(matched->prefix)))
+                {
+                    matched = &budget;
+                }
+            }
+            if (matched && result.allocsPerOp > matched->maxAllocsPerOp)
+            {
+                std::fprintf(stderr, "alloc budget exceeded: %s %.4f allocs/op (budget %.4f)\n",
+                             result.name.c_str(), result.allocsPerOp, matched->maxAllocsPerOp);
+                isOk = false;
+            }
+        }
+        return isOk;
+    }
+    
+    int usage()
+    {
+        std::fprintf(stderr,
+                     "usage: bench_cards [--levels dir] [--filter substr] [--min-time seconds] [--json out.json]"
+                     " [--check-allocs]\n");
+        return 2;
+    }
+}
+
+// ========== 基准项 ==========
+
+namespace
+{
+    void benchCanMatch(BenchRunner& runner)
+    {
+        std::mt19937 rng(1);
+        std::vector<CardFaceType> faces(1024);
+        for (auto& face : faces)
+        {
+            face = static_cast<CardFaceType>(rng() % 13);
+        }
+        
+        // 每次操作判定一对点数
+        size_t index = 0;
+        runner.run("CardUtils::canMatch", [&]() {
+            s_sink += CardUtils::canMatch(faces[index & 1023], faces[(index + 1) & 1023]) ? 1 : 0;
+            index++;
+        });
+    }
+    
+    /**
+     * @brief 洗乱一副备用牌堆（发牌种子的开销），与标准库的mt19937+std::shuffle对比
+     */
+    void benchShuffle(BenchRunner& runner, int cardCount)
+    {
+        std::vector<int> deck(cardCount);
+        for (int i = 0; i < cardCount; i++)
+        {
+            deck[i] = i;
+        }
+        
+        std::string label = std::to_string(cardCount);
+        DeterministicRandom rng(1);
+        runner.run("DeterministicRandom::shuffle/" + label, [&]() {
+            rng.shuffle(deck.begin(), deck.end());
+            s_sink += deck[0];
+        });
+        std::mt19937 stdRng(1);
+        runner.run("std::shuffle(mt19937)/" + label, [&]() {
+            std::shuffle(deck.begin(), deck.end(), stdRng);
+            s_sink += deck[0];
+        });
+    }
+    
+    template <typename Rule>
+    void benchMatchTable(BenchRunner& runner)
+    {
+        std::mt19937 rng(1);
+        std::vector<uint8_t> indexes(1024);
+        for (auto& matchIndex : indexes)
+        {
+            matchIndex = static_cast<uint8_t>(MatchRules::toIndex(static_cast<CardSuitType>(rng() % 4),
+                                                                  static_cast<CardFaceType>(rng() % 13)));
+        }
+        
+        // 每次操作判定一对卡牌（含花色）
+        size_t index = 0;
+        runner.run(std::string("MatchRules::Table<") + Rule::name() + ">::matches", [&]() {
+            s_sink += MatchRules::Table<Rule>::matches(indexes[index & 1023], indexes[(index + 1) & 1023]) ? 1 : 0;
+            index++;
+        });
+    }
+    
+    void benchUpdateClickable(BenchRunner& runner, int cardCount)
+    {
+        GameModel gameModel;
+        buildSyntheticModel(cardCount, 100 + cardCount, gameModel);
+        runner.run("GameModelGenerator::updatePlayfieldClickable/" + std::to_string(cardCount), [&]() {
+            GameModelGenerator::updatePlayfieldClickable(gameModel);
+        });
+    }
+    
+    void benchModelLookup(BenchRunner& runner, int cardCount)
+    {
+        GameModel gameModel;
+        buildSyntheticModel(cardCount, 200 + cardCount, gameModel);
+        std::mt19937 rng(3);
+        std::vector<int> ids(1024);
+        for (auto& id : ids)
+        {
+            id = static_cast<int>(rng() % cardCount);
+        }
+        
+        size_t index = 0;
+        CardModel foundCard;
+        runner.run("GameModel::getPlayfieldCardById/" + std::to_string(cardCount), [&]() {
+            s_sink += gameModel.getPlayfieldCardById(ids[index++ & 1023], foundCard) ? 1 : 0;
+        });
+        
+        // 移除后立即放回，保持局面规模不变
+        runner.run("GameModel::removePlayfieldCard+addPlayfieldCard/" + std::to_string(cardCount), [&]() {
+            int cardId = ids[index++ & 1023];
+            CardModel card;
+            gameModel.getPlayfieldCardById(cardId, card);
+            gameModel.removePlayfieldCard(cardId);
+            gameModel.addPlayfieldCard(card);
+        });
+    }
+    
+    void benchUndoCycle(BenchRunner& runner, int cardCount)
+    {
+        GameModel gameModel;
+        buildSyntheticModel(cardCount, 300 + cardCount, gameModel);
+        LevelCompiler::compileModel(gameModel);
+        UndoManager undoManager;
+        undoManager.init(&gameModel);
+        
+        runner.run("UndoManager record/undo draw/" + std::to_string(cardCount), [&]() {
+            GameRules::applyReserveToStack(gameModel, &undoManager);
+            GameRules::applyUndo(gameModel, undoManager);
+        });
+        
+        // 选一张可点击的牌，把手牌区顶部牌换成与它匹配的点数，使移动总能成功
+        int movableId = -1;
+        for (const auto& card : gameModel.getPlayfieldCards())
+        {
+            if (card.isClickable())
+            {
+                movableId = card.getCardId();
+                CardModel& topCard = gameModel.getStackTopCardMutable();
+                topCard.setFace(static_cast<CardFaceType>((static_cast<int>(card.getFace()) + 1) % 13));
+                break;
+            }
+        }
+        if (movableId < 0)
+        {
+            return;
+        }
+        runner.run("UndoManager record/undo playfield move/" + std::to_string(cardCount), [&]() {
+            GameRules::applyPlayfieldToStack(gameModel, &undoManager, movableId);
+            GameRules::applyUndo(gameModel, undoManager);
+        });
+    }
+    
+    /// 与卡牌视图大小相近的对象（cocos节点本身无法在工具中创建）
+    struct HeapViewObject
+    {
+        char payload[480];
+    };
+    
+    struct PooledViewObject
+    {
+        PLAYINGCARDS_USE_BLOCK_POOL(PooledViewObject)
+        
+        char payload[480];
+    };
+    
+    PLAYINGCARDS_DEFINE_BLOCK_POOL(PooledViewObject, 64)
+    
+    /**
+     * @brief 换关时视图对象的成批创建和释放：全局堆与固定块池
+     * 
+     * 每次操作创建一局的卡牌视图再全部释放；块池在第一局之后只在空闲链表上复用块。
+     * 测的是同样大小的替身对象，不是CardView/CardSprite本身（其构造依赖cocos2d），
+     * 只反映块池的分配开销，视图的构造和初始化不在其中。
+     */
+    template <typename T>
+    void benchViewChurn(BenchRunner& runner, const char* name, int cardCount)
+    {
+        std::vector<T*> views;
+        views.reserve(cardCount);
+        runner.run(name + std::to_string(cardCount), [&]() {
+            for (int i = 0; i < cardCount; i++)
+            {
+                views.push_back(new (std::nothrow) T());
+            }
+            s_sink += views.back() ? 1 : 0;
+            for (T* view : views)
+            {
+                delete view;
+            }
+            views.clear();
+        });
+    }
+    
+    /**
+     * @brief 控制器一次操作的模型部分：规则判定与执行、撤销记录、录像记录、局面历史与发布
+     * 
+     * 能消牌就消第一张可消的牌，否则翻牌；无路可走后逐步回退到开局再重新走，
+     * 回到开局时像开新局一样重新开始录像。每次操作计为一次。
+     * 局面部分与GameController::commitPublishedState、revertPublishedState相同：
+     * 走牌时在结构共享的局面上执行同一操作，压入历史并发布；回退时弹出历史并发布。
+     * 
+     * 视图部分（卡牌视图更新、动画回调）依赖cocos2d，无法在这里运行，
+     * 只能在开启分配计数的游戏构建中通过各ALLOC_SCOPE的报告检查。
+     */
+    void benchMovePath(BenchRunner& runner, const std::string& label, const GameModel& initialModel)
+    {
+        GameModel gameModel = initialModel;
+        UndoManager undoManager;
+        undoManager.init(&gameModel);
+        int undoCount = 0;
+        undoManager.setUndoExecuteCallback([&undoCount](const UndoModel&) {
+            undoCount++;
+        });
+        ReplayRecorder replayRecorder;
+        replayRecorder.beginTestLevel();
+        
+        // 与GameController开局时相同的预留
+        size_t cardCount = gameModel.getPlayfieldCards().size() + gameModel.getReserveCardCount();
+        undoManager.reserve(cardCount);
+        replayRecorder.reserveFor(gameModel);
+        
+        GameState currentState;
+        GameSnapshotService::captureState(gameModel, currentState);
+        std::vector<GameState> stateHistory;
+        stateHistory.reserve(cardCount);
+        GameStatePublisher statePublisher;
+        auto commitState = [&](const GameState& nextState) {
+            stateHistory.push_back(currentState);
+            currentState = nextState;
+            statePublisher.publish(currentState, 0);
+        };
+        
+        bool isRewinding = false;
+        runner.run("Move path (model only)/" + label, [&]() {
+            if (!isRewinding)
+            {
+                for (const auto& card : gameModel.getPlayfieldCards())
+                {
+                    int cardId = card.getCardId();
+                    if (GameRules::checkPlayfieldToStack(gameModel, cardId) == GameRuleResult::OK)
+                    {
+                        GameRules::applyPlayfieldToStack(gameModel, &undoManager, cardId);
+                        replayRecorder.recordPlayfieldToStack(cardId);
+                        replayRecorder.updateResult(gameModel);
+                        GameState nextState;
+                        if (GameRules::applyPlayfieldToStack(currentState, cardId, nextState) == GameRuleResult::OK)
+                        {
+                            commitState(nextState);
+                        }
+                        return;
+                    }
+                }
+                if (GameRules::applyReserveToStack(gameModel, &undoManager) == GameRuleResult::OK)
+                {
+                    replayRecorder.recordReserveToStack();
+                    replayRecorder.updateResult(gameModel);
+                    GameState nextState;
+                    if (GameRules::applyReserveToStack(currentState, nextState) == GameRuleResult::OK)
+                    {
+                        commitState(nextState);
+                    }
+                    return;
+                }
+                isRewinding = true;
+            }
+            
+            if (GameRules::applyUndo(gameModel, undoManager) == GameRuleResult::OK)
+            {
+                replayRecorder.recordUndo();
+                replayRecorder.updateResult(gameModel);
+                if (!stateHistory.empty())
+                {
+                    currentState = stateHistory.back();
+                    stateHistory.pop_back();
+                    statePublisher.publish(currentState, 0);
+                }
+            }
+            if (!undoManager.canUndo())
+            {
+                isRewinding = false;
+                replayRecorder.beginTestLevel();
+            }
+        });
+        s_sink += undoCount + static_cast<int>(statePublisher.getEpoch() & 1);
+    }
+    
+    /**
+     * @brief 无界面搜索的内层循环：列出合法操作，原地执行和撤销
+     * 
+     * 与走牌路径相同，总是执行第一个合法操作直到无路可走，再逐步撤销回到开局。
+     * 缓冲区和撤销数据都由调用方按上限一次分配。每次执行或撤销计为一次操作。
+     */
+    void benchMoveGenerator(BenchRunner& runner, const std::string& label, const GameModel& initialModel)
+    {
+        GameModel gameModel = initialModel;
+        std::vector<GameMove> moves(GameRules::getMaxMoveCount(gameModel));
+        runner.run("GameRules::generateMoves/" + label, [&]() {
+            s_sink += static_cast<int>(GameRules::generateMoves(gameModel, moves.data(), moves.size()));
+        });
+        
+        std::vector<AppliedMove> appliedMoves(gameModel.getPlayfieldCardCount() + gameModel.getReserveCardCount());
+        size_t depth = 0;
+        bool isRewinding = false;
+        runner.run("GameRules::applyMove+unapplyMove/" + label, [&]() {
+            if (!isRewinding)
+            {
+                if (GameRules::generateMoves(gameModel, moves.data(), moves.size()) > 0 && depth < appliedMoves.size())
+                {
+                    GameRules::applyMove(gameModel, moves[0], appliedMoves[depth++]);
+                    return;
+                }
+                isRewinding = true;
+            }
+            
+            if (depth > 0)
+            {
+                GameRules::unapplyMove(gameModel, appliedMoves[--depth]);
+            }
+            isRewinding = depth > 0;
+        });
+    }
+    
+    /**
+     * @brief 开局：按关卡配置生成模型、保存开局局面并预留撤销栈，对比全局堆与关卡内存池；
+     *        以及重玩：把开局局面复制回模型
+     * 
+     * 全局堆每局都重新申请模型的各列；关卡内存池与GameController开局时相同，
+     * 先释放上一局的容器再整体回收，主内存块复用后开局不再分配。
+     * 重玩只复制数据，容器容量在开局时已预留。
+     */
+    void benchLevelStart(BenchRunner& runner, const std::string& label, const LevelConfig& levelConfig)
+    {
+        size_t playfieldCount = levelConfig.getPlayfieldCards().size();
+        size_t reserveCount = levelConfig.getStackCards().size();
+        runner.run("GameController level start (heap)/" + label, [&]() {
+            GameModel gameModel;
+            GameModel initialModel;
+            UndoManager undoManager;
+            undoManager.init(&gameModel);
+            s_sink += GameModelGenerator::generate(levelConfig, gameModel) ? 1 : 0;
+            initialModel = gameModel;
+            undoManager.reserve(playfieldCount + reserveCount);
+        });
+        
+        // 与控制器相同：上一局归还内存池后再借出，内存池由比各局活得久的所有者持有
+        LevelArenaPool arenaPool;
+        LevelArena* arena = nullptr;
+        GameModel gameModel;
+        GameModel initialModel;
+        UndoManager undoManager;
+        undoManager.init(&gameModel);
+        runner.run("GameController level start (arena)/" + label, [&]() {
+            gameModel.setArena(nullptr);
+            initialModel.setArena(nullptr);
+            undoManager.setArena(nullptr);
+            arenaPool.release(arena);
+            arena = arenaPool.acquire();
+            arena->reset(GameModel::getArenaBytes(playfieldCount, reserveCount) * 2
+                         + UndoManager::getArenaBytes(playfieldCount + reserveCount));
+            gameModel.setArena(arena);
+            initialModel.setArena(arena);
+            undoManager.setArena(arena);
+            s_sink += GameModelGenerator::generate(levelConfig, gameModel) ? 1 : 0;
+            initialModel = gameModel;
+            undoManager.reserve(playfieldCount + reserveCount);
+        });
+        
+        // 重玩前先走到终局，使复制覆盖整局的变化
+        ReplayRecorder replayRecorder;
+        replayRecorder.begin(levelConfig);
+        replayRecorder.reserveFor(gameModel);
+        runner.run("GameController restart/" + label, [&]() {
+            while (GameRules::applyReserveToStack(gameModel, &undoManager) == GameRuleResult::OK)
+            {
+            }
+            gameModel = initialModel;
+            undoManager.clearUndoStack();
+            replayRecorder.restart();
+            replayRecorder.updateResult(gameModel);
+        });
+        gameModel.setArena(nullptr);
+        initialModel.setArena(nullptr);
+        undoManager.setArena(nullptr);
+        arenaPool.release(arena);
+    }
+    
+    /**
+     * @brief 关卡缓存：命中时取得关卡，新对局复制共享的开局局面
+     * 
+     * 与GameController level start (heap)对比：每局独立的模型要复制布局各列，
+     * 共享局面只增加关卡数据的引用计数，同一关卡的并发对局几乎不占额外内存。
+     */
+    void benchLevelCache(BenchRunner& runner, const std::string& label, const LevelConfig& levelConfig)
+    {
+        LevelConfigCache levelCache(1);
+        std::shared_ptr<const CachedLevel> level = levelCache.insert(levelConfig);
+        if (!level)
+        {
+            return;
+        }
+        
+        runner.run("LevelConfigCache hit/" + label, [&]() {
+            s_sink += levelCache.findByHash(level->contentHash) ? 1 : 0;
+        });
+        runner.run("GameState from cached level/" + label, [&]() {
+            GameState state = level->initialState;
+            s_sink += state.getReserveCardCount();
+        });
+    }
+    
+    void benchSerialize(BenchRunner& runner, const std::string& label, const GameModel& gameModel)
+    {
+        runner.run("GameModel::serialize/" + label, [&]() {
+            rapidjson::Document doc;
+            rapidjson::Value json = gameModel.serialize(doc.GetAllocator());
+            s_sink += json.IsObject() ? 1 : 0;
+        });
+        
+        // 经过一次文本往返，得到与读档时相同的独立文档
+        rapidjson::Document source;
+        rapidjson::Value json = gameModel.serialize(source.GetAllocator());
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        json.Accept(writer);
+        rapidjson::Document doc;
+        doc.Parse(buffer.GetString());
+        GameModel target;
+        runner.run("GameModel::deserialize/" + label, [&]() {
+            s_sink += target.deserialize(doc) ? 1 : 0;
+        });
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string levelDir = "Resources/levels";
+    std::string filter;
+    std::string jsonPath;
+    double minSeconds = 0.3;
+    bool isCheckAllocs = false;
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--levels") == 0 && hasValue)
+        {
+            levelDir = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--filter") == 0 && hasValue)
+        {
+            filter = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--min-time") == 0 && hasValue)
+        {
+            minSeconds = std::max(0.01, std::atof(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--json") == 0 && hasValue)
+        {
+            jsonPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--check-allocs") == 0)
+        {
+            isCheckAllocs = true;
+        }
+        else
+        {
+            return usage();
+        }
+    }
+    
+    BenchRunner runner(filter, minSeconds);
+    std::printf("%-52s %12s %10s %12s %12s\n", "benchmark", "ns/op", "allocs/op", "bytes/op", "iterations");
+    
+    benchCanMatch(runner);
+    benchMatchTable<MatchRules::SameSuitAdjacent>(runner);
+    benchShuffle(runner, 52);
+    const int sizes[] = { 10, 100, 1000 };
+    for (int cardCount : sizes)
+    {
+        benchUpdateClickable(runner, cardCount);
+    }
+    for (int cardCount : sizes)
+    {
+        benchModelLookup(runner, cardCount);
+    }
+    benchUndoCycle(runner, 100);
+    benchViewChurn<HeapViewObject>(runner, "View-sized object churn (heap)/", 100);
+    benchViewChurn<PooledViewObject>(runner, "View-sized object churn (block pool)/", 100);
+    
+    GameModel syntheticModel;
+    buildSyntheticModel(100, 400, syntheticModel);
+    LevelCompiler::compileModel(syntheticModel);
+    benchMovePath(runner, "100", syntheticModel);
+    benchMoveGenerator(runner, "100", syntheticModel);
+    benchSerialize(runner, "100", syntheticModel);
+    
+    // 超过128张时局面位集不再内联存放，每步复制根节点和改动的叶节点
+    GameModel largeModel;
+    buildSyntheticModel(300, 500, largeModel);
+    LevelCompiler::compileModel(largeModel);
+    benchMovePath(runner, "300", largeModel);
+    
+    // 每个随包关卡：加载配置，并以初始局面测序列化
+    for (int levelId = 1; ; levelId++)
+    {
+        std::string path = levelDir + "/level_" + std::to_string(levelId) + ".json";
+        std::string content;
+        if (!readFile(path, content))
+        {
+            break;
+        }
+        
+        std::string label = "level_" + std::to_string(levelId);
+        LevelConfig levelConfig;
+        runner.run("LevelConfigLoader::loadFromString/" + label, [&]() {
+            s_sink += LevelConfigLoader::loadFromString(content, levelConfig) ? 1 : 0;
+        });
+        
+        GameModel gameModel;
+        if (GameModelGenerator::generate(levelConfig, gameModel))
+        {
+            benchLevelStart(runner, label, levelConfig);
+            benchLevelCache(runner, label, levelConfig);
+            benchMovePath(runner, label, gameModel);
+            benchMoveGenerator(runner, label, gameModel);
+            benchSerialize(runner, label, gameModel);
+        }
+    }
+    
+    if (!jsonPath.empty())
+    {
+        writeJsonReport(jsonPath, runner.getResults());
+    }
+    if (isCheckAllocs)
+    {
+        if (!AllocationCounter::isEnabled())
+        {
+            std::fprintf(stderr, "--check-allocs needs a build with PLAYINGCARDS_ENABLE_ALLOC_COUNTER=1\n");
+            return 2;
+        }
+        if (!checkAllocBudgets(runner.getResults()))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,459 @@
+/**
+ * @file SnapshotBench.cpp
+ * @brief 存档快照基准测试
+ * 
+ * 对比JSON序列化与二进制快照在保存/恢复GameModel及撤销栈时的耗时和体积，
+ * 以及内存中复制GameModel与不可变局面GameState的快照、走一步、持有大量版本的开销，
+ * 最后测量主线程发布局面、后台线程同时无锁读取的开销并校验读到的局面完整。
+ * 用法：bench_snapshot [关卡目录，默认Resources/levels]
+ */
+
+#include "configs/LevelConfigLoader.h"
+#include "services/GameModelGenerator.h"
+#include "services/GameRules.h"
+#include "services/GameSnapshotService.h"
+#include "services/StressLayoutGenerator.h"
+#include "managers/GameStatePublisher.h"
+#include "managers/UndoManager.h"
+#include "utils/AllocationCounter.h"
+#include "json/document.h"
+#include "json/stringbuffer.h"
+#include "json/writer.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /// 每个关卡附带的撤销记录数量（模拟一局中后期的存档）
+    const int kUndoRecordCount = 32;
+    
+    /// 每项测量的最短时长（秒）
+    const double kMinMeasureSeconds = 0.2;
+    
+    /// 持有版本数量的测量中保存的版本数
+    const int kVersionCount = 1000;
+    
+    /// 与GameModel逐步比对的最大步数（大牌面上GameModel每步都要重算可点击状态）
+    const int kVerifyMoveCount = 200;
+    
+    /// 发布测量中主线程发布的局面数量
+    const int kPublishCount = 100000;
+    
+    bool readFile(const std::string& path, std::string& outContent)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+        std::stringstream stream;
+        stream << file.rdbuf();
+        outContent = stream.str();
+        return true;
+    }
+    
+    /**
+     * @brief 重复执行直到累计时长足够，返回单次平均耗时（纳秒）
+     */
+    template <typename Func>
+    double measureNs(Func&& func)
+    {
+        using Clock = std::chrono::steady_clock;
+        long iterations = 1;
+        for (;;)
+        {
+            auto begin = Clock::now();
+            for (long i = 0; i < iterations; i++)
+            {
+                func();
+            }
+            double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+            if (seconds >= kMinMeasureSeconds)
+            {
+                return seconds * 1e9 / iterations;
+            }
+            iterations *= 2;
+        }
+    }
+    
+    void buildUndoRecords(const GameModel& gameModel, std::vector<UndoModel>& outRecords)
+    {
+        const auto& cards = gameModel.getPlayfieldCards();
+        for (int i = 0; i < kUndoRecordCount && !cards.empty(); i++)
+        {
+            CardModel card = cards.getCard(i % cards.slotCount());
+            UndoModel undoModel(i % 2 == 0 ? CardOperationType::PLAYFIELD_TO_STACK
+                                           : CardOperationType::RESERVE_TO_STACK);
+            undoModel.setMovedCard(card);
+            undoModel.setPreviousStackTopCard(gameModel.getStackTopCard());
+            undoModel.setOriginalPosition(card.getPosition());
+            undoModel.setTargetPosition(cocos2d::Vec2(440, 290));
+            outRecords.push_back(undoModel);
+        }
+    }
+    
+    std::string writeJson(const GameModel& gameModel, const std::vector<UndoModel>& undoRecords)
+    {
+        rapidjson::Document doc;
+        doc.SetObject();
+        auto& allocator = doc.GetAllocator();
+        
+        doc.AddMember("gameModel", gameModel.serialize(allocator), allocator);
+        rapidjson::Value undoArray(rapidjson::kArrayType);
+        for (const auto& undoModel : undoRecords)
+        {
+            undoArray.PushBack(undoModel.serialize(allocator), allocator);
+        }
+        doc.AddMember("undoStack", undoArray, allocator);
+        
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        doc.Accept(writer);
+        return std::string(buffer.GetString(), buffer.GetSize());
+    }
+    
+    bool readJson(const std::string& json, GameModel& outGameModel, std::vector<UndoModel>& outRecords)
+    {
+        rapidjson::Document doc;
+        doc.Parse(json.c_str());
+        if (doc.HasParseError() || !doc.HasMember("gameModel") || !doc.HasMember("undoStack"))
+        {
+            return false;
+        }
+        
+        if (!outGameModel.deserialize(doc["gameModel"]))
+        {
+            return false;
+        }
+        
+        const auto& undoArray = doc["undoStack"];
+        outRecords.clear();
+        for (rapidjson::SizeType i = 0; i < undoArray.Size(); i++)
+        {
+            UndoModel undoModel;
+            undoModel.deserialize(undoArray[i]);
+            outRecords.push_back(undoModel);
+        }
+        return true;
+    }
+    
+    /**
+     * @brief 选出下一步：第一张能出的主牌区卡牌，否则翻牌；无路可走返回false
+     */
+    bool pickMove(const GameState& state, int& outCardId)
+    {
+        outCardId = -1;
+        for (size_t cardId = 0; cardId < state.getPlayfield().size(); cardId++)
+        {
+            if (GameRules::checkPlayfieldToStack(state, static_cast<int>(cardId)) == GameRuleResult::OK)
+            {
+                outCardId = static_cast<int>(cardId);
+                return true;
+            }
+        }
+        return !state.isReserveEmpty();
+    }
+    
+    /**
+     * @brief 在GameState和GameModel上同步走一局（最多kVerifyMoveCount步），逐步比较局面哈希
+     */
+    bool verifyState(const GameState& initialState, const GameModel& initialModel)
+    {
+        GameState state = initialState;
+        GameModel gameModel = initialModel;
+        GameModel restored;
+        int cardId = -1;
+        for (int move = 0; move < kVerifyMoveCount && pickMove(state, cardId); move++)
+        {
+            if (cardId >= 0)
+            {
+                GameRules::applyPlayfieldToStack(state, cardId, state);
+                GameRules::applyPlayfieldToStack(gameModel, nullptr, cardId);
+            }
+            else
+            {
+                GameRules::applyReserveToStack(state, state);
+                GameRules::applyReserveToStack(gameModel, nullptr);
+            }
+            GameSnapshotService::restoreState(state, restored);
+            if (restored.computeStateHash() != gameModel.computeStateHash() ||
+                GameRules::hasPlayfieldMove(state) != GameRules::hasPlayfieldMove(gameModel))
+            {
+                return false;
+            }
+        }
+        return GameRules::isDeadEnd(state) == GameRules::isDeadEnd(gameModel);
+    }
+    
+    /**
+     * @brief 对比GameModel复制与GameState快照，输出一行结果
+     */
+    bool benchPersistentState(const std::string& name, const GameModel& gameModel)
+    {
+        GameState initialState;
+        double captureNs = measureNs([&]() { GameSnapshotService::captureState(gameModel, initialState); });
+        if (!initialState.isValid() || !verifyState(initialState, gameModel))
+        {
+            std::fprintf(stderr, "bench_snapshot: GameState diverged from GameModel for %s\n", name.c_str());
+            return false;
+        }
+        
+        GameModel modelCopy;
+        double modelCopyNs = measureNs([&]() { modelCopy = gameModel; });
+        GameState stateCopy;
+        double stateCopyNs = measureNs([&]() { stateCopy = initialState; });
+        
+        // 走一步：首张可出的牌或翻牌，无路可走时从初始局面重来
+        GameState state = initialState;
+        int cardId = -1;
+        auto step = [&]() {
+            if (!pickMove(state, cardId))
+            {
+                state = initialState;
+                pickMove(state, cardId);
+            }
+            if (cardId >= 0)
+            {
+                GameRules::applyPlayfieldToStack(state, cardId, state);
+            }
+            else
+            {
+                GameRules::applyReserveToStack(state, state);
+            }
+        };
+        double stepNs = measureNs(step);
+        
+        // 持有一局中连续的大量版本（后台搜索、提示的典型用法）
+        std::vector<GameModel> models;
+        models.reserve(kVersionCount);
+        uint64_t bytesBefore = AllocationCounter::getAllocatedBytes();
+        for (int i = 0; i < kVersionCount; i++)
+        {
+            models.push_back(gameModel);
+        }
+        uint64_t modelBytes = AllocationCounter::getAllocatedBytes() - bytesBefore;
+        
+        std::vector<GameState> states;
+        states.reserve(kVersionCount);
+        state = initialState;
+        bytesBefore = AllocationCounter::getAllocatedBytes();
+        uint64_t countBefore = AllocationCounter::getAllocationCount();
+        for (int i = 0; i < kVersionCount; i++)
+        {
+            step();
+            states.push_back(state);
+        }
+        uint64_t stateBytes = AllocationCounter::getAllocatedBytes() - bytesBefore;
+        uint64_t stateAllocs = AllocationCounter::getAllocationCount() - countBefore;
+        
+        std::printf("%-8s %6zu | %10.0f %10.0f | %10.0f %10.1f %10.0f %10.2f | %12llu %12llu\n",
+                    name.c_str(), gameModel.getPlayfieldCardCount(),
+                    modelCopyNs, captureNs, stateCopyNs, stepNs, static_cast<double>(stateBytes) / kVersionCount,
+                    static_cast<double>(stateAllocs) / kVersionCount,
+                    static_cast<unsigned long long>(modelBytes), static_cast<unsigned long long>(stateBytes));
+        return true;
+    }
+    
+    /**
+     * @brief 主线程连续发布局面，另一线程同时读取并校验，输出一行结果
+     */
+    bool benchPublisher(const std::string& name, const GameModel& gameModel)
+    {
+        // 预先走出一局的各个版本，发布时按版本号取用，读者据此校验读到的局面
+        GameState state;
+        if (!GameSnapshotService::captureState(gameModel, state))
+        {
+            return false;
+        }
+        std::vector<GameState> versions;
+        int cardId = -1;
+        while (pickMove(state, cardId))
+        {
+            versions.push_back(state);
+            if (cardId >= 0)
+            {
+                GameRules::applyPlayfieldToStack(state, cardId, state);
+            }
+            else
+            {
+                GameRules::applyReserveToStack(state, state);
+            }
+        }
+        versions.push_back(state);
+        
+        GameStatePublisher publisher;
+        std::atomic<bool> isStopping(false);
+        std::atomic<uint64_t> readCount(0);
+        uint64_t errorCount = 0;
+        std::thread reader([&]() {
+            PublishedGameState published;
+            uint64_t lastEpoch = 0;
+            while (!isStopping.load())
+            {
+                if (!publisher.readLatest(published))
+                {
+                    continue;
+                }
+                const GameState& expected = versions[(published.epoch - 1) % versions.size()];
+                if (published.epoch < lastEpoch ||
+                    published.state.getPlayfield() != expected.getPlayfield() ||
+                    published.state.getReserveCardCount() != expected.getReserveCardCount() ||
+                    published.state.getStackTopCard().getCardId() != expected.getStackTopCard().getCardId())
+                {
+                    errorCount++;
+                }
+                lastEpoch = published.epoch;
+                readCount++;
+            }
+        });
+        
+        // 等读者开始读取后再计时，保证发布期间一直有并发读取
+        publisher.publish(versions[0], 0);
+        while (readCount.load() == 0)
+        {
+            std::this_thread::yield();
+        }
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 1; i <= kPublishCount; i++)
+        {
+            publisher.publish(versions[i % versions.size()], 0);
+        }
+        double publishNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count()
+            / kPublishCount;
+        isStopping.store(true);
+        reader.join();
+        
+        std::printf("%-8s %6zu | %10.1f %10llu %10llu\n",
+                    name.c_str(), gameModel.getPlayfieldCardCount(), publishNs,
+                    static_cast<unsigned long long>(readCount.load()), static_cast<unsigned long long>(errorCount));
+        return errorCount == 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string levelDir = argc > 1 ? argv[1] : "Resources/levels";
+    std::vector<GameModel> levelModels;
+    
+    std::printf("%-8s %6s | %10s %10s %8s | %10s %10s %8s | %7s\n",
+                "level", "cards",
+                "json_w_ns", "json_r_ns", "json_B",
+                "bin_w_ns", "bin_r_ns", "bin_B",
+                "speedup");
+    
+    for (int levelId = 1; ; levelId++)
+    {
+        std::string path = levelDir + "/level_" + std::to_string(levelId) + ".json";
+        std::string content;
+        if (!readFile(path, content))
+        {
+            if (levelId == 1)
+            {
+                std::fprintf(stderr, "bench_snapshot: no levels found in %s\n", levelDir.c_str());
+                return 1;
+            }
+            break;
+        }
+        
+        LevelConfig levelConfig;
+        GameModel gameModel;
+        if (!LevelConfigLoader::loadFromString(content, levelConfig) ||
+            !GameModelGenerator::generate(levelConfig, gameModel))
+        {
+            std::fprintf(stderr, "bench_snapshot: failed to load %s\n", path.c_str());
+            return 1;
+        }
+        
+        std::vector<UndoModel> undoRecords;
+        buildUndoRecords(gameModel, undoRecords);
+        UndoManager undoManager;
+        undoManager.init(&gameModel);
+        for (const auto& undoModel : undoRecords)
+        {
+            undoManager.recordAction(undoModel);
+        }
+        
+        // JSON路径
+        std::string json;
+        double jsonWriteNs = measureNs([&]() { json = writeJson(gameModel, undoRecords); });
+        GameModel jsonModel;
+        std::vector<UndoModel> jsonRecords;
+        double jsonReadNs = measureNs([&]() { readJson(json, jsonModel, jsonRecords); });
+        
+        // 二进制快照路径
+        std::vector<uint8_t> snapshot;
+        double binWriteNs = measureNs([&]() {
+            GameSnapshotService::writeSnapshot(gameModel, undoManager, SnapshotLevel(), snapshot);
+        });
+        GameModel binModel;
+        UndoManager binUndoManager;
+        binUndoManager.init(&binModel);
+        SnapshotLevel binLevel;
+        bool binOk = true;
+        double binReadNs = measureNs([&]() {
+            binOk = GameSnapshotService::readSnapshot(snapshot.data(), snapshot.size(),
+                                                      binModel, binUndoManager, binLevel) && binOk;
+        });
+        if (!binOk || binUndoManager.getUndoStackSize() != undoRecords.size() ||
+            binModel.getPlayfieldCardCount() != gameModel.getPlayfieldCardCount())
+        {
+            std::fprintf(stderr, "bench_snapshot: binary round trip failed for %s\n", path.c_str());
+            return 1;
+        }
+        
+        levelModels.push_back(gameModel);
+        size_t cardCount = gameModel.getPlayfieldCardCount() + gameModel.getReserveCardCount() + 1;
+        std::printf("%-8d %6zu | %10.0f %10.0f %8zu | %10.0f %10.0f %8zu | %6.1fx\n",
+                    levelId, cardCount,
+                    jsonWriteNs, jsonReadNs, json.size(),
+                    binWriteNs, binReadNs, snapshot.size(),
+                    (jsonWriteNs + jsonReadNs) / (binWriteNs + binReadNs));
+    }
+    
+    // 内存快照：GameModel复制与GameState（结构共享）对比，另加大牌面压力布局
+    std::printf("\n%-8s %6s | %10s %10s | %10s %10s %10s %10s | %12s %12s\n",
+                "level", "cards", "copy_ns", "capture_ns", "snap_ns", "move_ns", "move_B", "move_alloc",
+                "models_B", "states_B");
+    for (size_t i = 0; i < levelModels.size(); i++)
+    {
+        if (!benchPersistentState(std::to_string(i + 1), levelModels[i]))
+        {
+            return 1;
+        }
+    }
+    const int stressSizes[] = { 1000, 10000 };
+    for (int cardCount : stressSizes)
+    {
+        StressLayoutParams params;
+        params.playfieldCardCount = cardCount;
+        LevelConfig levelConfig;
+        GameModel gameModel;
+        if (!StressLayoutGenerator::generate(params, levelConfig) ||
+            !GameModelGenerator::generate(levelConfig, gameModel) ||
+            !benchPersistentState("stress", gameModel))
+        {
+            return 1;
+        }
+    }
+    std::printf("(models_B/states_B: bytes allocated to hold %d successive versions)\n", kVersionCount);
+    
+    // 局面发布：主线程发布的同时后台线程不断读取，读到的必须是完整发布过的版本
+    std::printf("\n%-8s %6s | %10s %10s %10s\n", "level", "cards", "publish_ns", "reads", "torn");
+    for (size_t i = 0; i < levelModels.size(); i++)
+    {
+        if (!benchPublisher(std::to_string(i + 1), levelModels[i]))
+        {
+            std::fprintf(stderr, "bench_snapshot: reader saw an inconsistent published state\n");
+            return 1;
+        }
+    }
+    
+    return 0;
+}
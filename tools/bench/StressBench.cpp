@@ -0,0 +1,328 @@
+/**
+ * @file StressBench.cpp
+ * @brief 大牌面规模基准测试（无界面驱动）
+ * 
+ * 用StressLayoutGenerator生成100到10000张牌、不同重叠密度的布局，逐项计时：
+ * 生成布局、构建模型（按位置检测遮挡/使用预编译数据）、编译、更新可点击状态、
+ * 走一步再回退，以及模拟逐张牌触摸监听的命中分发。
+ * 真实的视图构建、触摸分发和帧耗时见StressBenchScene（PLAYINGCARDS_STRESS_BENCH）。
+ * 用法：bench_stress [--sizes 100,1000,...] [--densities 0,2,8] [--seed n] [--min-time 秒] [--csv 输出文件]
+ */
+
+#include "services/GameModelGenerator.h"
+#include "services/GameRules.h"
+#include "services/LevelCompiler.h"
+#include "services/StressLayoutGenerator.h"
+#include "managers/UndoManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /// 防止被测代码被优化掉
+    volatile int s_sink = 0;
+    
+    /// 每组布局模拟的触摸次数
+    const int kTouchSampleCount = 256;
+    
+    /**
+     * @brief 单组布局的测量结果（耗时均为单次平均）
+     */
+    struct StressResult
+    {
+        int cardCount;
+        float density;
+        double measuredOverlaps;    ///< 实际每张牌平均重叠数
+        int clickableCount;         ///< 初始可点击牌数
+        double layoutMs;            ///< 生成布局
+        double buildMs;             ///< 构建模型（按位置检测遮挡）
+        double compileMs;           ///< 编译遮挡关系
+        double buildCompiledMs;     ///< 构建模型（预编译数据）
+        double clickableMs;         ///< 全量更新可点击状态
+        double moveUs;              ///< 走一步再回退（按位置检测遮挡）
+        double moveCompiledUs;      ///< 走一步再回退（预编译数据）
+        double touchUs;             ///< 一次触摸的命中分发（模拟）
+    };
+    
+    /**
+     * @brief 重复执行直到累计时长足够（至少一次），返回单次平均耗时（纳秒）
+     */
+    template <typename Func>
+    double measureNs(Func&& func, double minSeconds)
+    {
+        using Clock = std::chrono::steady_clock;
+        long iterations = 0;
+        auto begin = Clock::now();
+        double seconds = 0.0;
+        do
+        {
+            func();
+            iterations++;
+            seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+        } while (seconds < minSeconds);
+        return seconds * 1e9 / iterations;
+    }
+    
+    /**
+     * @brief 让一张可点击的牌总能与顶部牌匹配，返回它的ID（没有可点击的牌时返回-1）
+     */
+    int prepareMovableCard(GameModel& gameModel)
+    {
+        for (const auto& card : gameModel.getPlayfieldCards())
+        {
+            if (card.isClickable())
+            {
+                CardModel& topCard = gameModel.getStackTopCardMutable();
+                topCard.setFace(static_cast<CardFaceType>((static_cast<int>(card.getFace()) + 1) % 13));
+                return card.getCardId();
+            }
+        }
+        return -1;
+    }
+    
+    /**
+     * @brief 走一步再回退的单次耗时（微秒），没有可走的牌时为0
+     */
+    double measureMoveUs(const GameModel& initialModel, double minSeconds)
+    {
+        GameModel gameModel = initialModel;
+        UndoManager undoManager;
+        undoManager.init(&gameModel);
+        int cardId = prepareMovableCard(gameModel);
+        if (cardId < 0)
+        {
+            return 0.0;
+        }
+        return measureNs([&]() {
+            GameRules::applyPlayfieldToStack(gameModel, &undoManager, cardId);
+            GameRules::applyUndo(gameModel, undoManager);
+        }, minSeconds) / 1000.0;
+    }
+    
+    /**
+     * @brief 模拟每张牌一个触摸监听时的命中分发
+     * 
+     * 与EventDispatcher按场景图优先级分发相同：从最上层的牌开始逐个询问，
+     * 被遮挡的牌在onTouchBegan开头即返回，可点击的牌做一次矩形命中测试，直到有牌接受。
+     * 不含坐标变换，是真实分发耗时的下限。
+     */
+    double measureTouchUs(const GameModel& gameModel, const cocos2d::Rect& bounds, uint32_t seed, double minSeconds)
+    {
+        std::vector<CardModel> listeners(gameModel.getPlayfieldCards().begin(), gameModel.getPlayfieldCards().end());
+        std::stable_sort(listeners.begin(), listeners.end(), [&](const CardModel& a, const CardModel& b) {
+            return gameModel.getPlayfieldZOrder(a.getCardId()) > gameModel.getPlayfieldZOrder(b.getCardId());
+        });
+        
+        std::mt19937 rng(seed);
+        std::vector<cocos2d::Vec2> touches(kTouchSampleCount);
+        for (auto& touch : touches)
+        {
+            touch.x = bounds.getMinX() + rng() % std::max(1, static_cast<int>(bounds.size.width));
+            touch.y = bounds.getMinY() + rng() % std::max(1, static_cast<int>(bounds.size.height));
+        }
+        
+        const float halfWidth = GameConstants::kCardWidth / 2;
+        const float halfHeight = GameConstants::kCardHeight / 2;
+        size_t index = 0;
+        return measureNs([&]() {
+            const cocos2d::Vec2& touch = touches[index++ % touches.size()];
+            for (const CardModel& card : listeners)
+            {
+                if (!card.isClickable() || !card.isFaceUp())
+                {
+                    continue;
+                }
+                const cocos2d::Vec2& position = card.getPosition();
+                if (std::abs(touch.x - position.x) < halfWidth && std::abs(touch.y - position.y) < halfHeight)
+                {
+                    s_sink += card.getCardId();
+                    break;
+                }
+            }
+        }, minSeconds) / 1000.0;
+    }
+    
+    bool runStress(int cardCount, float density, uint32_t seed, double minSeconds, StressResult& outResult)
+    {
+        StressLayoutParams params;
+        params.seed = seed;
+        params.playfieldCardCount = cardCount;
+        params.overlapDensity = density;
+        
+        LevelConfig levelConfig;
+        if (!StressLayoutGenerator::generate(params, levelConfig))
+        {
+            return false;
+        }
+        
+        outResult = StressResult();
+        outResult.cardCount = cardCount;
+        outResult.density = density;
+        outResult.layoutMs = measureNs([&]() {
+            LevelConfig config;
+            s_sink += StressLayoutGenerator::generate(params, config) ? 1 : 0;
+        }, minSeconds) / 1e6;
+        
+        GameModel gameModel;
+        outResult.buildMs = measureNs([&]() {
+            s_sink += GameModelGenerator::generate(levelConfig, gameModel) ? 1 : 0;
+        }, minSeconds) / 1e6;
+        outResult.clickableMs = measureNs([&]() {
+            GameModelGenerator::updatePlayfieldClickable(gameModel);
+        }, minSeconds) / 1e6;
+        for (const auto& card : gameModel.getPlayfieldCards())
+        {
+            outResult.clickableCount += card.isClickable() ? 1 : 0;
+        }
+        outResult.moveUs = measureMoveUs(gameModel, minSeconds);
+        
+        LevelConfig compiledConfig = levelConfig;
+        outResult.compileMs = measureNs([&]() {
+            compiledConfig.setCompiledPlayfield(nullptr);
+            s_sink += LevelCompiler::compile(compiledConfig) ? 1 : 0;
+        }, minSeconds) / 1e6;
+        
+        size_t overlapSum = 0;
+        for (const auto& data : *compiledConfig.getCompiledPlayfield())
+        {
+            overlapSum += data.blockers.size() + data.covers.size();
+        }
+        outResult.measuredOverlaps = static_cast<double>(overlapSum) / cardCount;
+        
+        GameModel compiledModel;
+        outResult.buildCompiledMs = measureNs([&]() {
+            s_sink += GameModelGenerator::generate(compiledConfig, compiledModel) ? 1 : 0;
+        }, minSeconds) / 1e6;
+        outResult.moveCompiledUs = measureMoveUs(compiledModel, minSeconds);
+        
+        outResult.touchUs = measureTouchUs(compiledModel, StressLayoutGenerator::computeLayoutBounds(levelConfig),
+                                           seed, minSeconds);
+        return true;
+    }
+    
+    /**
+     * @brief 解析逗号分隔的数字列表
+     */
+    template <typename T>
+    bool parseList(const char* text, std::vector<T>& outValues)
+    {
+        outValues.clear();
+        std::stringstream stream(text);
+        std::string item;
+        while (std::getline(stream, item, ','))
+        {
+            if (item.empty())
+            {
+                return false;
+            }
+            outValues.push_back(static_cast<T>(std::atof(item.c_str())));
+        }
+        return !outValues.empty();
+    }
+    
+    void writeCsv(const std::string& path, const std::vector<StressResult>& results)
+    {
+        std::ofstream file(path);
+        file << "cards,density,measured_overlaps,clickable,layout_ms,build_ms,compile_ms,build_compiled_ms,"
+                "clickable_ms,move_us,move_compiled_us,touch_us\n";
+        for (const auto& r : results)
+        {
+            file << r.cardCount << ',' << r.density << ',' << r.measuredOverlaps << ',' << r.clickableCount << ','
+                 << r.layoutMs << ',' << r.buildMs << ',' << r.compileMs << ',' << r.buildCompiledMs << ','
+                 << r.clickableMs << ',' << r.moveUs << ',' << r.moveCompiledUs << ',' << r.touchUs << '\n';
+        }
+    }
+    
+    int usage()
+    {
+        std::fprintf(stderr,
+                     "usage: bench_stress [--sizes 100,1000,...] [--densities 0,2,8] [--seed n]"
+                     " [--min-time seconds] [--csv out.csv]\n");
+        return 2;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<int> sizes = { 100, 300, 1000, 3000, 10000 };
+    std::vector<float> densities = { 0.0f, 2.0f, 8.0f };
+    uint32_t seed = 1;
+    double minSeconds = 0.1;
+    std::string csvPath;
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--sizes") == 0 && hasValue)
+        {
+            if (!parseList(argv[++i], sizes))
+            {
+                return usage();
+            }
+        }
+        else if (std::strcmp(argv[i], "--densities") == 0 && hasValue)
+        {
+            if (!parseList(argv[++i], densities))
+            {
+                return usage();
+            }
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasValue)
+        {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--min-time") == 0 && hasValue)
+        {
+            minSeconds = std::max(0.0, std::atof(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--csv") == 0 && hasValue)
+        {
+            csvPath = argv[++i];
+        }
+        else
+        {
+            return usage();
+        }
+    }
+    
+    std::printf("%6s %7s %8s %9s %9s %9s %9s %9s %9s %10s %10s %9s\n",
+                "cards", "density", "overlaps", "clickable", "layout", "build", "compile", "build_c",
+                "clickupd", "move", "move_c", "touch");
+    std::printf("%6s %7s %8s %9s %9s %9s %9s %9s %9s %10s %10s %9s\n",
+                "", "", "", "", "ms", "ms", "ms", "ms", "ms", "us", "us", "us");
+    
+    std::vector<StressResult> results;
+    for (int cardCount : sizes)
+    {
+        for (float density : densities)
+        {
+            StressResult result;
+            if (!runStress(cardCount, density, seed, minSeconds, result))
+            {
+                std::fprintf(stderr, "bench_stress: invalid layout params (cards %d, density %.2f)\n",
+                             cardCount, density);
+                return 1;
+            }
+            std::printf("%6d %7.1f %8.2f %9d %9.3f %9.3f %9.3f %9.3f %9.3f %10.2f %10.2f %9.2f\n",
+                        result.cardCount, result.density, result.measuredOverlaps, result.clickableCount,
+                        result.layoutMs, result.buildMs, result.compileMs, result.buildCompiledMs,
+                        result.clickableMs, result.moveUs, result.moveCompiledUs, result.touchUs);
+            std::fflush(stdout);
+            results.push_back(result);
+        }
+    }
+    
+    if (!csvPath.empty())
+    {
+        writeCsv(csvPath, results);
+    }
+    return 0;
+}
@@ -0,0 +1,230 @@
+/**
+ * @file DifficultyEstimate.cpp
+ * @brief 关卡难度批量评估工具
+ * 
+ * 对每个关卡做大量模拟对局，输出胜率（含95%置信区间）和平均步数，
+ * 按胜率从高到低排序，便于整理关卡顺序。
+ * 用法：level_difficulty <关卡文件或目录>... [--samples N] [--policy random|greedy|uncover]
+ *                        [--rule adjacent|nowrap|suited|within2] [--seed S] [--threads N] [--csv]
+ * 目录参数会展开为其中的level_*.json。
+ */
+
+#include "configs/LevelConfigLoader.h"
+#include "services/DifficultyEstimator.h"
+#include "cocos2d.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+USING_NS_CC;
+
+namespace
+{
+    bool readFile(const std::string& path, std::string& outContent)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+        std::stringstream stream;
+        stream << file.rdbuf();
+        outContent = stream.str();
+        return true;
+    }
+    
+    std::string getFileName(const std::string& path)
+    {
+        size_t pos = path.find_last_of("/\\");
+        return pos == std::string::npos ? path : path.substr(pos + 1);
+    }
+    
+    /**
+     * @brief 从level_N.json文件名解析关卡ID，解析失败返回0
+     */
+    int parseLevelId(const std::string& path)
+    {
+        std::string name = getFileName(path);
+        return name.compare(0, 6, "level_") == 0 ? std::atoi(name.c_str() + 6) : 0;
+    }
+    
+    /**
+     * @brief 把参数展开为关卡文件列表（目录取其中的level_*.json）
+     */
+    void collectLevels(const std::string& path, std::vector<std::string>& outPaths)
+    {
+        auto fileUtils = FileUtils::getInstance();
+        if (!fileUtils->isDirectoryExist(path))
+        {
+            outPaths.push_back(path);
+            return;
+        }
+        
+        std::vector<std::string> found;
+        for (const auto& entry : fileUtils->listFiles(path))
+        {
+            std::string name = getFileName(entry);
+            if (name.compare(0, 6, "level_") == 0 && name.size() > 5 &&
+                name.compare(name.size() - 5, 5, ".json") == 0)
+            {
+                found.push_back(entry);
+            }
+        }
+        std::sort(found.begin(), found.end(), [](const std::string& a, const std::string& b) {
+            return parseLevelId(a) < parseLevelId(b);
+        });
+        outPaths.insert(outPaths.end(), found.begin(), found.end());
+    }
+    
+    bool parsePolicy(const char* name, PlayoutPolicy& outPolicy)
+    {
+        const PlayoutPolicy policies[] = { PlayoutPolicy::RANDOM, PlayoutPolicy::GREEDY, PlayoutPolicy::UNCOVER };
+        for (PlayoutPolicy policy : policies)
+        {
+            if (std::strcmp(name, DifficultyEstimator::getPolicyName(policy)) == 0)
+            {
+                outPolicy = policy;
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    /**
+     * @brief 单个关卡的评估记录
+     */
+    struct LevelEntry
+    {
+        std::string path;               ///< 关卡文件路径
+        DifficultyEstimate estimate;    ///< 评估结果
+    };
+    
+    int usage()
+    {
+        std::fprintf(stderr,
+                     "usage: level_difficulty <level.json|dir>... [--samples N] [--policy random|greedy|uncover]\n"
+                     "                        [--rule adjacent|nowrap|suited|within2] [--seed S] [--threads N] [--csv]\n");
+        return 2;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    DifficultyParams params;
+    bool csv = false;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--samples") == 0 && hasValue)
+        {
+            params.sampleCount = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--policy") == 0 && hasValue)
+        {
+            if (!parsePolicy(argv[++i], params.policy))
+            {
+                return usage();
+            }
+        }
+        else if (std::strcmp(argv[i], "--rule") == 0 && hasValue)
+        {
+            if (!MatchRules::parseRuleType(argv[++i], params.rule))
+            {
+                return usage();
+            }
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasValue)
+        {
+            params.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && hasValue)
+        {
+            params.threadCount = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--csv") == 0)
+        {
+            csv = true;
+        }
+        else if (argv[i][0] == '-')
+        {
+            return usage();
+        }
+        else
+        {
+            collectLevels(argv[i], paths);
+        }
+    }
+    if (paths.empty() || params.sampleCount <= 0)
+    {
+        return usage();
+    }
+    
+    std::vector<LevelEntry> entries;
+    int failed = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (const auto& path : paths)
+    {
+        std::string content;
+        LevelConfig levelConfig;
+        LevelEntry entry;
+        entry.path = path;
+        if (!readFile(path, content) || !LevelConfigLoader::loadFromString(content, levelConfig) ||
+            !DifficultyEstimator::estimate(levelConfig, params, entry.estimate))
+        {
+            std::fprintf(stderr, "level_difficulty: failed to evaluate %s\n", path.c_str());
+            failed++;
+            continue;
+        }
+        entries.push_back(entry);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    
+    // 胜率高（简单）的排在前面，相同时步数少的在前
+    std::stable_sort(entries.begin(), entries.end(), [](const LevelEntry& a, const LevelEntry& b) {
+        if (a.estimate.winRate != b.estimate.winRate)
+        {
+            return a.estimate.winRate > b.estimate.winRate;
+        }
+        return a.estimate.averageMoves < b.estimate.averageMoves;
+    });
+    
+    if (csv)
+    {
+        std::printf("level,samples,win_rate,win_rate_low,win_rate_high,avg_moves,avg_moves_margin,avg_cleared\n");
+    }
+    else
+    {
+        std::printf("%-28s %8s %8s %17s %16s %8s\n", "level", "samples", "win", "95% CI", "moves", "cleared");
+    }
+    for (const auto& entry : entries)
+    {
+        const DifficultyEstimate& e = entry.estimate;
+        if (csv)
+        {
+            std::printf("%s,%d,%.4f,%.4f,%.4f,%.2f,%.2f,%.4f\n", entry.path.c_str(), e.sampleCount,
+                        e.winRate, e.winRateLow, e.winRateHigh, e.averageMoves, e.averageMovesMargin,
+                        e.averageClearedRatio);
+        }
+        else
+        {
+            std::printf("%-28s %8d %7.1f%% [%5.1f%%, %5.1f%%] %8.1f +- %5.2f %7.1f%%\n", entry.path.c_str(),
+                        e.sampleCount, e.winRate * 100.0, e.winRateLow * 100.0, e.winRateHigh * 100.0,
+                        e.averageMoves, e.averageMovesMargin, e.averageClearedRatio * 100.0);
+        }
+    }
+    
+    long long playouts = static_cast<long long>(entries.size()) * params.sampleCount;
+    const char* ruleName = MatchRules::dispatch(params.rule, [](auto rule) { return decltype(rule)::name(); });
+    std::fprintf(stderr, "level_difficulty: %zu levels, %lld playouts (%s, %s) in %.3f s, %.0f playouts/s\n",
+                 entries.size(), playouts, DifficultyEstimator::getPolicyName(params.policy), ruleName, seconds,
+                 seconds > 0.0 ? playouts / seconds : 0.0);
+    return failed == 0 ? 0 : 1;
+}
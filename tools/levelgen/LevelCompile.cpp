@@ -0,0 +1,139 @@
+/**
+ * @file LevelCompile.cpp
+ * @brief 关卡编译工具
+ * 
+ * 读取手工编辑的关卡JSON，附加预编译的遮挡关系、绘制顺序和初始可点击状态后写出，
+ * 运行时加载编译后的关卡不再做几何计算。
+ * 用法：level_compile <输出目录> <关卡文件或目录>...
+ *       level_compile --check <关卡文件或目录>...
+ * --check 只检查预编译数据是否存在且与当前布局一致，不一致时返回非零（用于发布前检查）。
+ * 目录参数会展开为其中的level_*.json。
+ */
+
+#include "configs/LevelConfigLoader.h"
+#include "services/LevelCompiler.h"
+#include "cocos2d.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+USING_NS_CC;
+
+namespace
+{
+    bool readFile(const std::string& path, std::string& outContent)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+        std::stringstream stream;
+        stream << file.rdbuf();
+        outContent = stream.str();
+        return true;
+    }
+    
+    std::string getFileName(const std::string& path)
+    {
+        size_t pos = path.find_last_of("/\\");
+        return pos == std::string::npos ? path : path.substr(pos + 1);
+    }
+    
+    /**
+     * @brief 把参数展开为关卡文件列表（目录取其中的level_*.json）
+     */
+    void collectLevels(const std::string& path, std::vector<std::string>& outPaths)
+    {
+        auto fileUtils = FileUtils::getInstance();
+        if (!fileUtils->isDirectoryExist(path))
+        {
+            outPaths.push_back(path);
+            return;
+        }
+        
+        std::vector<std::string> found;
+        for (const auto& entry : fileUtils->listFiles(path))
+        {
+            std::string name = getFileName(entry);
+            if (name.compare(0, 6, "level_") == 0 && name.size() > 5 &&
+                name.compare(name.size() - 5, 5, ".json") == 0)
+            {
+                found.push_back(entry);
+            }
+        }
+        std::sort(found.begin(), found.end());
+        outPaths.insert(outPaths.end(), found.begin(), found.end());
+    }
+    
+    int usage()
+    {
+        std::fprintf(stderr,
+                     "usage: level_compile <out_dir> <level.json|dir>...\n"
+                     "       level_compile --check <level.json|dir>...\n");
+        return 2;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        return usage();
+    }
+    
+    bool check = std::strcmp(argv[1], "--check") == 0;
+    std::string outDir = argv[1];
+    std::vector<std::string> paths;
+    for (int i = 2; i < argc; i++)
+    {
+        collectLevels(argv[i], paths);
+    }
+    
+    int failed = 0;
+    size_t blockerLinks = 0;
+    for (const auto& path : paths)
+    {
+        std::string content;
+        LevelConfig levelConfig;
+        if (!readFile(path, content) || !LevelConfigLoader::loadFromString(content, levelConfig))
+        {
+            std::fprintf(stderr, "level_compile: cannot load %s\n", path.c_str());
+            failed++;
+            continue;
+        }
+        
+        if (check)
+        {
+            bool upToDate = LevelCompiler::isUpToDate(levelConfig);
+            std::printf("%s %s\n", upToDate ? "OK   " : "STALE", path.c_str());
+            failed += upToDate ? 0 : 1;
+            continue;
+        }
+        
+        std::string outPath = outDir + "/" + getFileName(path);
+        if (!LevelCompiler::compile(levelConfig) || !LevelConfigLoader::saveToFile(outPath, levelConfig))
+        {
+            std::fprintf(stderr, "level_compile: failed to write %s\n", outPath.c_str());
+            failed++;
+            continue;
+        }
+        
+        for (const auto& card : *levelConfig.getCompiledPlayfield())
+        {
+            blockerLinks += card.blockers.size();
+        }
+    }
+    
+    if (!check)
+    {
+        std::printf("%zu levels compiled (%zu blocker links), %d failed\n",
+                    paths.size() - failed, blockerLinks, failed);
+    }
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,264 @@
+/**
+ * @file ReplayPlay.cpp
+ * @brief 无界面录像回放工具
+ * 
+ * 按游戏规则快速重放录像并输出终局结果，用于排查玩家反馈和校验成绩。
+ * 用法：
+ *   replay_play <关卡json> <录像文件> [--trace] [--repeat N]
+ *   replay_play <关卡json> --random <输出录像文件> [种子] [操作数]
+ * --trace 逐步打印每个操作；--repeat 重复回放N次并统计每秒操作数；
+ * --random 按规则随机生成一份合法录像，用于复现和压测。
+ */
+
+#include "configs/LevelConfigLoader.h"
+#include "managers/ReplayRecorder.h"
+#include "managers/UndoManager.h"
+#include "services/GameModelGenerator.h"
+#include "services/GameRules.h"
+#include "services/LevelCompiler.h"
+#include "services/ReplayService.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    bool readFile(const std::string& path, std::string& outContent)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+        std::stringstream stream;
+        stream << file.rdbuf();
+        outContent = stream.str();
+        return true;
+    }
+    
+    const char* getActionName(GameActionType type)
+    {
+        switch (type)
+        {
+            case GameActionType::PLAYFIELD_TO_STACK: return "playfield";
+            case GameActionType::RESERVE_TO_STACK:   return "reserve";
+            case GameActionType::UNDO:               return "undo";
+            default: return "none";
+        }
+    }
+    
+    /**
+     * @brief 逐步重放并打印每个操作后的局面
+     */
+    void printTrace(const LevelConfig& levelConfig, const ReplayModel& replay)
+    {
+        const auto& actions = replay.getActions();
+        ReplayModel prefix;
+        prefix.setLevel(replay.getLevelId(), replay.getLevelHash());
+        for (size_t i = 0; i < actions.size(); i++)
+        {
+            prefix.addAction(actions[i]);
+            ReplayResult result;
+            GameModel gameModel;
+            bool ok = ReplayService::play(levelConfig, prefix, result, &gameModel);
+            const CardModel& top = gameModel.getStackTopCard();
+            std::printf("#%-4zu %-9s %4d -> %s | top face=%d suit=%d | playfield=%zu reserve=%zu\n",
+                        i, getActionName(actions[i].type), actions[i].cardId,
+                        ok ? "ok" : GameRules::getResultDescription(result.failedReason),
+                        static_cast<int>(top.getFace()), static_cast<int>(top.getSuit()),
+                        result.remainingPlayfieldCards, result.remainingReserveCards);
+            if (!ok)
+            {
+                break;
+            }
+        }
+    }
+    
+    /**
+     * @brief 按规则随机选择合法操作，生成录像
+     */
+    bool generateRandomReplay(const LevelConfig& levelConfig, unsigned seed, int maxActions,
+                              ReplayModel& outReplay)
+    {
+        GameModel gameModel;
+        if (!GameModelGenerator::generate(levelConfig, gameModel))
+        {
+            return false;
+        }
+        UndoManager undoManager;
+        undoManager.init(&gameModel);
+        ReplayRecorder recorder;
+        recorder.begin(levelConfig);
+        
+        std::mt19937 rng(seed);
+        std::vector<int> candidates;
+        for (int i = 0; i < maxActions && !GameRules::isWin(gameModel); i++)
+        {
+            candidates.clear();
+            for (const auto& card : gameModel.getPlayfieldCards())
+            {
+                if (GameRules::checkPlayfieldToStack(gameModel, card.getCardId()) == GameRuleResult::OK)
+                {
+                    candidates.push_back(card.getCardId());
+                }
+            }
+            
+            // 偶尔回退，让录像覆盖撤销路径
+            if (undoManager.canUndo() && rng() % 8 == 0)
+            {
+                GameRules::applyUndo(gameModel, undoManager);
+                recorder.recordUndo();
+            }
+            else if (!candidates.empty())
+            {
+                int cardId = candidates[rng() % candidates.size()];
+                GameRules::applyPlayfieldToStack(gameModel, &undoManager, cardId);
+                recorder.recordPlayfieldToStack(cardId);
+            }
+            else if (GameRules::applyReserveToStack(gameModel, &undoManager) == GameRuleResult::OK)
+            {
+                recorder.recordReserveToStack();
+            }
+            else
+            {
+                break;
+            }
+        }
+        
+        recorder.updateResult(gameModel);
+        outReplay = recorder.getReplay();
+        return true;
+    }
+    
+    /**
+     * @brief 从level_N.json形式的文件名中解析关卡ID，失败返回0
+     */
+    int parseLevelId(const std::string& path)
+    {
+        size_t pos = path.rfind("level_");
+        return pos == std::string::npos ? 0 : std::atoi(path.c_str() + pos + 6);
+    }
+    
+    int usage()
+    {
+        std::fprintf(stderr,
+                     "usage: replay_play <level.json> <replay> [--trace] [--repeat N]\n"
+                     "       replay_play <level.json> --random <out.replay> [seed] [actions]\n");
+        return 2;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        return usage();
+    }
+    
+    std::string content;
+    LevelConfig levelConfig;
+    if (!readFile(argv[1], content) || !LevelConfigLoader::loadFromString(content, levelConfig))
+    {
+        std::fprintf(stderr, "replay_play: failed to load level %s\n", argv[1]);
+        return 1;
+    }
+    // 文件写有LevelId时以文件为准，否则按文件名补填（只影响录像中记录的关卡ID）
+    if (levelConfig.getLevelId() == 0)
+    {
+        levelConfig.setLevelId(parseLevelId(argv[1]));
+    }
+    
+    // 编译一次，之后的每次回放都增量更新可点击状态
+    if (!levelConfig.isCompiled() && !LevelCompiler::compile(levelConfig))
+    {
+        std::fprintf(stderr, "replay_play: invalid level %s\n", argv[1]);
+        return 1;
+    }
+    
+    if (std::strcmp(argv[2], "--random") == 0)
+    {
+        if (argc < 4)
+        {
+            return usage();
+        }
+        unsigned seed = argc > 4 ? static_cast<unsigned>(std::strtoul(argv[4], nullptr, 10)) : 1u;
+        int maxActions = argc > 5 ? std::atoi(argv[5]) : 200;
+        ReplayModel replay;
+        if (!generateRandomReplay(levelConfig, seed, maxActions, replay) ||
+            !ReplayService::saveToFile(argv[3], replay))
+        {
+            std::fprintf(stderr, "replay_play: failed to write %s\n", argv[3]);
+            return 1;
+        }
+        std::printf("wrote %zu actions to %s (win=%d)\n",
+                    replay.getActions().size(), argv[3], replay.isClaimedWin() ? 1 : 0);
+        return 0;
+    }
+    
+    ReplayModel replay;
+    if (!ReplayService::loadFromFile(argv[2], replay))
+    {
+        std::fprintf(stderr, "replay_play: failed to load replay %s\n", argv[2]);
+        return 1;
+    }
+    
+    bool trace = false;
+    long repeat = 1;
+    for (int i = 3; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--trace") == 0)
+        {
+            trace = true;
+        }
+        else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc)
+        {
+            repeat = std::max(1L, std::atol(argv[++i]));
+        }
+        else
+        {
+            return usage();
+        }
+    }
+    
+    if (trace)
+    {
+        printTrace(levelConfig, replay);
+    }
+    
+    ReplayResult result;
+    ReplayVerdict verdict = ReplayService::verify(levelConfig, replay, result);
+    
+    auto begin = std::chrono::steady_clock::now();
+    for (long i = 0; i < repeat; i++)
+    {
+        ReplayService::play(levelConfig, replay, result);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    
+    std::printf("level=%d actions=%zu applied=%zu legal=%d win=%d playfield=%zu reserve=%zu state=%08x\n",
+                replay.getLevelId(), replay.getActions().size(), result.appliedActionCount,
+                result.isLegal ? 1 : 0, result.isWin ? 1 : 0,
+                result.remainingPlayfieldCards, result.remainingReserveCards, result.finalStateHash);
+    if (!result.isLegal)
+    {
+        std::printf("first illegal action #%d: %s\n", result.failedActionIndex,
+                    GameRules::getResultDescription(result.failedReason));
+    }
+    std::printf("verdict: %s\n", ReplayService::getVerdictDescription(verdict));
+    
+    if (repeat > 1 && seconds > 0.0)
+    {
+        double moves = static_cast<double>(result.appliedActionCount) * repeat;
+        std::printf("%ld playbacks in %.3f s, %.0f moves/s\n", repeat, seconds, moves / seconds);
+    }
+    
+    return verdict == ReplayVerdict::ACCEPTED ? 0 : 1;
+}
@@ -0,0 +1,283 @@
+/**
+ * @file ReplayVerifier.cpp
+ * @brief 批量录像校验工具
+ * 
+ * 扫描投递目录中的录像文件，多线程并行重放校验操作合法性和声明的终局结果，
+ * 每个录像输出一行ACCEPT/REJECT及原因。
+ * 用法：replay_verifier <关卡目录> <投递目录> [--threads N] [--move] [--watch [毫秒]]
+ * --move  校验后把录像移动到投递目录下的accepted/或rejected/子目录
+ * --watch 持续轮询投递目录，处理新出现的录像（默认间隔1000毫秒）
+ * 
+ * 上传方应先写入临时文件再改名为*.replay，避免读到写了一半的文件。
+ */
+
+#include "configs/LevelConfigLoader.h"
+#include "managers/LevelConfigCache.h"
+#include "services/ReplayService.h"
+#include "cocos2d.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+USING_NS_CC;
+
+namespace
+{
+    const char* const kReplayExtension = ".replay";
+    
+    /// 缓存的关卡数（超出后淘汰最久未用的关卡）
+    const size_t kLevelCacheCapacity = 256;
+    
+    bool readFile(const std::string& path, std::string& outContent)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+        std::stringstream stream;
+        stream << file.rdbuf();
+        outContent = stream.str();
+        return true;
+    }
+    
+    bool hasSuffix(const std::string& text, const char* suffix)
+    {
+        size_t length = std::strlen(suffix);
+        return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+    }
+    
+    std::string getFileName(const std::string& path)
+    {
+        size_t pos = path.find_last_of("/\\");
+        return pos == std::string::npos ? path : path.substr(pos + 1);
+    }
+    
+    /**
+     * @brief 单个录像的校验结果
+     */
+    struct VerifyEntry
+    {
+        std::string path;       ///< 录像文件路径
+        bool accepted;          ///< 是否通过
+        std::string reason;     ///< 结论说明
+        
+        VerifyEntry()
+            : accepted(false)
+        {
+        }
+    };
+    
+    void verifyOne(LevelConfigCache& levelCache, VerifyEntry& entry)
+    {
+        std::string content;
+        ReplayModel replay;
+        if (!readFile(entry.path, content) ||
+            !replay.deserializeBinary(reinterpret_cast<const uint8_t*>(content.data()), content.size()))
+        {
+            entry.reason = "unreadable replay";
+            return;
+        }
+        
+        std::shared_ptr<const CachedLevel> level = levelCache.getLevel(replay.getLevelId());
+        if (!level)
+        {
+            entry.reason = "unknown level " + std::to_string(replay.getLevelId());
+            return;
+        }
+        
+        ReplayResult result;
+        ReplayVerdict verdict = ReplayService::verify(*level->config, replay, result);
+        entry.accepted = verdict == ReplayVerdict::ACCEPTED;
+        
+        char detail[160];
+        if (verdict == ReplayVerdict::ILLEGAL_ACTION)
+        {
+            snprintf(detail, sizeof(detail), "%s at action #%d: %s",
+                     ReplayService::getVerdictDescription(verdict), result.failedActionIndex,
+                     GameRules::getResultDescription(result.failedReason));
+        }
+        else
+        {
+            snprintf(detail, sizeof(detail), "%s level=%d actions=%zu win=%d",
+                     ReplayService::getVerdictDescription(verdict), replay.getLevelId(),
+                     replay.getActions().size(), result.isWin ? 1 : 0);
+        }
+        entry.reason = detail;
+    }
+    
+    /**
+     * @brief 多线程校验一批录像，结果按输入顺序写回
+     */
+    void verifyBatch(LevelConfigCache& levelCache, std::vector<VerifyEntry>& entries, unsigned threadCount)
+    {
+        std::atomic<size_t> nextIndex(0);
+        auto worker = [&levelCache, &entries, &nextIndex]() {
+            for (;;)
+            {
+                size_t index = nextIndex.fetch_add(1);
+                if (index >= entries.size())
+                {
+                    return;
+                }
+                verifyOne(levelCache, entries[index]);
+            }
+        };
+        
+        std::vector<std::thread> threads;
+        unsigned count = std::min<unsigned>(threadCount, static_cast<unsigned>(entries.size()));
+        for (unsigned i = 1; i < count; i++)
+        {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+    
+    /**
+     * @brief 列出投递目录中尚未处理的录像
+     */
+    std::vector<std::string> collectReplays(const std::string& dropDir, const std::set<std::string>& processed)
+    {
+        std::vector<std::string> paths;
+        for (const auto& path : FileUtils::getInstance()->listFiles(dropDir))
+        {
+            if (hasSuffix(path, kReplayExtension) && processed.find(path) == processed.end())
+            {
+                paths.push_back(path);
+            }
+        }
+        std::sort(paths.begin(), paths.end());
+        return paths;
+    }
+    
+    int usage()
+    {
+        std::fprintf(stderr,
+                     "usage: replay_verifier <levels_dir> <drop_dir> [--threads N] [--move] [--watch [ms]]\n");
+        return 2;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        return usage();
+    }
+    
+    std::string levelDir = argv[1];
+    std::string dropDir = argv[2];
+    unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+    bool moveProcessed = false;
+    bool watch = false;
+    int intervalMs = 1000;
+    for (int i = 3; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            threadCount = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        }
+        else if (std::strcmp(argv[i], "--move") == 0)
+        {
+            moveProcessed = true;
+        }
+        else if (std::strcmp(argv[i], "--watch") == 0)
+        {
+            watch = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+            {
+                intervalMs = std::max(10, std::atoi(argv[++i]));
+            }
+        }
+        else
+        {
+            return usage();
+        }
+    }
+    
+    auto fileUtils = FileUtils::getInstance();
+    std::string acceptedDir = dropDir + "/accepted/";
+    std::string rejectedDir = dropDir + "/rejected/";
+    if (moveProcessed && (!fileUtils->createDirectory(acceptedDir) || !fileUtils->createDirectory(rejectedDir)))
+    {
+        std::fprintf(stderr, "replay_verifier: cannot create output directories in %s\n", dropDir.c_str());
+        return 1;
+    }
+    
+    // 工作线程同时加载关卡，使用不经过FileUtils的线程安全加载函数
+    LevelConfigCache levelCache(kLevelCacheCapacity, [levelDir](int levelId, LevelConfig& outConfig) {
+        std::string content;
+        std::string path = levelDir + "/level_" + std::to_string(levelId) + ".json";
+        return readFile(path, content) && LevelConfigLoader::loadFromString(content, outConfig);
+    });
+    std::set<std::string> processed;
+    size_t totalAccepted = 0;
+    size_t totalRejected = 0;
+    
+    do
+    {
+        std::vector<std::string> paths = collectReplays(dropDir, processed);
+        if (paths.empty())
+        {
+            if (watch)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+            }
+            continue;
+        }
+        
+        std::vector<VerifyEntry> entries(paths.size());
+        for (size_t i = 0; i < paths.size(); i++)
+        {
+            entries[i].path = paths[i];
+        }
+        
+        auto begin = std::chrono::steady_clock::now();
+        verifyBatch(levelCache, entries, threadCount);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        
+        size_t accepted = 0;
+        for (const auto& entry : entries)
+        {
+            std::string name = getFileName(entry.path);
+            std::printf("%s %s %s\n", entry.accepted ? "ACCEPT" : "REJECT", name.c_str(), entry.reason.c_str());
+            accepted += entry.accepted ? 1 : 0;
+            
+            if (moveProcessed)
+            {
+                std::string target = (entry.accepted ? acceptedDir : rejectedDir) + name;
+                if (fileUtils->renameFile(entry.path, target))
+                {
+                    continue;
+                }
+                std::fprintf(stderr, "replay_verifier: failed to move %s\n", entry.path.c_str());
+            }
+            processed.insert(entry.path);
+        }
+        
+        totalAccepted += accepted;
+        totalRejected += entries.size() - accepted;
+        std::fprintf(stderr, "replay_verifier: %zu replays (%zu accepted) in %.3f s on %u threads, %.0f replays/s\n",
+                     entries.size(), accepted, seconds, threadCount,
+                     seconds > 0.0 ? entries.size() / seconds : 0.0);
+        std::fflush(stdout);
+    } while (watch);
+    
+    std::fprintf(stderr, "replay_verifier: total %zu accepted, %zu rejected\n", totalAccepted, totalRejected);
+    return totalRejected == 0 ? 0 : 1;
+}